@@ -1,67 +1,133 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <vector>
 
 #include "bios.h"
 #include "Cga.h"
 #include "Dmac.h"
+#include "EventLog.h"
 #include "Pic.h"
 #include "Pit.h"
 #include "Ppi.h"
 #include "Fdc.h"
+#include "IoMap.h"
 #include "Keyboard.h"
+#include "MachineConfig.h"
+#include "MemoryMap.h"
+#include "Scheduler.h"
+#include "StateBuffer.h"
 
-#define ROM_BASE_ADDRESS 0xFE000
-#define CONVENTIONAL_RAM_SIZE 0xB8000
-#define CGA_ADDRESS 0xB8000
-
-class Bus
+// The system bus and the motherboard devices on it, for the machine described by Config (see MachineConfig.h).
+template <typename Config>
+class BasicBus
 {
 public:
-    Bus() :
-        ram_(CONVENTIONAL_RAM_SIZE), rom_(0x2000) {
-        rom_.assign(U18, U18 + sizeof(U18));
+    static constexpr uint32_t kCgaAddress = 0xB8000;
+
+    BasicBus() :
+        ram_(Config::kRamSize), rom_(U18, U18 + sizeof(U18)) {
+        remapMemory();
+        mapIoPorts();
         pit_.setGate(0, true);
         pit_.setGate(1, true);
         pit_.setGate(2, true);
         // Wire DMAC & PIC to the FDC so it can perform DMA and execute interrupts.
         fdc_.attachDMAC(&dmac_);
         fdc_.attachPIC(&pic_);
+        // Device messages go to the event log, stamped with the bus tick.
+        log_.setClock(&_ticks);
+        fdc_.attachLog(&log_);
+        kb_.attachLog(&log_);
+        cga_.attachLog(&log_);
+        resetSchedule();
     }
 
+    // The memory map holds pointers into the bus.
+    BasicBus(const BasicBus&) = delete;
+    BasicBus& operator=(const BasicBus&) = delete;
+
     uint8_t* ram() { return &ram_[0]; }
     [[nodiscard]] size_t ramSize() const { return ram_.size(); }
 
+    // Memory configuration. Ranges must be whole MemoryMap pages. RAM is mapped from address 0 and anything mapped
+    // with the calls below takes precedence over it, ROMs over devices. Each call returns false and leaves the map
+    // unchanged if the range is invalid.
+
+    // Resize conventional RAM, clearing it. 640 KiB is 0xA0000.
+    bool setRamSize(const uint32_t size) {
+        if (!MemoryMap::isValidRange(0, size)) {
+            return false;
+        }
+        ram_.assign(size, 0);
+        remapMemory();
+        return true;
+    }
+
+    // Replace the system BIOS. It is mapped so that it ends at the top of the address space, so a 32 KiB 5160
+    // BIOS starts at 0xF8000.
+    bool loadBios(const std::vector<uint8_t>& image) {
+        if (image.size() > MemoryMap::kAddressMask || !MemoryMap::isValidRange(biosAddress(image.size()),
+            static_cast<uint32_t>(image.size()))) {
+            return false;
+        }
+        rom_ = image;
+        remapMemory();
+        return true;
+    }
+
+    // Map an option ROM. The image is padded with open bus to a whole number of pages.
+    bool mapRom(const uint32_t address, const std::vector<uint8_t>& image) {
+        const uint32_t size = (static_cast<uint32_t>(image.size()) + MemoryMap::kPageMask) & ~MemoryMap::kPageMask;
+        if (image.size() > MemoryMap::kAddressMask || !MemoryMap::isValidRange(address, size)) {
+            return false;
+        }
+        std::vector<uint8_t> data(size, 0xFF);
+        std::ranges::copy(image, data.begin());
+        option_roms_.push_back({address, std::move(data)});
+        remapMemory();
+        return true;
+    }
+
+    // Map a memory-mapped device. The handler's context must outlive the bus.
+    bool mapDevice(const uint32_t address, const uint32_t size, const MemoryHandler& handler) {
+        if (!MemoryMap::isValidRange(address, size)) {
+            return false;
+        }
+        devices_.push_back({address, size, handler});
+        remapMemory();
+        return true;
+    }
+
     // Device accessors
-    CGA* cga() { return &cga_; }
+    CGA* cga() {
+        syncCga();
+        return &cga_;
+    }
     PIC* pic() { return &pic_; }
-    PIT* pit() { return &pit_; }
+    PIT* pit() {
+        syncPit();
+        return &pit_;
+    }
     PPI* ppi() { return &ppi_; }
     FDC* fdc() { return &fdc_; }
     DMAC* dmac() { return &dmac_; }
+    EventLog* eventLog() { return &log_; }
+    // Port dispatch, for adding devices and for the per-port access counts.
+    IoMap* io() { return &io_; }
 
     // Read a byte from a physical address without changing bus state.
     // This allows tools (disassembler/UI) to inspect memory (RAM or ROM) directly.
     [[nodiscard]] uint8_t peek(const uint32_t address) const {
-        // Real-mode uses 20-bit physical addressing; mask to 20 bits in callers if needed.
-        if (address >= ROM_BASE_ADDRESS) {
-            uint32_t rom_index = address - ROM_BASE_ADDRESS;
-            if (rom_index < rom_.size()) {
-                return rom_[rom_index];
-            }
-            return 0xff;
-        }
-        if (address >= CGA_ADDRESS && address < CGA_ADDRESS + 0x4000) {
-            return cga_.readMem(address - CGA_ADDRESS);
-        }
-        if (address >= CONVENTIONAL_RAM_SIZE) {
-            return 0xff; // open bus / video area not resident here
-        }
-        if (address < ram_.size()) {
-            return ram_[address];
-        }
-        return 0xff;
+        // Real-mode uses 20-bit physical addressing; the memory map wraps anything above it.
+        return memory_.read(address);
+    }
+
+    // True if the address is plain RAM or ROM rather than device memory such as CGA VRAM.
+    [[nodiscard]] bool isHostMemory(const uint32_t address) const {
+        return memory_.isHostMemory(address);
     }
 
     [[nodiscard]] size_t romSize() const { return rom_.size(); }
@@ -75,7 +141,6 @@ public:
         fdc_.reset();
         kb_.reset();
         cga_.reset();
-        pit_phase_ = 2;
         last_counter0_output_ = false;
         last_counter1_output_ = true;
         counter2_output_ = false;
@@ -87,17 +152,75 @@ public:
         lock_ = false;
         previous_passive_or_halt_ = true;
         last_non_dma_ready_ = true;
-        cga_phase_ = 0;
         last_kb_disabled_ = false;
         last_kb_cleared_ = false;
         last_irq6_ = false;
+        resetSchedule();
+    }
+
+    // Save or load the bus and every device on it, one section each (see SaveState.h). The memory and port maps,
+    // the ROMs and the event log are configuration rather than state and are left alone.
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        if constexpr (!Archive::kLoading) {
+            // Bring the lazily updated devices up to date so that equal machine states save identically.
+            syncPit();
+            syncCga();
+        }
+        ar.section("BUS ", [&] {
+            ar(_ticks);
+            scheduler_.serialize(ar);
+            ar(cga_ticks_);
+            ar(cga_phase_start_);
+            ar(pit_last_tick_);
+            ar(in_events_);
+            ar(speaker_done_);
+            ar(address_);
+            ar(type_);
+            ar(cycle_);
+            ar(dma_cycles_);
+            ar(dma_type_);
+            ar(dma_state_);
+            ar(dma_address_);
+            ar(dma_pages_);
+            ar(last_counter0_output_);
+            ar(last_irq6_);
+            ar(last_counter1_output_);
+            ar(counter2_output_);
+            ar(counter2_gate_);
+            ar(speaker_mask_);
+            ar(speaker_output_);
+            ar(next_speaker_output_);
+            ar(nmi_enabled_);
+            ar(passive_or_halt_);
+            ar(lock_);
+            ar(previous_passive_or_halt_);
+            ar(last_non_dma_ready_);
+            ar(last_kb_disabled_);
+            ar(last_kb_cleared_);
+        });
+        ar.section("RAM ", [&] { ar.bytes(ram_.data(), ram_.size()); });
+        ar.section("DMAC", [&] { dmac_.serialize(ar); });
+        ar.section("PIC ", [&] { pic_.serialize(ar); });
+        ar.section("PIT ", [&] { pit_.serialize(ar); });
+        ar.section("PPI ", [&] { ppi_.serialize(ar); });
+        if constexpr (Config::kHasFdc) {
+            ar.section("FDC ", [&] { fdc_.serialize(ar); });
+        }
+        if constexpr (Config::kHasKeyboard) {
+            ar.section("KBD ", [&] { kb_.serialize(ar); });
+        }
+        if constexpr (Config::kHasCga) {
+            ar.section("CGA ", [&] { cga_.serialize(ar); });
+        }
     }
 
     void stubInit() {
         pic_.stubInit();
         pit_.stubInit();
-        pit_phase_ = 2;
         last_counter0_output_ = true;
+        pit_last_tick_ = _ticks - 2;
+        schedulePit();
     }
 
     void setSpeakerCallback(PcSpeakerCallback callback) {
@@ -112,95 +235,8 @@ public:
 
     void tick() {
         _ticks++;
-        cga_.tick();
-        cga_phase_ = (cga_phase_ + 3) & 0x0f;
-        pit_phase_++;
-
-        // Handle PIT updates every 4 ticks
-        if (pit_phase_ == 4) {
-            pit_phase_ = 0;
-            pit_.tick();
-            bool counter0Output = pit_.getOutput(0);
-            if (last_counter0_output_ != counter0Output) {
-                pic_.setIRQLine(0, counter0Output);
-            }
-            last_counter0_output_ = counter0Output;
-
-            bool counter1Output = pit_.getOutput(1);
-            if (counter1Output && !last_counter1_output_ && !dack0()) {
-                dmac_.setDMARequestLine(0, true);
-            }
-            last_counter1_output_ = counter1Output;
-
-            bool counter2Output = pit_.getOutput(2);
-            if (counter2_output_ != counter2Output) {
-                counter2_output_ = counter2Output;
-                setSpeakerOutput();
-                ppi_.setC(5, counter2Output);
-                updatePPI();
-            }
-        }
-
-        if (speaker_cycle_ != 0) {
-            --speaker_cycle_;
-            if (speaker_cycle_ == 0) {
-                speaker_output_ = next_speaker_output_;
-                ppi_.setC(4, speaker_output_);
-                updatePPI();
-            }
-        }
-
-        if ((_ticks & 0xF) == 0) {
-            // Check and clear the keyboard
-            const auto kb_cleared = ppi_.getB(7);
-            const auto kb_disabled = !ppi_.getB(6);
-            if (kb_disabled && !last_kb_disabled_) {
-                // Keyboard was just disabled.
-                std::cout << "Bus: Disabling keyboard" << std::endl;
-                kb_.setClockLineState(false);
-            }
-            else if (!kb_disabled && last_kb_disabled_) {
-                // Keyboard was just enabled.
-                std::cout << "Bus: Enabling keyboard" << std::endl;
-                kb_.setClockLineState(true);
-            }
-
-            if (kb_cleared && !last_kb_cleared_) {
-                // KSR was just cleared.
-                std::cout << "Bus: Clearing KSR & Interrupt" << std::endl;
-                // Clear any pending IRQ 1.
-                pic_.setIRQLine(1, false);
-                // Clear the KSR attached to PPI port A.
-                for (int i = 0; i < 8; ++i) {
-                    ppi_.setA(i, false);
-                }
-            }
-            else if (!kb_disabled && last_kb_disabled_) {
-                // Keyboard was just enabled.
-                std::cout << "Bus: Re-enabling keyboard" << std::endl;
-            }
-            last_kb_disabled_ = kb_disabled;
-            last_kb_cleared_ = kb_cleared;
-        }
-
-        if ((_ticks & 0x3FFF) == 0) {
-            // Slow tick = ~1.144ms. Good for ticking ms-scale delays.
-
-            // Tick the keyboard. The keyboard needs to be ticked to produce reset bytes after a delay when reset,
-            // and to produce type-matic repeat keys.
-            kb_.tick();
-            if (uint8_t b = 0; kb_.getScanCode(b)) {
-                // Keyboard-originated scancode (reset byte or type-matic key)
-                std::cout << std::format("Keyboard generated scancode: {:02X}", b) << std::endl;
-                for (int i = 0; i < 8; ++i) {
-                    const auto bit = (b >> i) & 1;
-                    ppi_.setA(i, bit != 0);
-                }
-                pic_.setIRQLine(1, true);
-            }
-
-            // Tick the FDC. The FDC needs to be ticked to simulate operational delays.
-            fdc_.tick();
+        if (_ticks >= scheduler_.next()) {
+            runEvents();
         }
 
         // // Handle FDC interrupts
@@ -218,83 +254,41 @@ public:
         // }
 
 
-        // Set to false to implement 5160s without the U90 fix and 5150s
-        // without the U101 fix as described in
+        // Config::kDmacFix is false for 5160s without the U90 fix and 5150s without the U101 fix as described in
         // http://www.vcfed.org/forum/showthread.php?29211-Purpose-of-U90-in-XT-second-revision-board
-        bool hasDMACFix = true;
-
-        if (type_ != 2 || (address_ & 0x3e0) != 0x000 || !hasDMACFix) {
+        if (type_ != 2 || (address_ & 0x3e0) != 0x000 || !Config::kDmacFix) {
             last_non_dma_ready_ = nonDMAReady();
         }
         //if (_previousLock && !_lock)
         //    _previousLock = false;
         //_previousLock = _lock;
+        // Only the states with a condition or a side effect need code; the rest step to their successor.
         switch (dma_state_) {
             case sIdle:
-                if (dmac_.getHoldRequestLine()) {
+                // getHoldRequestLine() can only raise hold with a request or a channel in service.
+                if ((dmac_.getRequestLines() != 0 || dmac_.getActiveChannel() != -1) && dmac_.getHoldRequestLine()) {
                     dma_state_ = sDREQ;
                 }
                 break;
-            case sDREQ:
-                dma_state_ = sHRQ; //(_passiveOrHalt && !_previousLock) ? sHRQ : sHoldWait;
-                break;
             case sHRQ:
-                //_dmaState = _lastNonDMAReady ? sAEN : sPreAEN;
                 if ((passive_or_halt_ || previous_passive_or_halt_) && !lock_ && last_non_dma_ready_) {
                     dma_state_ = sAEN;
                 }
                 break;
-            //case sHoldWait:
-            //    if (_passiveOrHalt && !_previousLock)
-            //        _dmaState = _lastNonDMAReady ? sAEN : sPreAEN;
-            //    break;
-            //case sPreAEN:
-            //    if (_lastNonDMAReady)
-            //        _dmaState = sAEN;
-            //    break;
-            case sAEN:
-                dma_state_ = s0;
-                break;
             case s0:
                 dmac_.setDMARequestLine(0, false);
                 dma_state_ = s1;
                 break;
-            case s1:
-                dma_state_ = s2;
-                break;
             case s2:
                 // Device read/write occurs on S2
-                if (dmac_.getActiveChannel() == 2) {
-                    // Servicing FDC
-                    auto addr = dmaAddressHigh(2) + static_cast<uint32_t>(dmac_.getAddress());
-
-                    if (dmac_.isReading()) {
-                        std::cout << std::format("DMAC Channel 2 READ from address {:05X}\n", addr);
-                    }
-                    else if (dmac_.isWriting()) {
-                        const auto b = fdc_.dmaDeviceRead();
-                        //std::cout << std::format("DMAC Channel 2 WRITE to address {:02X}->{:05X}\n", b, addr);
-                        ram_[addr & 0xFFFFF] = b;
-                    }
-                    dmac_.service();
-                    if (dmac_.isAtTerminalCount()) {
-                        // Notify FDC that DMA operation is complete
-                        std::cout << std::format(
-                            "DMAC Channel 2 terminal count reached at address [{:05X}], page [{:02X}], notifying FDC\n",
-                            addr, dma_pages_[2]);
-                        fdc_.dmaDeviceEOP();
-                    }
-
+                if (Config::kHasFdc && dmac_.getActiveChannel() == 2) {
+                    transferChannel2();
                 }
                 else {
                     dmac_.service();
                 }
-
                 dma_state_ = s3;
                 break;
-            case s3:
-                dma_state_ = s4;
-                break;
             case s4:
                 dma_state_ = sDelayedT1;
                 dmac_.dmaCompleted();
@@ -303,13 +297,8 @@ public:
                 dma_state_ = sDelayedT2;
                 cycle_ = 0;
                 break;
-            case sDelayedT2:
-                dma_state_ = sDelayedT3;
-                break;
-            case sDelayedT3:
-                dma_state_ = sIdle;
-                break;
             default:
+                dma_state_ = kDmaStates[dma_state_].next;
                 break;
         }
         previous_passive_or_halt_ = passive_or_halt_;
@@ -318,70 +307,151 @@ public:
         ++cycle_;
     }
 
+    // Advance the bus n ticks, as n calls to tick() would, for a CPU that is halted, only accesses memory or only reads
+    // (see Cpu::fastForwardHalt(), Cpu::repBatch() and Cpu::skipLoop()). Only the ticks that run device events are
+    // simulated one at a time. The stretches between them, with the DMA controller idle, are skipped in one step, and
+    // so is each refresh cycle: with the bus free its states follow each other without waiting, so only the DMAC's
+    // side effects need to run. The PIT catches up lazily on its next event, and the keyboard check is postponed past
+    // the window while port B is unchanged, since until then each check would find nothing to do.
+    void tickFor(uint32_t n) {
+        while (n > 0) {
+            if (dma_state_ == sDREQ && dmac_.getActiveChannel() == 0 && n >= kRefreshTicks &&
+                scheduler_.next() > _ticks + kRefreshTicks && passive_or_halt_ && !lock_ &&
+                ((type_ != 1 && type_ != 2) || cycle_ > 2)) {
+                _ticks += kRefreshTicks;
+                dmac_.setDMARequestLine(0, false); // S0
+                dmac_.service(); // S2
+                dmac_.dmaCompleted(); // S4
+                dma_state_ = sIdle;
+                previous_passive_or_halt_ = passive_or_halt_;
+                // cycle_ restarts on the first delayed cycle, three ticks before the end.
+                cycle_ = 2;
+                last_non_dma_ready_ = nonDMAReady();
+                ++cycle_;
+                n -= kRefreshTicks;
+                continue;
+            }
+            if (dma_state_ != sIdle || dmac_.getRequestLines() != 0 || dmac_.getActiveChannel() != -1) {
+                tick();
+                --n;
+                continue;
+            }
+            if (ppi_.getB(7) == last_kb_cleared_ && !ppi_.getB(6) == last_kb_disabled_) {
+                const uint64_t check = ((_ticks + n) | 0xF) + 1;
+                if (scheduler_.at(eventKeyboardCheck) < check) {
+                    scheduler_.schedule(eventKeyboardCheck, check);
+                }
+            }
+            // The ticks before the next event change nothing but the counts.
+            const uint64_t quiet = std::min<uint64_t>(n, scheduler_.next() - 1 - _ticks);
+            if (quiet == 0) {
+                tick();
+                --n;
+                continue;
+            }
+            _ticks += quiet;
+            cycle_ = static_cast<int>(cycle_ + quiet - 1);
+            previous_passive_or_halt_ = passive_or_halt_;
+            last_non_dma_ready_ = nonDMAReady();
+            ++cycle_;
+            n -= static_cast<uint32_t>(quiet);
+        }
+    }
+
+    // Return the number of ticks until the next tick that might change the interrupt state, so that the PIC's
+    // INTR output is certain to stay the same for the ticks before it. Interrupts can only be raised or cleared
+    // by a PIT counter 0 output edge, the periodic keyboard/FDC update, the keyboard-clear check, or a channel 2
+    // (floppy) DMA transfer. The result is conservative and never less than 1.
+    [[nodiscard]] uint32_t ticksUntilNextEvent() {
+        if ((dmac_.getRequestLines() & 0x04) != 0 || dmac_.getActiveChannel() == 2) {
+            return 1;
+        }
+
+        uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(UINT32_MAX, scheduler_.at(eventSlowTick) - _ticks));
+
+        // The keyboard-clear check only has an effect if PPI port B changed since it last ran.
+        if (ppi_.getB(7) != last_kb_cleared_ || !ppi_.getB(6) != last_kb_disabled_) {
+            n = std::min(n, 0x10 - static_cast<uint32_t>(_ticks & 0xF));
+        }
+
+        // Counter 0's output can first change on the PIT tick after its stable ticks have run.
+        syncPit();
+        const uint64_t pit_tick = 4 - pitPhase();
+        const uint32_t stable = pit_.getOutput(0) != last_counter0_output_ ? 0 : pit_.getStableTicks(0);
+        const uint64_t pit_event = pit_tick + 4ull * stable;
+        return static_cast<uint32_t>(std::min<uint64_t>(n, pit_event));
+    }
+
+    // Return the number of ticks until the first tick that might start a DMA transfer, counted like
+    // ticksUntilNextEvent(), or 0 if one is already requested or running. Until then only the CPU's own bus cycles
+    // decide ready(). Refresh on channel 0 is requested on a rising edge of PIT counter 1; a channel 2 request also ends
+    // ticksUntilNextEvent().
+    [[nodiscard]] uint32_t ticksUntilDMARequest() {
+        if (dma_state_ != sIdle || dmac_.getRequestLines() != 0 || dmac_.getActiveChannel() != -1) {
+            return 0;
+        }
+        syncPit();
+        const uint64_t pit_tick = 4 - pitPhase();
+        const uint32_t quiet = pit_.getOutput(1) != last_counter1_output_ ? 0 : pit_.getTicksWithoutRisingEdge(1);
+        return static_cast<uint32_t>(std::min<uint64_t>(UINT32_MAX, pit_tick + 4ull * quiet));
+    }
+
+    // Append the bus state that decides how the CPU's bus cycles go from here while INTR stays the same (see
+    // ticksUntilNextEvent()): the DMA state machine, the refresh requests that PIT counter 1 makes and where the PIT
+    // is in its 4-tick cycle. Counters 0 and 2 and the tick count are left out, so two states a whole number of
+    // refresh periods apart compare equal. The CPU's busy-wait loop detector uses this.
+    void appendTimingState(StateBuffer& out) {
+        syncPit();
+        out.put(pitPhase());
+        pit_.appendCounterState(1, out);
+        out.put(last_counter1_output_);
+        dmac_.appendTimingState(out);
+        out.put(dma_state_);
+        out.put(passive_or_halt_);
+        out.put(previous_passive_or_halt_);
+        out.put(lock_);
+        out.put(last_non_dma_ready_);
+        out.put(type_);
+        // The address only matters to tick() for a port write, and the age of an access only up to the wait state.
+        out.put(type_ == 2 ? address_ : 0);
+        out.put(std::min(cycle_, 3));
+        out.put(pic_.interruptPending());
+    }
+
+    // Say what a bus cycle of the given type (the CPU's IOType: 1 for a port read, 4 or 5 for a memory read) would read
+    // from the address now, if that is known without side effects. stableTicks is set to the number of ticks the
+    // value is certain to stay the same for, as long as nothing writes to the bus: forever for RAM and ROM, and until
+    // the next character clock that may move display enable or vertical retrace for the CGA status register. Returns
+    // false for anything else, and for every port while port accesses are being counted.
+    [[nodiscard]] bool stableRead(const uint32_t address, const int type, uint8_t& value, uint32_t& stableTicks) {
+        if (type == 1) {
+            const IoHandler* handler = io_.handler(address);
+            if (io_.isCounting() || handler == nullptr || handler->read != &readCgaPort || (address & 0x0F) != 0x0A) {
+                return false;
+            }
+            syncCga();
+            value = cga_.readStatusRegister();
+            stableTicks = cga_.ticksUntilStatusChange();
+            return true;
+        }
+        if ((type != 4 && type != 5) || !isHostMemory(address)) {
+            return false;
+        }
+        value = memory_.read(address);
+        stableTicks = UINT32_MAX;
+        return true;
+    }
+
     bool ready() {
         return dmaReady() && nonDMAReady();
     }
 
-    void write(uint8_t data) {
+    void write(const uint8_t data) {
         if (type_ == 2) {
-            // IO write
-            switch (address_ & 0x3e0) {
-                case 0x00:
-                    dmac_.write(address_ & 0x0f, data);
-                    break;
-                case 0x20:
-                    pic_.write(address_ & 1, data);
-                    break;
-                case 0x40:
-                    pit_.write(address_ & 3, data);
-                    break;
-                case 0x60:
-                    ppi_.write(address_ & 3, data);
-                    updatePPI();
-                    break;
-                case 0x80:
-                    // Don't ask me why the DMA page registers are ordered this way.
-                    switch (address_) {
-                        case 0x87:
-                            dma_pages_[0] = data;
-                            break;
-                        case 0x83:
-                            dma_pages_[1] = data;
-                            break;
-                        case 0x81:
-                            std::cout << std::format("Write to DMA page register 2: {:02X}\n", data);
-                            dma_pages_[2] = data;
-                            break;
-                        case 0x82:
-                            dma_pages_[3] = data;
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                case 0xa0:
-                    nmi_enabled_ = (data & 0x80) != 0;
-                    break;
-                case 0x3C0:
-                    cga_.writeIO(address_ & 0x0F, data);
-                    break;
-                case 0x3E0:
-                    fdc_.writeIO(address_ & 7, data);
-                    break;
-
-                default:
-                    break;
-            }
+            io_.write(address_, data);
         }
-
         else {
-            // Memory write
-            if (address_ < CONVENTIONAL_RAM_SIZE) {
-                ram_[address_] = data;
-            }
-            else if (address_ >= CGA_ADDRESS && address_ < CGA_ADDRESS + 0x4000) {
-                cga_.writeMem(address_ - CGA_ADDRESS, data);
-            }
+            memory_.write(address_, data);
         }
     }
 
@@ -390,88 +460,28 @@ public:
             // Interrupt acknowledge
             auto i = pic_.interruptAcknowledge();
             if (i != 0xFF && i != 0x08) {
-                std::cout << "Interrupt acknowledge: vector " << std::hex << static_cast<int>(i) << std::dec << "\n" <<
-                    std::flush;
+                log_.log(LogEvent::InterruptAcknowledge, i);
             }
             return i;
         }
         if (type_ == 1) {
-            // IO read
-
-            // noisy trace debu
-            //std::cout << "IO read from port " << std::hex << _address << std::dec << "\n" << std::flush;
-
-            // Read from IO port
-            switch (address_ & 0x3e0) {
-                case 0x00:
-                    return dmac_.read(address_ & 0x0f);
-                case 0x20:
-                    return pic_.read(address_ & 1);
-                case 0x40:
-                {
-                    const uint8_t b = pit_.read(address_ & 3);
-                    // std::cout << "PIT read from port " << std::hex << (_address & 3)
-                    //     << ": " << std::hex << static_cast<int>(b) << std::dec << "\n";
-                    return b;
-                }
-                case 0x60:
-                {
-                    //std::cout << "PPI read from port " << std::hex << (_address & 3) << std::dec << "\n";
-                    const uint8_t b = ppi_.read(address_ & 3);
-                    updatePPI();
-                    return b;
-                }
-                case 0x80:
-                    switch (address_) {
-                        case 0x87:
-                            return dma_pages_[0];
-                        case 0x83:
-                            return dma_pages_[1];
-                        case 0x81:
-                            return dma_pages_[2];
-                        case 0x82:
-                            return dma_pages_[3];
-                        default:
-                            break;
-                    }
-                    break;
-                case 0x3C0:
-                    return cga_.readIO(address_ & 0x0F);
-                case 0x3E0:
-                    return fdc_.readIO(address_ & 7);
-                default:
-                    //std::cout << "Unhandled IO read from port " << std::hex << _address << std::dec << "\n";
-                    return 0xFF;
-            }
-        }
-
-        if (address_ < CONVENTIONAL_RAM_SIZE) {
-            return ram_[address_];
-        }
-        if (address_ >= ROM_BASE_ADDRESS) {
-            // Read from ROM.
-            return rom_[address_ - ROM_BASE_ADDRESS];
-        }
-        if (address_ >= CGA_ADDRESS && address_ < CGA_ADDRESS + 0x4000) {
-            return cga_.readMem(address_ - CGA_ADDRESS);
+            return io_.read(address_);
         }
-        // No match? Return open bus.
-        return 0xFF;
+        return memory_.read(address_);
     }
 
     bool interruptPending() { return pic_.interruptPending(); }
 
     int pitBits() {
-        return (pit_phase_ == 1 || pit_phase_ == 2 ? 1 : 0) +
+        const int pit_phase = pitPhase();
+        return (pit_phase == 1 || pit_phase == 2 ? 1 : 0) +
             (counter2_gate_ ? 2 : 0) + (pit_.getOutput(2) ? 4 : 0);
     }
 
     void setPassiveOrHalt(bool v) { passive_or_halt_ = v; }
 
     [[nodiscard]] bool getAEN() const {
-        return dma_state_ == sAEN || dma_state_ == s0 || dma_state_ == s1 ||
-            dma_state_ == s2 || dma_state_ == s3 || dma_state_ == sWait ||
-            dma_state_ == s4;
+        return kDmaStates[dma_state_].aen;
     }
 
     uint8_t getDMA() {
@@ -483,14 +493,7 @@ public:
     }
 
     [[nodiscard]] int getBusOperation() const {
-        switch (dma_state_) {
-            case s2:
-                return 5; // memr
-            case s3:
-                return 2; // iow
-            default:
-                return 0;
-        }
+        return kDmaStates[dma_state_].bus_operation;
     }
 
     bool getDMAS3() { return dma_state_ == s3; }
@@ -504,27 +507,326 @@ public:
     uint8_t getIRQLines() { return pic_.getIRQLines(); }
 
     uint8_t getDMAS() {
-        if (dma_state_ == sAEN || dma_state_ == s0 || dma_state_ == s1 ||
-            dma_state_ == s2 || dma_state_ == s3 || dma_state_ == sWait)
-            return 3;
-        if (dma_state_ == sHRQ || dma_state_ == sHoldWait ||
-            dma_state_ == sPreAEN)
-            return 1;
-        return 0;
+        return kDmaStates[dma_state_].dmas;
     }
 
     uint8_t getCGA() {
-        return cga_phase_ >> 2;
+        // The bus's view of the CGA clock phase advances by 3 (mod 16) every tick since reset.
+        return ((3 * (_ticks - cga_phase_start_)) & 0x0f) >> 2;
     }
 
 private
 :
+    // Device events, in the order the devices are ticked within one tick.
+    enum Event
+    {
+        eventPit, // Every 4th tick
+        eventSpeaker, // Speaker output follows counter 2 and the speaker mask after a short delay
+        eventKeyboardCheck, // Every 16th tick
+        eventSlowTick, // Every 0x4000th tick: keyboard and FDC delays
+        eventCount,
+    };
+
+    // Run the device events due on the current tick.
+    void runEvents() {
+        in_events_ = true;
+        speaker_done_ = false;
+
+        if (scheduler_.at(eventPit) == _ticks) {
+            // The PIT ticks before this one can't change an output.
+            pit_.advance((_ticks - pit_last_tick_) / 4 - 1);
+            pit_last_tick_ = _ticks;
+            pit_.tick();
+            bool counter0Output = pit_.getOutput(0);
+            if (last_counter0_output_ != counter0Output) {
+                pic_.setIRQLine(0, counter0Output);
+            }
+            last_counter0_output_ = counter0Output;
+
+            bool counter1Output = pit_.getOutput(1);
+            if (counter1Output && !last_counter1_output_ && !dack0()) {
+                dmac_.setDMARequestLine(0, true);
+            }
+            last_counter1_output_ = counter1Output;
+
+            bool counter2Output = pit_.getOutput(2);
+            if (counter2_output_ != counter2Output) {
+                counter2_output_ = counter2Output;
+                setSpeakerOutput();
+                ppi_.setC(5, counter2Output);
+                updatePPI();
+            }
+            schedulePit();
+        }
+
+        speaker_done_ = true;
+        if (scheduler_.at(eventSpeaker) == _ticks) {
+            scheduler_.cancel(eventSpeaker);
+            speaker_output_ = next_speaker_output_;
+            ppi_.setC(4, speaker_output_);
+            updatePPI();
+        }
+
+        if (scheduler_.at(eventKeyboardCheck) == _ticks) {
+            scheduler_.schedule(eventKeyboardCheck, _ticks + 0x10);
+            // Check and clear the keyboard
+            const auto kb_cleared = ppi_.getB(7);
+            const auto kb_disabled = !ppi_.getB(6);
+            if (kb_disabled && !last_kb_disabled_) {
+                // Keyboard was just disabled.
+                log_.log(LogEvent::KeyboardDisabled);
+                if constexpr (Config::kHasKeyboard) {
+                    kb_.setClockLineState(false);
+                }
+            }
+            else if (!kb_disabled && last_kb_disabled_) {
+                // Keyboard was just enabled.
+                log_.log(LogEvent::KeyboardEnabled);
+                if constexpr (Config::kHasKeyboard) {
+                    kb_.setClockLineState(true);
+                }
+            }
+
+            if (kb_cleared && !last_kb_cleared_) {
+                // KSR was just cleared.
+                log_.log(LogEvent::KeyboardCleared);
+                // Clear any pending IRQ 1.
+                pic_.setIRQLine(1, false);
+                // Clear the KSR attached to PPI port A.
+                for (int i = 0; i < 8; ++i) {
+                    ppi_.setA(i, false);
+                }
+            }
+            else if (!kb_disabled && last_kb_disabled_) {
+                // Keyboard was just enabled.
+                log_.log(LogEvent::KeyboardReenabled);
+            }
+            last_kb_disabled_ = kb_disabled;
+            last_kb_cleared_ = kb_cleared;
+        }
+
+        if (scheduler_.at(eventSlowTick) == _ticks) {
+            scheduler_.schedule(eventSlowTick, _ticks + 0x4000);
+            // Slow tick = ~1.144ms. Good for ticking ms-scale delays.
+
+            // Tick the keyboard. The keyboard needs to be ticked to produce reset bytes after a delay when reset,
+            // and to produce type-matic repeat keys.
+            if constexpr (Config::kHasKeyboard) {
+                kb_.tick();
+                if (uint8_t b = 0; kb_.getScanCode(b)) {
+                    // Keyboard-originated scancode (reset byte or type-matic key)
+                    log_.log(LogEvent::KeyboardScancode, b);
+                    for (int i = 0; i < 8; ++i) {
+                        const auto bit = (b >> i) & 1;
+                        ppi_.setA(i, bit != 0);
+                    }
+                    pic_.setIRQLine(1, true);
+                }
+            }
+
+            // Tick the FDC. The FDC needs to be ticked to simulate operational delays.
+            if constexpr (Config::kHasFdc) {
+                fdc_.tick();
+            }
+        }
+
+        in_events_ = false;
+    }
+
+    [[nodiscard]] static uint32_t biosAddress(const size_t size) {
+        return static_cast<uint32_t>(MemoryMap::kAddressMask + 1 - size);
+    }
+
+    // Route each device's ports. Blocks of 32 ports are only partially decoded, so registers repeat within them and
+    // above 0x3FF. The DMA page registers are decoded in full.
+    void mapIoPorts() {
+        io_.clear();
+        io_.mapPorts(0x00, 0x20, {
+            &dmac_,
+            [](void* dmac, const uint16_t port) { return static_cast<DMAC*>(dmac)->read(port & 0x0f); },
+            [](void* dmac, const uint16_t port, const uint8_t data) {
+                static_cast<DMAC*>(dmac)->write(port & 0x0f, data);
+            }
+        });
+        io_.mapPorts(0x20, 0x20, {
+            &pic_,
+            [](void* pic, const uint16_t port) { return static_cast<PIC*>(pic)->read(port & 1); },
+            [](void* pic, const uint16_t port, const uint8_t data) { static_cast<PIC*>(pic)->write(port & 1, data); }
+        });
+        io_.mapPorts(0x40, 0x20, {
+            this,
+            [](void* context, const uint16_t port) {
+                auto* bus = static_cast<BasicBus*>(context);
+                bus->syncPit();
+                return bus->pit_.read(port & 3);
+            },
+            [](void* context, const uint16_t port, const uint8_t data) {
+                auto* bus = static_cast<BasicBus*>(context);
+                bus->syncPit();
+                bus->pit_.write(port & 3, data);
+                bus->schedulePit();
+            }
+        });
+        io_.mapPorts(0x60, 0x20, {
+            this,
+            [](void* context, const uint16_t port) {
+                auto* bus = static_cast<BasicBus*>(context);
+                const uint8_t b = bus->ppi_.read(port & 3);
+                bus->updatePPI();
+                return b;
+            },
+            [](void* context, const uint16_t port, const uint8_t data) {
+                auto* bus = static_cast<BasicBus*>(context);
+                bus->ppi_.write(port & 3, data);
+                bus->updatePPI();
+            }
+        });
+        // Don't ask me why the DMA page registers are ordered this way.
+        constexpr uint16_t kPagePorts[4] = {0x87, 0x83, 0x81, 0x82};
+        for (const uint16_t page_port : kPagePorts) {
+            io_.mapPorts(page_port, 1, {
+                this,
+                [](void* context, const uint16_t port) {
+                    return static_cast<BasicBus*>(context)->dma_pages_[dmaPageChannel(port)];
+                },
+                [](void* context, const uint16_t port, const uint8_t data) {
+                    auto* bus = static_cast<BasicBus*>(context);
+                    const int channel = dmaPageChannel(port);
+                    bus->log_.log(LogEvent::DmaPageWrite, channel, data);
+                    bus->dma_pages_[channel] = data;
+                },
+                true
+            });
+        }
+        io_.mapPorts(0xA0, 0x20, {
+            this,
+            nullptr,
+            [](void* context, uint16_t, const uint8_t data) {
+                static_cast<BasicBus*>(context)->nmi_enabled_ = (data & 0x80) != 0;
+            }
+        });
+        if constexpr (Config::kHasCga) {
+            mapCgaPorts();
+        }
+        if constexpr (Config::kHasFdc) {
+            io_.mapPorts(0x3E0, 0x20, {
+                &fdc_,
+                [](void* fdc, const uint16_t port) { return static_cast<FDC*>(fdc)->readIO(port & 7); },
+                [](void* fdc, const uint16_t port, const uint8_t data) {
+                    static_cast<FDC*>(fdc)->writeIO(port & 7, data);
+                }
+            });
+        }
+    }
+
+    // A named function rather than a lambda, so that stableRead() can tell the CGA's ports from others.
+    static uint8_t readCgaPort(void* context, const uint16_t port) {
+        auto* bus = static_cast<BasicBus*>(context);
+        bus->syncCga();
+        return bus->cga_.readIO(port & 0x0F);
+    }
+
+    void mapCgaPorts() {
+        io_.mapPorts(0x3C0, 0x20, {
+            this,
+            &readCgaPort,
+            [](void* context, const uint16_t port, const uint8_t data) {
+                auto* bus = static_cast<BasicBus*>(context);
+                bus->syncCga();
+                bus->cga_.writeIO(port & 0x0F, data);
+            }
+        });
+    }
+
+    [[nodiscard]] static int dmaPageChannel(const uint16_t port) {
+        switch (port) {
+            case 0x87:
+                return 0;
+            case 0x83:
+                return 1;
+            case 0x81:
+                return 2;
+            default:
+                return 3;
+        }
+    }
+
+    // Rebuild the memory map from the configured RAM, devices and ROMs.
+    void remapMemory() {
+        memory_.clear();
+        memory_.mapMemory(0, static_cast<uint32_t>(ram_.size()), ram_.data(), true);
+        if constexpr (Config::kHasCga) {
+            memory_.mapDevice(kCgaAddress, VRAM_SIZE, {
+                this,
+                [](void* context, const uint32_t offset) {
+                    return static_cast<BasicBus*>(context)->cga_.readMem(static_cast<uint16_t>(offset));
+                },
+                [](void* context, const uint32_t offset, const uint8_t data) {
+                    // The characters drawn up to now must see the old contents.
+                    auto* bus = static_cast<BasicBus*>(context);
+                    bus->syncCga();
+                    bus->cga_.writeMem(static_cast<uint16_t>(offset), data);
+                }
+            });
+        }
+        for (const auto& device : devices_) {
+            memory_.mapDevice(device.address, device.size, device.handler);
+        }
+        for (auto& rom : option_roms_) {
+            memory_.mapMemory(rom.address, static_cast<uint32_t>(rom.data.size()), rom.data.data(), false);
+        }
+        memory_.mapMemory(biosAddress(rom_.size()), static_cast<uint32_t>(rom_.size()), rom_.data(), false);
+    }
+
+    // Restart the device clocks after a reset. The keyboard check and the slow tick stay on multiples of 0x10 and
+    // 0x4000 ticks; a pending speaker update survives a reset, as it always has.
+    void resetSchedule() {
+        cga_ticks_ = _ticks;
+        cga_phase_start_ = _ticks;
+        pit_last_tick_ = _ticks - 2;
+        schedulePit();
+        scheduler_.schedule(eventKeyboardCheck, (_ticks | 0xF) + 1);
+        if constexpr (Config::kHasKeyboard || Config::kHasFdc) {
+            scheduler_.schedule(eventSlowTick, (_ticks | 0x3FFF) + 1);
+        }
+    }
+
+    // Bring the CGA up to date before anything that depends on it or changes it: its registers, status and VRAM
+    // writes, and whoever reads its frame buffers. Nothing else affects what the card draws, so it isn't ticked as the
+    // bus runs but catches up here, rendering all the character clocks since the last sync in one go.
+    void syncCga() {
+        if constexpr (Config::kHasCga) {
+            cga_.advance(_ticks - cga_ticks_);
+            cga_ticks_ = _ticks;
+        }
+    }
+
+    // Ticks since the last PIT tick (0 to 3).
+    [[nodiscard]] int pitPhase() const {
+        return static_cast<int>((_ticks - pit_last_tick_) & 3);
+    }
+
+    // Bring the PIT up to date before anything reads or changes it. The PIT ticks in between were not events, so
+    // none of them changed an output.
+    void syncPit() {
+        const uint64_t n = (_ticks - pit_last_tick_) / 4;
+        pit_.advance(n);
+        pit_last_tick_ += 4 * n;
+    }
+
+    // Schedule the first PIT tick that might change a counter output. An output the bus hasn't acted on yet, after a
+    // control word or a gate change, is handled on the next PIT tick. The PIT must be in sync.
+    void schedulePit() {
+        uint64_t n = pit_.ticksUntilOutputChange();
+        if (pit_.getOutput(0) != last_counter0_output_ || pit_.getOutput(1) != last_counter1_output_ ||
+            pit_.getOutput(2) != counter2_output_) {
+            n = 1;
+        }
+        scheduler_.schedule(eventPit, pit_last_tick_ + 4 * n);
+    }
+
     bool dmaReady() {
-        if (dma_state_ == s1 || dma_state_ == s2 || dma_state_ == s3 ||
-            dma_state_ == sWait || dma_state_ == s4 || dma_state_ == sDelayedT1 ||
-            dma_state_ == sDelayedT2 /*|| _dmaState == sDelayedT3*/)
-            return false;
-        return true;
+        return kDmaStates[dma_state_].ready;
     }
 
     bool nonDMAReady() {
@@ -534,22 +836,43 @@ private
     }
 
     bool dack0() {
-        return dma_state_ == s1 || dma_state_ == s2 || dma_state_ == s3 ||
-            dma_state_ == sWait;
+        return kDmaStates[dma_state_].dack0;
+    }
+
+    // S2 of a channel 2 cycle: move one byte between the FDC and memory. The FDC serves reads from the run of image
+    // bytes the operation covers, so a transfer is an index and a store; each byte still takes its own DMA cycle,
+    // since the CPU sees both the wait states and the memory between bytes.
+    void transferChannel2() {
+        const uint32_t addr = dmaAddressHigh(2) + static_cast<uint32_t>(dmac_.getAddress());
+        if (dmac_.isReading()) {
+            log_.log(LogEvent::DmaChannel2Read, addr);
+        }
+        else if (dmac_.isWriting()) {
+            memory_.write(addr, fdc_.dmaDeviceRead());
+        }
+        dmac_.service();
+        if (dmac_.isAtTerminalCount()) {
+            // Notify FDC that DMA operation is complete
+            log_.log(LogEvent::DmaTerminalCount, addr, dma_pages_[2]);
+            fdc_.dmaDeviceEOP();
+        }
     }
 
     void setSpeakerOutput() {
         bool o = !(counter2_output_ && speaker_mask_);
 
+        syncPit();
         const auto pit_ticks = pit_.getTicks();
         speaker_callback_(pit_ticks, counter2_output_, speaker_mask_);
 
         if (next_speaker_output_ != o) {
             if (speaker_output_ == o) {
-                speaker_cycle_ = 0;
+                scheduler_.cancel(eventSpeaker);
             }
             else {
-                speaker_cycle_ = o ? 3 : 2;
+                // The speaker follows after 3 or 2 ticks, counting this tick if its speaker update hasn't run yet.
+                const uint64_t first = in_events_ && !speaker_done_ ? _ticks : _ticks + 1;
+                scheduler_.schedule(eventSpeaker, first + (o ? 3 : 2) - 1);
             }
             next_speaker_output_ = o;
         }
@@ -562,21 +885,23 @@ private
             setSpeakerOutput();
         }
         counter2_gate_ = ppi_.getB(0);
+        syncPit();
         pit_.setGate(2, counter2_gate_);
+        schedulePit();
 
         if (!ppi_.getB(3)) {
             // Present switches 1 to 4
-            ppi_.setC(0, (dip_switch1_ & 0x01) != 0);
-            ppi_.setC(1, (dip_switch1_ & 0x02) != 0);
-            ppi_.setC(2, (dip_switch1_ & 0x04) != 0);
-            ppi_.setC(3, (dip_switch1_ & 0x08) != 0);
+            ppi_.setC(0, (Config::kDipSwitch1 & 0x01) != 0);
+            ppi_.setC(1, (Config::kDipSwitch1 & 0x02) != 0);
+            ppi_.setC(2, (Config::kDipSwitch1 & 0x04) != 0);
+            ppi_.setC(3, (Config::kDipSwitch1 & 0x08) != 0);
         }
         else {
             // Present switches 5 to 8
-            ppi_.setC(0, (dip_switch1_ & 0x10) != 0);
-            ppi_.setC(1, (dip_switch1_ & 0x20) != 0);
-            ppi_.setC(2, (dip_switch1_ & 0x40) != 0);
-            ppi_.setC(3, (dip_switch1_ & 0x80) != 0);
+            ppi_.setC(0, (Config::kDipSwitch1 & 0x10) != 0);
+            ppi_.setC(1, (Config::kDipSwitch1 & 0x20) != 0);
+            ppi_.setC(2, (Config::kDipSwitch1 & 0x40) != 0);
+            ppi_.setC(3, (Config::kDipSwitch1 & 0x80) != 0);
         }
 
     }
@@ -605,43 +930,102 @@ private
         sDelayedT3,
     };
 
+    // What each DMA state presents to the CPU and the debugger, and the state that follows it when no condition or
+    // side effect applies (see tick()).
+    struct DmaStateInfo
+    {
+        DMAState next;
+        bool ready; // The DMA side of READY, low from S1 until the delayed cycles end
+        bool aen; // Address enable: the DMAC owns the bus
+        bool dack0; // Refresh acknowledge
+        uint8_t dmas; // Sniffer DMA status: 3 with the bus held, 1 while requesting hold, otherwise 0
+        uint8_t bus_operation; // Sniffer bus operation: 5 for MEMR, 2 for IOW, otherwise 0
+    };
+
+    static constexpr DmaStateInfo kDmaStates[] = {
+        /* sIdle      */ {sIdle, true, false, false, 0, 0},
+        /* sDREQ      */ {sHRQ, true, false, false, 0, 0},
+        /* sHRQ       */ {sHRQ, true, false, false, 1, 0},
+        /* sHoldWait  */ {sHoldWait, true, false, false, 1, 0},
+        /* sPreAEN    */ {sPreAEN, true, false, false, 1, 0},
+        /* sAEN       */ {s0, true, true, false, 3, 0},
+        /* s0         */ {s1, true, true, false, 3, 0},
+        /* s1         */ {s2, false, true, true, 3, 0},
+        /* s2         */ {s3, false, true, true, 3, 5},
+        /* s3         */ {s4, false, true, true, 3, 2},
+        /* sWait      */ {sWait, false, true, true, 3, 0},
+        /* s4         */ {sDelayedT1, false, true, false, 0, 0},
+        /* sDelayedT1 */ {sDelayedT2, false, false, false, 0, 0},
+        /* sDelayedT2 */ {sDelayedT3, false, false, false, 0, 0},
+        /* sDelayedT3 */ {sIdle, true, false, false, 0, 0},
+    };
+    static_assert(std::size(kDmaStates) == sDelayedT3 + 1, "kDmaStates must have an entry for every DMAState");
+
+    // Ticks from sDREQ back to sIdle for a DMA cycle that is granted the bus at once.
+    static constexpr uint32_t kRefreshTicks = 11;
+
+    // Per-tick state first, starting on a cache line boundary, followed by the small devices ticked or polled on
+    // every cycle and the memory map. The CGA, whose frame buffers take up most of the object, and the rarely ticked
+    // devices come last.
+    alignas(64) uint64_t _ticks{0};
+    Scheduler<Event, eventCount> scheduler_;
+    uint64_t cga_ticks_{0}; // The tick the CGA has been brought up to
+    uint64_t cga_phase_start_{0};
+    uint64_t pit_last_tick_{0}; // The tick of the last PIT tick the PIT has been brought up to
+    bool in_events_{false};
+    bool speaker_done_{false}; // Inside runEvents(): this tick's speaker update has run
+    uint32_t address_{0};
+    int type_{0};
+    int cycle_{0};
+    int dma_cycles_{0};
+    int dma_type_{0};
+    DMAState dma_state_{sIdle};
+    uint16_t dma_address_{0};
+    uint8_t dma_pages_[4]{};
+    bool last_counter0_output_{false};
+    bool last_irq6_{false};
+    bool last_counter1_output_{true};
+    bool counter2_output_{false};
+    bool counter2_gate_{false};
+    bool speaker_mask_{false};
+    bool speaker_output_{false};
+    bool next_speaker_output_{false};
+    bool nmi_enabled_{false};
+    bool passive_or_halt_{true};
+    bool lock_{false};
+    bool previous_passive_or_halt_{true};
+    bool last_non_dma_ready_{true};
+    bool last_kb_disabled_{false};
+    bool last_kb_cleared_{false};
     std::vector<uint8_t> ram_;
-    std::vector<uint8_t> rom_;
-    uint32_t address_;
-    int type_;
-    int cycle_;
     DMAC dmac_;
     PIC pic_;
     PIT pit_;
     PPI ppi_;
-    CGA cga_;
+    MemoryMap memory_;
+
+    struct OptionRom
+    {
+        uint32_t address;
+        std::vector<uint8_t> data;
+    };
+
+    struct MemoryDevice
+    {
+        uint32_t address;
+        uint32_t size;
+        MemoryHandler handler;
+    };
+
+    std::vector<uint8_t> rom_; // System BIOS, mapped at the top of the address space
+    std::vector<OptionRom> option_roms_;
+    std::vector<MemoryDevice> devices_;
+    PcSpeakerCallback speaker_callback_{nullptr};
+    IoMap io_;
+    EventLog log_;
     FDC fdc_;
     Keyboard kb_;
-    uint8_t dip_switch1_{0b0110'1101};
-    int pit_phase_;
-    bool last_counter0_output_;
-    bool last_irq6_{false};
-    bool last_counter1_output_;
-    bool counter2_output_;
-    bool counter2_gate_;
-    bool speaker_mask_;
-    bool speaker_output_;
-    bool next_speaker_output_;
-    uint16_t dma_address_;
-    int dma_cycles_;
-    int dma_type_;
-    int speaker_cycle_;
-    uint8_t dma_pages_[4];
-    bool nmi_enabled_;
-    bool passive_or_halt_;
-    DMAState dma_state_;
-    bool lock_;
-    bool previous_passive_or_halt_;
-    bool last_non_dma_ready_;
-    uint8_t cga_phase_;
-    bool last_kb_disabled_{false};
-    bool last_kb_cleared_{false};
-    PcSpeakerCallback speaker_callback_{nullptr};
-    uint64_t
-    _ticks{0};
+    CGA cga_;
 };
+
+using Bus = BasicBus<Ibm5160>;
@@ -90,7 +90,9 @@ void CGA::updateMode() {
     if (clock_changed) {
         // Flag the clock for pending change.  The clock can only be changed in phase with
         // LCHAR due to our dynamic clocking logic.
-        std::cout << "CGA: Clock change pending";
+        if (log_ != nullptr) {
+            log_->log(LogEvent::CgaClockChangePending);
+        }
         clock_pending_ = true;
     }
 
@@ -181,12 +183,19 @@ uint8_t CGA::readStatusRegister() const {
     return byte;
 }
 
+void CGA::setFrameFormat(const CgaFrameFormat format) {
+    frame_format_ = format;
+    memset(buf_, 0, sizeof(buf_));
+    drawn_count_[0] = drawn_count_[1] = 0;
+    beam_count_ = 0;
+}
+
 uint8_t* CGA::getBackBuffer() {
     return &buf_[back_buf_][0];
 }
 
 size_t CGA::getBackBufferSize() const {
-    return sizeof(buf_[0]);
+    return frame_format_ == CgaFrameFormat::Packed4 ? sizeof(buf_[0]) / 2 : sizeof(buf_[0]);
 }
 
 uint8_t* CGA::getFrontBuffer() {
@@ -194,7 +203,7 @@ uint8_t* CGA::getFrontBuffer() {
 }
 
 size_t CGA::getFrontBufferSize() const {
-    return sizeof(buf_[0]);
+    return frame_format_ == CgaFrameFormat::Packed4 ? sizeof(buf_[0]) / 2 : sizeof(buf_[0]);
 }
 
 Crtc6845* CGA::crtc() {
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
+#include "CgaKernels.h"
 #include "Crtc.h"
+#include "EventLog.h"
 #include "font.h"
 #include "src/xtce_blue.h"
 
@@ -201,6 +204,13 @@ constexpr std::array<std::array<uint64_t, 256>, 16> makeCgaHiresGraphicsTable()
 
 constexpr auto CGA_HIRES_GFX_TABLE = makeCgaHiresGraphicsTable();
 
+// Layout of the CGA frame buffers.
+enum class CgaFrameFormat : uint8_t
+{
+    Indexed8, // One palette index per byte
+    Packed4, // Two palette indices per byte, the left pixel in the low nibble
+};
+
 class CGA
 {
 
@@ -255,6 +265,8 @@ public:
         memset(buf_, 0, sizeof(buf_));
         back_buf_ = 0;
         front_buf_ = 1;
+        drawn_count_[0] = drawn_count_[1] = 0;
+        beam_count_ = 0;
 
         cga_phase_ = 0;
         ticks_ = 0;
@@ -302,6 +314,59 @@ public:
         frame_count_ = 0;
     }
 
+    // Save or load the card's state: VRAM, both frame buffers, the CRTC and the beam (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar.bytes(vram_, sizeof(vram_));
+        ar(frame_format_);
+        ar.bytes(buf_[0], getFrontBufferSize());
+        ar.bytes(buf_[1], getFrontBufferSize());
+        ar(back_buf_);
+        ar(front_buf_);
+        ar(drawn_extents_);
+        ar(drawn_count_);
+        ar(beam_extents_);
+        ar(beam_count_);
+        ar(cursor_data_);
+        crtc_.serialize(ar);
+        ar(cga_phase_);
+        ar(ticks_);
+        ar(clock_divisor_);
+        ar(char_clock_);
+        ar(char_clock_mask_);
+        ar(char_clock_odd_mask_);
+        ar(vma_);
+        ar(rba_);
+        ar(lp_latch_);
+        ar(lp_switch_);
+        ar(cursor_blink_);
+        ar(cursor_status_);
+        ar(blink_state_);
+        ar(mode_byte_);
+        ar(mode_pending_);
+        ar(clock_pending_);
+        ar(mode_enable_);
+        ar(mode_bw_);
+        ar(mode_graphics_);
+        ar(mode_blinking_);
+        ar(mode_hires_gfx_);
+        ar(mode_hires_text_);
+        ar(monitor_hsync_);
+        ar(monitor_vsync_);
+        ar(beam_x_);
+        ar(beam_y_);
+        ar(scanline_);
+        ar(cur_fg_);
+        ar(cur_bg_);
+        ar(cc_register_byte_);
+        ar(cc_overscan_color_);
+        ar(cc_alt_color_);
+        ar(cc_palette_);
+        ar(cur_char_);
+        ar(cur_attr_);
+        ar(frame_count_);
+    }
+
     CgaDebugState getDebugState() const {
         CgaDebugState state{};
         state.mode_byte = mode_byte_;
@@ -320,6 +385,10 @@ public:
         return vram_;
     }
 
+    void attachLog(EventLog* log) {
+        log_ = log;
+    }
+
     static DisplayAperture getDisplayAperture() {
         return DisplayAperture{
             .fw = CGA_XRES_MAX,
@@ -343,9 +412,13 @@ public:
         vram_[address & CGA_APERTURE_MASK] = data;
     }
 
+    // Choose the frame buffer layout. Both buffers are cleared.
+    void setFrameFormat(CgaFrameFormat format);
+    [[nodiscard]] CgaFrameFormat frameFormat() const { return frame_format_; }
+
     uint8_t* getBackBuffer();
     [[nodiscard]] size_t getBackBufferSize() const;
-    // Front buffer accessors (visible rasterized indexed buffer)
+    // Front buffer accessors (visible rasterized buffer, in the layout frameFormat() gives)
     uint8_t* getFrontBuffer();
     [[nodiscard]] size_t getFrontBufferSize() const;
 
@@ -372,31 +445,15 @@ public:
     void tick() {
         ticks_++;
         if ((ticks_ & char_clock_mask_) == 0) {
+            draw_char();
 
-            if (clock_divisor_ == 2) {
-                tick_lchar();
-            }
-            else {
-                tick_hchar();
-            }
-
-            // Provide an HBlankCallback that returns the required value (5).
-            // crtc_.tick expects a std::function<uint8_t(void)>.
-            auto [status, vma] = crtc_.tick([this]() -> uint8_t
-            {
-                if (clock_divisor_ == 1) {
-                    return 10;
-                }
-                else {
-                    return 5;
-                }
-            });
-            vma_ = vma;
-            if (status->vsync) {
+            const auto& status = crtc_.tick(hsync_width());
+            vma_ = crtc_.address();
+            if (status.vsync) {
                 //std::cout << "CGA: VSYNC asserted at beamX=" << beamX_ << " beamY=" << beamY_ << "\n";
                 vsync();
             }
-            if (status->hsync) {
+            if (status.hsync) {
                 hsync();
             }
             fetch_char();
@@ -405,6 +462,48 @@ public:
         cga_phase_ = (cga_phase_ + 3) & 0x0f;
     }
 
+    // Return the number of ticks until the next character clock. tick() does nothing but count on the ticks before it.
+    [[nodiscard]] uint32_t ticksUntilCharClock() const {
+        return static_cast<uint32_t>(char_clock_mask_ + 1 - (ticks_ & char_clock_mask_));
+    }
+
+    // Return the number of ticks until the first tick that might change what readStatusRegister() returns (the next
+    // tick is 1). Between port accesses only the CRTC's display enable and vertical blank move, on a character clock.
+    [[nodiscard]] uint32_t ticksUntilStatusChange() const {
+        const uint32_t to_char = ticksUntilCharClock();
+        if (clock_pending_) {
+            return to_char;
+        }
+        return to_char + (crtc_.charsUntilStatusChange() - 1) * static_cast<uint32_t>(char_clock_mask_ + 1);
+    }
+
+    // Count n ticks at once. None of them may be a character clock.
+    void skipTicks(const uint64_t n) {
+        ticks_ += n;
+        cga_phase_ = (cga_phase_ + 3 * (n & 0x0f)) & 0x0f;
+    }
+
+    // Run n ticks, exactly as n calls to tick() would, but rendering the character clocks among them back to back
+    // without visiting the ticks in between. The bus calls this to catch the card up just before the CPU touches it,
+    // so nothing can change the output within a run.
+    void advance(uint64_t n) {
+        for (uint64_t to_char = ticksUntilCharClock(); n >= to_char; to_char = ticksUntilCharClock()) {
+            skipTicks(to_char - 1);
+            n -= to_char;
+            // Where the CRTC only counts for a while, draw those characters without stepping it one at a time. A
+            // pending clock change is tried on every character clock, so it takes the full step.
+            const uint64_t chars =
+                clock_pending_ ? 0 : std::min<uint64_t>(crtc_.charsUntilBoundary(), 1 + n / char_clock_);
+            if (chars == 0) {
+                tick();
+                continue;
+            }
+            run_chars(chars);
+            n -= (chars - 1) * char_clock_;
+        }
+        skipTicks(n);
+    }
+
     static std::string getRegisterName(const int reg) {
         switch (reg) {
             case 0:
@@ -454,12 +553,33 @@ private:
     void updateClock();
 
     alignas(8) uint8_t vram_[VRAM_SIZE]{};
+    EventLog* log_{nullptr};
     bool cursor_data_[CGA_CURSOR_MAX]{};
-    uint8_t buf_[2][CGA_MAX_CLOCK]{};
+    // A run of pixels drawn in a frame buffer, as pixel offsets.
+    struct Extent
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    // The beam draws each scanline at most once per frame, from its left edge.
+    static constexpr size_t CGA_EXTENTS_MAX = CGA_YRES_MAX;
+
+    alignas(8) uint8_t buf_[2][CGA_MAX_CLOCK]{};
     size_t back_buf_{0};
     size_t front_buf_{1};
+    CgaFrameFormat frame_format_{CgaFrameFormat::Indexed8};
+    // What each buffer holds: nothing is drawn outside its extents. The back buffer's are from the frame before last.
+    std::array<Extent, CGA_EXTENTS_MAX> drawn_extents_[2]{};
+    uint32_t drawn_count_[2]{};
+    // What the beam has drawn into the back buffer this frame, in ascending order.
+    std::array<Extent, CGA_EXTENTS_MAX> beam_extents_{};
+    uint32_t beam_count_{0};
+    // A span in one byte per pixel, to be packed when the frame buffers are packed.
+    alignas(32) uint8_t span_line_[CGA_XRES_MAX + 16]{};
 
     Crtc6845 crtc_{};
+    const CgaKernels* kernels_{&cgaKernels()};
     uint8_t cga_phase_{0};
     uint64_t ticks_{0};
 
@@ -528,6 +648,145 @@ private:
         {{0, 11, 12, 15}}, // Red / Cyan / White High Intensity
     }};
 
+    // The HSYNC width the card generates, in character clocks.
+    [[nodiscard]] uint8_t hsync_width() const {
+        return clock_divisor_ == 1 ? 10 : 5;
+    }
+
+    // Draw the character at the beam.
+    void draw_char() {
+        if (clock_divisor_ == 2) {
+            tick_lchar();
+        }
+        else {
+            tick_hchar();
+        }
+    }
+
+    // Run chars character clocks, the first due on the next tick, on which the CRTC only counts (see
+    // Crtc6845::charsUntilBoundary()). Display enable, the row and the sync state hold throughout, so the characters
+    // after the first are drawn as one span, and the CRTC catches up at the end.
+    void run_chars(const uint64_t chars) {
+        // The first character was fetched before the run, and is drawn as fetched even if VRAM has changed since.
+        skipTicks(1);
+        draw_char();
+        vma_ = static_cast<uint16_t>(vma_ + 1);
+        const uint64_t rest = chars - 1;
+        if (rest != 0) {
+            if (!crtc_.den() || mode_enable_) {
+                draw_span(rest);
+                vma_ = static_cast<uint16_t>(vma_ + rest);
+            }
+            else {
+                for (uint64_t i = 0; i < rest; ++i) {
+                    fetch_char();
+                    draw_char();
+                    vma_ = static_cast<uint16_t>(vma_ + 1);
+                }
+            }
+            skipTicks(rest * char_clock_);
+        }
+        fetch_char();
+        crtc_.runChars(static_cast<uint32_t>(chars));
+    }
+
+    // Draw count characters from the current address on, as count calls to draw_char() with each character fetched
+    // in turn would, through the span kernels. The beam moves as it would, wrapping at the right edge of the monitor.
+    void draw_span(uint64_t count) {
+        const uint32_t char_px = 8 * clock_divisor_;
+        const size_t limit = CGA_MAX_CLOCK - char_px;
+        size_t address = vma_;
+        while (count != 0 && rba_ < limit) {
+            // Up to the edge of the monitor or the end of the buffer, whichever is first.
+            const uint64_t fit = std::min<uint64_t>((CGA_XRES_MAX - beam_x_ + char_px - 1) / char_px,
+                                                    (limit - rba_ + char_px - 1) / char_px);
+            const uint64_t n = draw_segment(address, std::min(count, fit));
+            beam_x_ += static_cast<uint32_t>(n * char_px);
+            rba_ += n * char_px;
+            if (beam_x_ >= CGA_XRES_MAX) {
+                end_line();
+                beam_x_ = 0;
+                beam_y_ += 1;
+                monitor_vsync_ = false;
+                rba_ = CGA_XRES_MAX * beam_y_;
+            }
+            address += n;
+            count -= n;
+        }
+    }
+
+    // Draw up to count characters at the beam, from address on, stopping where the address wraps in VRAM. Returns the
+    // number drawn.
+    uint64_t draw_segment(const size_t address, uint64_t count) {
+        const bool packed = frame_format_ == CgaFrameFormat::Packed4;
+        const uint8_t vlc = crtc_.vlc();
+        if (!crtc_.den() || (clock_divisor_ == 1 && mode_graphics_)) {
+            // The high resolution clock draws nothing in 640x200 graphics.
+            fill_span(count * 8 * clock_divisor_,
+                      clock_divisor_ == 1 && crtc_.den() && mode_hires_gfx_ ? 0 : cc_overscan_color_ & 0x0F);
+            return count;
+        }
+        // The kernels expand to one byte per pixel; a packed frame takes them through a line buffer.
+        uint8_t* out = packed ? span_line_ : &buf_[back_buf_][rba_];
+        if (!mode_graphics_) {
+            const size_t cell = address & CGA_TEXT_MODE_WRAP;
+            count = std::min<uint64_t>(count, CGA_TEXT_MODE_WRAP + 1 - cell);
+            const bool cursor = cursor_status_ && blink_state_ && cursor_data_[vlc & 0x1F];
+            const auto cursor_index = static_cast<uint16_t>(crtc_.cursor_address() - address);
+            const CgaTextSpan span{
+                .font_row = &CGA_FONT_ROM[CGA_NORMAL_FONT_OFFSET + (vlc & 0x07)],
+                .blinking = mode_blinking_,
+                .blink_off = !cursor_status_,
+                .cursor = cursor && cursor_index < count ? cursor_index : CgaTextSpan::kNoCursor,
+            };
+            if (clock_divisor_ == 1) {
+                kernels_->text_hchar(&vram_[cell << 1], count, span, out);
+            }
+            else {
+                kernels_->text_lchar(&vram_[cell << 1], count, span, out);
+            }
+        }
+        else {
+            const size_t offset = address & 0x0FFF;
+            count = std::min<uint64_t>(count, 0x1000 - offset);
+            const uint8_t* bytes = &vram_[(offset | (static_cast<size_t>(vlc) & 0x01) << 12) << 1];
+            if (mode_hires_gfx_) {
+                kernels_->gfx_1bpp(bytes, count * 2, cc_alt_color_, out);
+            }
+            else {
+                const auto& palette = CGA_PALETTES[cc_palette_];
+                const uint8_t colors[4] = {cc_alt_color_, palette[1], palette[2], palette[3]};
+                kernels_->gfx_2bpp(bytes, count * 2, colors, out);
+            }
+        }
+        if (packed) {
+            kernels_->pack_4bpp(span_line_, count * 8 * clock_divisor_, &buf_[back_buf_][rba_ >> 1]);
+        }
+        return count;
+    }
+
+    // Fill pixels pixels from the beam on with one color.
+    void fill_span(const size_t pixels, const uint8_t color) {
+        if (frame_format_ == CgaFrameFormat::Packed4) {
+            std::memset(&buf_[back_buf_][rba_ >> 1], color | color << 4, pixels / 2);
+        }
+        else {
+            std::memset(&buf_[back_buf_][rba_], color, pixels);
+        }
+    }
+
+    // Write 8 pixels, one palette index in each byte of pixels from the low byte up, offset pixels past the beam.
+    void put_pixels(const size_t offset, const uint64_t pixels) {
+        const size_t at = rba_ + offset;
+        if (frame_format_ == CgaFrameFormat::Packed4) {
+            const uint32_t packed = packCgaPixels(pixels);
+            std::memcpy(&buf_[back_buf_][at >> 1], &packed, sizeof(packed));
+        }
+        else {
+            std::memcpy(&buf_[back_buf_][at], &pixels, sizeof(pixels));
+        }
+    }
+
     void tick_lchar() {
         //std::cout << "CGA: tick_lchar at beamX=" << beamX_ << " beamY=" << beamY_ << " rba=" << rba_ << "\n";
 
@@ -557,6 +816,7 @@ private:
             // If we have reached the right edge of the 'monitor', return the raster position
             // to the left side of the screen.
             if (beam_x_ >= CGA_XRES_MAX) {
+                end_line();
                 beam_x_ = 0;
                 beam_y_ += 1;
                 monitor_vsync_ = false;
@@ -576,7 +836,8 @@ private:
                     draw_text_mode_hchar();
                 }
                 else if (mode_hires_gfx_) {
-                    //draw_hires_gfx_mode_char();
+                    // Nothing to draw at this clock, but the beam still covers the pixels.
+                    draw_solid_hchar(0);
                 }
                 else {
                     draw_solid_hchar(cc_overscan_color_);
@@ -593,6 +854,7 @@ private:
             // If we have reached the right edge of the 'monitor', return the raster position
             // to the left side of the screen.
             if (beam_x_ >= CGA_XRES_MAX) {
+                end_line();
                 beam_x_ = 0;
                 beam_y_ += 1;
                 monitor_vsync_ = false;
@@ -602,17 +864,13 @@ private:
     }
 
 
-    // ReSharper disable once CppMemberFunctionMayBeConst
     void draw_solid_hchar(const uint8_t color) {
-        const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
-        frame_u64[rba_ >> 3] = CGA_COLORS_U64[color & 0x0F];
+        put_pixels(0, CGA_COLORS_U64[color & 0x0F]);
     }
 
-    // ReSharper disable once CppMemberFunctionMayBeConst
     void draw_solid_lchar(const uint8_t color) {
-        const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
-        frame_u64[rba_ >> 3] = CGA_COLORS_U64[(color & 0x0F)];
-        frame_u64[(rba_ >> 3) + 1] = CGA_COLORS_U64[(color & 0x0F)];
+        put_pixels(0, CGA_COLORS_U64[(color & 0x0F)]);
+        put_pixels(8, CGA_COLORS_U64[(color & 0x0F)]);
     }
 
     [[nodiscard]] uint64_t get_hchar_glyph_row(const uint8_t glyph, const uint8_t row) const {
@@ -660,8 +918,7 @@ private:
         else if (mode_enable_) {
             // Get the u64 glyph row to draw for the current fg and bg colors and character row (vlc)
             const auto glyph_row = get_hchar_glyph_row(cur_char_, crtc_.vlc());
-            const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
-            frame_u64[rba_ >> 3] = glyph_row;
+            put_pixels(0, glyph_row);
         }
         else {
             // When mode bit is disabled in text mode, the CGA acts like VRAM is all 0.
@@ -676,17 +933,17 @@ private:
             && blink_state_
             && cursor_data_[(crtc_.vlc() & 0x1F)]) {
             draw_solid_hchar(cur_fg_);
+            put_pixels(8, 0);
         }
         else if (mode_enable_) {
             // Get the two u64 glyph row components to draw for the current fg and bg colors and character row (vlc)
             const auto rows = get_lchar_glyph_rows(cur_char_, crtc_.vlc());
-            const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
-            frame_u64[rba_ >> 3] = rows.first;
-            frame_u64[(rba_ >> 3) + 1] = rows.second;
+            put_pixels(0, rows.first);
+            put_pixels(8, rows.second);
         }
         else {
             // When mode bit is disabled in text mode, the CGA acts like VRAM is all 0.
-            draw_solid_hchar(0);
+            draw_solid_lchar(0);
         }
     }
 
@@ -711,9 +968,8 @@ private:
             uint64_t c0, c1, m0, m1;
             get_lowres_gfx_lchar(crtc_.vlc(), c0, c1, m0, m1);
 
-            const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
-            frame_u64[rba_ >> 3] = c0 | (m0 & CGA_COLORS_U64[cc_alt_color_]);
-            frame_u64[(rba_ >> 3) + 1] = c1 | (m1 & CGA_COLORS_U64[cc_alt_color_]);
+            put_pixels(0, c0 | (m0 & CGA_COLORS_U64[cc_alt_color_]));
+            put_pixels(8, c1 | (m1 & CGA_COLORS_U64[cc_alt_color_]));
         }
         else {
             draw_solid_lchar(cc_alt_color_);
@@ -723,18 +979,17 @@ private:
     /// Draw a single character column in high resolution graphics mode (640x200)
     void draw_hires_gfx_mode_char() {
         auto base_addr = get_gfx_addr(crtc_.vlc());
-        const auto frame_u64 = reinterpret_cast<uint64_t*>(buf_[back_buf_]);
 
         if (mode_enable_) {
             auto byte0 = vram_[base_addr];
             auto byte1 = vram_[base_addr + 1];
 
-            frame_u64[rba_ >> 3] = CGA_HIRES_GFX_TABLE[cc_alt_color_][byte0];
-            frame_u64[(rba_ >> 3) + 1] = CGA_HIRES_GFX_TABLE[cc_alt_color_][byte1];
+            put_pixels(0, CGA_HIRES_GFX_TABLE[cc_alt_color_][byte0]);
+            put_pixels(8, CGA_HIRES_GFX_TABLE[cc_alt_color_][byte1]);
         }
         else {
-            frame_u64[rba_ >> 3] = 0;
-            frame_u64[(rba_ >> 3) + 1] = 0;
+            put_pixels(0, 0);
+            put_pixels(8, 0);
         }
     }
 
@@ -762,6 +1017,7 @@ private:
         scanline_ += 1;
         // Reset beam to left of screen if we haven't already
         if (beam_x_ > 0) {
+            end_line();
             beam_y_++;
         }
         beam_x_ = 0;
@@ -772,6 +1028,7 @@ private:
         // Only do a vsync if we are past the minimum scanline #.
         // A monitor will refuse to vsync too quickly.
         if (beam_y_ > CGA_MONITOR_VSYNC_MIN) {
+            end_line();
             beam_x_ = 0;
             beam_y_ = 0;
             rba_ = 0;
@@ -789,7 +1046,59 @@ private:
         }
     }
 
+    // Record what the beam drew on its scanline, before it leaves it.
+    void end_line() {
+        const uint32_t begin = CGA_XRES_MAX * beam_y_;
+        const uint32_t end = static_cast<uint32_t>(std::min<size_t>(rba_, CGA_MAX_CLOCK));
+        if (beam_x_ == 0 || begin >= end) {
+            return;
+        }
+        // A character drawn across the right edge spills into the next scanline.
+        if (beam_count_ != 0 && beam_extents_[beam_count_ - 1].end >= begin) {
+            beam_extents_[beam_count_ - 1].end = std::max(beam_extents_[beam_count_ - 1].end, end);
+        }
+        else if (beam_count_ < CGA_EXTENTS_MAX) {
+            beam_extents_[beam_count_++] = {begin, end};
+        }
+    }
+
+    // Clear pixels [begin, end) of a frame buffer.
+    void clear_pixels(uint8_t* buffer, const uint32_t begin, const uint32_t end) const {
+        if (frame_format_ == CgaFrameFormat::Packed4) {
+            std::memset(buffer + begin / 2, 0, (end - begin) / 2);
+        }
+        else {
+            std::memset(buffer + begin, 0, end - begin);
+        }
+    }
+
     void swap() {
+        // The back buffer still holds the frame before last wherever the beam didn't reach this frame. Clear what of
+        // that is left, so the frame shown holds only what was drawn, without clearing the whole buffer.
+        uint8_t* buffer = buf_[back_buf_];
+        const auto& old = drawn_extents_[back_buf_];
+        uint32_t b = 0;
+        for (uint32_t i = 0; i < drawn_count_[back_buf_]; ++i) {
+            uint32_t begin = old[i].begin;
+            const uint32_t end = old[i].end;
+            while (begin < end) {
+                while (b < beam_count_ && beam_extents_[b].end <= begin) {
+                    b++;
+                }
+                if (b == beam_count_ || beam_extents_[b].begin >= end) {
+                    clear_pixels(buffer, begin, end);
+                    break;
+                }
+                if (beam_extents_[b].begin > begin) {
+                    clear_pixels(buffer, begin, beam_extents_[b].begin);
+                }
+                begin = beam_extents_[b].end;
+            }
+        }
+        std::copy_n(beam_extents_.begin(), beam_count_, drawn_extents_[back_buf_].begin());
+        drawn_count_[back_buf_] = beam_count_;
+        beam_count_ = 0;
+
         if (back_buf_ == 0) {
             front_buf_ = 0;
             back_buf_ = 1;
@@ -798,7 +1107,5 @@ private:
             front_buf_ = 1;
             back_buf_ = 0;
         }
-        // Clear new back buffer.
-        memset(&buf_[back_buf_], 0, sizeof(buf_[0]));
     }
 };
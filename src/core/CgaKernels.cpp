@@ -0,0 +1,488 @@
+#include "CgaKernels.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CGA_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// Compile a function for a given instruction set, whatever the rest of the file is compiled for. MSVC needs no
+// attribute to use any intrinsic.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CGA_TARGET(isa)
+#define CGA_INLINE __forceinline
+#else
+#define CGA_TARGET(isa) __attribute__((target(isa)))
+#define CGA_INLINE __attribute__((always_inline)) inline
+#endif
+#endif
+
+namespace
+{
+// --- Scalar --------------------------------------------------------------------------------------------------------
+
+uint8_t textForeground(const uint8_t attr) {
+    return attr & 0x0F;
+}
+
+uint8_t textBackground(const uint8_t attr, const CgaTextSpan& span) {
+    return span.blinking ? (attr >> 4) & 0x07 : attr >> 4;
+}
+
+// The glyph row of a cell, or no pixels set if the character is blinking and in its off phase.
+uint8_t glyphBits(const uint8_t* cell, const CgaTextSpan& span) {
+    if (span.blinking && span.blink_off && (cell[1] & 0x80) != 0) {
+        return 0;
+    }
+    return span.font_row[cell[0] * 8];
+}
+
+void textHcharRun(const uint8_t* cells, const size_t count, const CgaTextSpan& span, uint8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* cell = cells + i * 2;
+        const uint8_t bits = glyphBits(cell, span);
+        const uint8_t fg = textForeground(cell[1]);
+        const uint8_t bg = textBackground(cell[1], span);
+        for (int px = 0; px < 8; ++px) {
+            out[i * 8 + px] = (bits & (0x80 >> px)) != 0 ? fg : bg;
+        }
+    }
+}
+
+void textLcharRun(const uint8_t* cells, const size_t count, const CgaTextSpan& span, uint8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* cell = cells + i * 2;
+        const uint8_t bits = glyphBits(cell, span);
+        const uint8_t fg = textForeground(cell[1]);
+        const uint8_t bg = textBackground(cell[1], span);
+        for (int px = 0; px < 16; ++px) {
+            out[i * 16 + px] = (bits & (0x80 >> (px / 2))) != 0 ? fg : bg;
+        }
+    }
+}
+
+void gfx1bppRun(const uint8_t* bytes, const size_t count, const uint8_t color, uint8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        for (int px = 0; px < 8; ++px) {
+            out[i * 8 + px] = (bytes[i] & (0x80 >> px)) != 0 ? color : 0;
+        }
+    }
+}
+
+void gfx2bppRun(const uint8_t* bytes, const size_t count, const uint8_t* colors, uint8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        for (int px = 0; px < 8; ++px) {
+            out[i * 8 + px] = colors[(bytes[i] >> (6 - (px / 2) * 2)) & 0x03];
+        }
+    }
+}
+
+void pack4bppRun(const uint8_t* pixels, const size_t count, uint8_t* out) {
+    for (size_t i = 0; i < count; i += 8) {
+        uint64_t eight;
+        std::memcpy(&eight, pixels + i, sizeof(eight));
+        const uint32_t packed = packCgaPixels(eight);
+        std::memcpy(out + i / 2, &packed, sizeof(packed));
+    }
+}
+
+// A text kernel from a function that draws the characters: draw them, then the cursor over them.
+template <void (*Run)(const uint8_t*, size_t, const CgaTextSpan&, uint8_t*), size_t Width>
+void textKernel(const uint8_t* cells, const size_t count, const CgaTextSpan& span, uint8_t* out) {
+    Run(cells, count, span, out);
+    if (span.cursor < count) {
+        std::memset(out + span.cursor * Width, textForeground(cells[span.cursor * 2 + 1]), 8);
+        std::memset(out + span.cursor * Width + 8, 0, Width - 8);
+    }
+}
+
+constexpr CgaKernels kScalarKernels{
+    "scalar",
+    textKernel<textHcharRun, 8>,
+    textKernel<textLcharRun, 16>,
+    gfx1bppRun,
+    gfx2bppRun,
+    pack4bppRun,
+};
+
+#ifdef CGA_KERNELS_X86
+
+// Bit of each pixel of a glyph byte, the first pixel in the most significant bit, and the same with each pixel doubled.
+constexpr std::array<uint8_t, 32> kPixelBits = {
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+};
+constexpr std::array<uint8_t, 32> kDoubledPixelBits = {
+    0x80, 0x80, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10, 0x08, 0x08, 0x04, 0x04, 0x02, 0x02, 0x01, 0x01,
+    0x80, 0x80, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10, 0x08, 0x08, 0x04, 0x04, 0x02, 0x02, 0x01, 0x01,
+};
+// The high and low bit of each doubled 2 bpp pixel.
+constexpr std::array<uint8_t, 32> kPairHighBits = {
+    0x80, 0x80, 0x20, 0x20, 0x08, 0x08, 0x02, 0x02, 0x80, 0x80, 0x20, 0x20, 0x08, 0x08, 0x02, 0x02,
+    0x80, 0x80, 0x20, 0x20, 0x08, 0x08, 0x02, 0x02, 0x80, 0x80, 0x20, 0x20, 0x08, 0x08, 0x02, 0x02,
+};
+constexpr std::array<uint8_t, 32> kPairLowBits = {
+    0x40, 0x40, 0x10, 0x10, 0x04, 0x04, 0x01, 0x01, 0x40, 0x40, 0x10, 0x10, 0x04, 0x04, 0x01, 0x01,
+    0x40, 0x40, 0x10, 0x10, 0x04, 0x04, 0x01, 0x01, 0x40, 0x40, 0x10, 0x10, 0x04, 0x04, 0x01, 0x01,
+};
+
+// AVX2 byte shuffles that spread 16 source bytes, broadcast to both lanes, over the output: shuffle k of the 8-wide
+// set gives bytes 4k and 4k + 1 eight times each in the low lane and bytes 4k + 2 and 4k + 3 in the high lane; shuffle
+// k of the 16-wide set gives byte 2k sixteen times in the low lane and byte 2k + 1 in the high lane.
+constexpr std::array<std::array<uint8_t, 32>, 4> makeSpread8() {
+    std::array<std::array<uint8_t, 32>, 4> table{};
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t i = 0; i < 32; ++i) {
+            table[k][i] = static_cast<uint8_t>(k * 4 + i / 8);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<uint8_t, 32>, 8> makeSpread16() {
+    std::array<std::array<uint8_t, 32>, 8> table{};
+    for (size_t k = 0; k < 8; ++k) {
+        for (size_t i = 0; i < 32; ++i) {
+            table[k][i] = static_cast<uint8_t>(k * 2 + i / 16);
+        }
+    }
+    return table;
+}
+
+alignas(32) constexpr auto kSpread8 = makeSpread8();
+alignas(32) constexpr auto kSpread16 = makeSpread16();
+
+// --- SSE2 ----------------------------------------------------------------------------------------------------------
+// Part of x86-64, so these need no target attribute. The helpers are forced inline: the AVX2 kernels use them too, and
+// a call from AVX2 code into SSE code can cost a state transition on every call.
+
+// Glyph rows, foreground and background colors of 16 cells.
+struct TextVectors
+{
+    __m128i glyphs;
+    __m128i fg;
+    __m128i bg;
+};
+
+CGA_INLINE TextVectors loadText16(const uint8_t* cells, const CgaTextSpan& span) {
+    // The glyph rows are a table lookup per character; the attributes decode in parallel.
+    alignas(16) uint8_t glyphs[16];
+    for (size_t i = 0; i < 16; ++i) {
+        glyphs[i] = span.font_row[cells[i * 2] * 8];
+    }
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + 16));
+    const __m128i attrs = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+
+    const __m128i blink_bit = _mm_set1_epi8(span.blinking && span.blink_off ? static_cast<char>(0x80) : 0);
+    const __m128i visible = _mm_cmpeq_epi8(_mm_and_si128(attrs, blink_bit), _mm_setzero_si128());
+    return {
+        _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(glyphs)), visible),
+        _mm_and_si128(attrs, _mm_set1_epi8(0x0F)),
+        _mm_and_si128(_mm_srli_epi16(attrs, 4), _mm_set1_epi8(span.blinking ? 0x07 : 0x0F)),
+    };
+}
+
+// Repeat each of the 16 bytes of v 8 times, over 8 vectors.
+CGA_INLINE void spread8(const __m128i v, __m128i (&out)[8]) {
+    const __m128i b[2] = {_mm_unpacklo_epi8(v, v), _mm_unpackhi_epi8(v, v)};
+    for (int i = 0; i < 2; ++i) {
+        const __m128i w0 = _mm_unpacklo_epi16(b[i], b[i]);
+        const __m128i w1 = _mm_unpackhi_epi16(b[i], b[i]);
+        out[i * 4 + 0] = _mm_unpacklo_epi32(w0, w0);
+        out[i * 4 + 1] = _mm_unpackhi_epi32(w0, w0);
+        out[i * 4 + 2] = _mm_unpacklo_epi32(w1, w1);
+        out[i * 4 + 3] = _mm_unpackhi_epi32(w1, w1);
+    }
+}
+
+// Pick fg where bits is set in glyphs and bg elsewhere.
+CGA_INLINE __m128i selectPixels(const __m128i glyphs, const __m128i bits, const __m128i fg, const __m128i bg) {
+    const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(glyphs, bits), bits);
+    return _mm_or_si128(_mm_and_si128(set, fg), _mm_andnot_si128(set, bg));
+}
+
+void textHcharSse2(const uint8_t* cells, const size_t count, const CgaTextSpan& span, uint8_t* out) {
+    const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kPixelBits.data()));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const TextVectors text = loadText16(cells + i * 2, span);
+        __m128i glyphs[8], fg[8], bg[8];
+        spread8(text.glyphs, glyphs);
+        spread8(text.fg, fg);
+        spread8(text.bg, bg);
+        for (int k = 0; k < 8; ++k) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8 + k * 16),
+                             selectPixels(glyphs[k], bits, fg[k], bg[k]));
+        }
+    }
+    textHcharRun(cells + i * 2, count - i, span, out + i * 8);
+}
+
+void textLcharSse2(const uint8_t* cells, const size_t count, const CgaTextSpan& span, uint8_t* out) {
+    const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDoubledPixelBits.data()));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const TextVectors text = loadText16(cells + i * 2, span);
+        __m128i glyphs[8], fg[8], bg[8];
+        spread8(text.glyphs, glyphs);
+        spread8(text.fg, fg);
+        spread8(text.bg, bg);
+        for (int k = 0; k < 8; ++k) {
+            // Each vector holds two characters 8 times over; widen each to 16.
+            uint8_t* dst = out + i * 16 + k * 32;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                             selectPixels(_mm_unpacklo_epi64(glyphs[k], glyphs[k]), bits,
+                                          _mm_unpacklo_epi64(fg[k], fg[k]), _mm_unpacklo_epi64(bg[k], bg[k])));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16),
+                             selectPixels(_mm_unpackhi_epi64(glyphs[k], glyphs[k]), bits,
+                                          _mm_unpackhi_epi64(fg[k], fg[k]), _mm_unpackhi_epi64(bg[k], bg[k])));
+        }
+    }
+    textLcharRun(cells + i * 2, count - i, span, out + i * 16);
+}
+
+void gfx1bppSse2(const uint8_t* bytes, const size_t count, const uint8_t color, uint8_t* out) {
+    const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kPixelBits.data()));
+    const __m128i fg = _mm_set1_epi8(static_cast<char>(color));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i spread[8];
+        spread8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)), spread);
+        for (int k = 0; k < 8; ++k) {
+            const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(spread[k], bits), bits);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8 + k * 16), _mm_and_si128(set, fg));
+        }
+    }
+    gfx1bppRun(bytes + i, count - i, color, out + i * 8);
+}
+
+void gfx2bppSse2(const uint8_t* bytes, const size_t count, const uint8_t* colors, uint8_t* out) {
+    const __m128i high_bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kPairHighBits.data()));
+    const __m128i low_bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kPairLowBits.data()));
+    __m128i c[4];
+    for (int n = 0; n < 4; ++n) {
+        c[n] = _mm_set1_epi8(static_cast<char>(colors[n]));
+    }
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i spread[8];
+        spread8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)), spread);
+        for (int k = 0; k < 8; ++k) {
+            // No byte shuffle in SSE2, so select among the four colors by the two bits of each pixel.
+            const __m128i hi = _mm_cmpeq_epi8(_mm_and_si128(spread[k], high_bits), high_bits);
+            const __m128i lo = _mm_cmpeq_epi8(_mm_and_si128(spread[k], low_bits), low_bits);
+            const __m128i px3 = _mm_and_si128(_mm_and_si128(hi, lo), c[3]);
+            const __m128i px2 = _mm_and_si128(_mm_andnot_si128(lo, hi), c[2]);
+            const __m128i px1 = _mm_and_si128(_mm_andnot_si128(hi, lo), c[1]);
+            const __m128i px0 = _mm_andnot_si128(_mm_or_si128(hi, lo), c[0]);
+            const __m128i px = _mm_or_si128(_mm_or_si128(px3, px2), _mm_or_si128(px1, px0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8 + k * 16), px);
+        }
+    }
+    gfx2bppRun(bytes + i, count - i, colors, out + i * 8);
+}
+
+void pack4bppSse2(const uint8_t* pixels, const size_t count, uint8_t* out) {
+    const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        // In each 16-bit pair of pixels, fold the right pixel into the high nibble of the left one.
+        __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i)), low_nibbles);
+        __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i + 16)), low_nibbles);
+        a = _mm_and_si128(_mm_or_si128(a, _mm_srli_epi16(a, 4)), low_bytes);
+        b = _mm_and_si128(_mm_or_si128(b, _mm_srli_epi16(b, 4)), low_bytes);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(a, b));
+    }
+    pack4bppRun(pixels + i, count - i, out + i / 2);
+}
+
+constexpr CgaKernels kSse2Kernels{
+    "sse2",
+    textKernel<textHcharSse2, 8>,
+    textKernel<textLcharSse2, 16>,
+    gfx1bppSse2,
+    gfx2bppSse2,
+    pack4bppSse2,
+};
+
+// --- AVX2 ----------------------------------------------------------------------------------------------------------
+
+CGA_TARGET("avx2") __m256i load256(const uint8_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+CGA_TARGET("avx2") __m256i selectPixels256(const __m256i glyphs, const __m256i bits, const __m256i fg,
+                                           const __m256i bg) {
+    const __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(glyphs, bits), bits);
+    return _mm256_blendv_epi8(bg, fg, set);
+}
+
+CGA_TARGET("avx2") void textHcharAvx2(const uint8_t* cells, const size_t count, const CgaTextSpan& span,
+                                      uint8_t* out) {
+    const __m256i bits = load256(kPixelBits.data());
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const TextVectors text = loadText16(cells + i * 2, span);
+        const __m256i glyphs = _mm256_broadcastsi128_si256(text.glyphs);
+        const __m256i fg = _mm256_broadcastsi128_si256(text.fg);
+        const __m256i bg = _mm256_broadcastsi128_si256(text.bg);
+        for (size_t k = 0; k < 4; ++k) {
+            const __m256i spread = load256(kSpread8[k].data());
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8 + k * 32),
+                                selectPixels256(_mm256_shuffle_epi8(glyphs, spread), bits,
+                                                _mm256_shuffle_epi8(fg, spread), _mm256_shuffle_epi8(bg, spread)));
+        }
+    }
+    textHcharRun(cells + i * 2, count - i, span, out + i * 8);
+}
+
+CGA_TARGET("avx2") void textLcharAvx2(const uint8_t* cells, const size_t count, const CgaTextSpan& span,
+                                      uint8_t* out) {
+    const __m256i bits = load256(kDoubledPixelBits.data());
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const TextVectors text = loadText16(cells + i * 2, span);
+        const __m256i glyphs = _mm256_broadcastsi128_si256(text.glyphs);
+        const __m256i fg = _mm256_broadcastsi128_si256(text.fg);
+        const __m256i bg = _mm256_broadcastsi128_si256(text.bg);
+        for (size_t k = 0; k < 8; ++k) {
+            const __m256i spread = load256(kSpread16[k].data());
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 16 + k * 32),
+                                selectPixels256(_mm256_shuffle_epi8(glyphs, spread), bits,
+                                                _mm256_shuffle_epi8(fg, spread), _mm256_shuffle_epi8(bg, spread)));
+        }
+    }
+    textLcharRun(cells + i * 2, count - i, span, out + i * 16);
+}
+
+CGA_TARGET("avx2") void gfx1bppAvx2(const uint8_t* bytes, const size_t count, const uint8_t color, uint8_t* out) {
+    const __m256i bits = load256(kPixelBits.data());
+    const __m256i fg = _mm256_set1_epi8(static_cast<char>(color));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i data =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+        for (size_t k = 0; k < 4; ++k) {
+            const __m256i spread = _mm256_shuffle_epi8(data, load256(kSpread8[k].data()));
+            const __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(spread, bits), bits);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8 + k * 32), _mm256_and_si256(set, fg));
+        }
+    }
+    gfx1bppRun(bytes + i, count - i, color, out + i * 8);
+}
+
+CGA_TARGET("avx2") void gfx2bppAvx2(const uint8_t* bytes, const size_t count, const uint8_t* colors, uint8_t* out) {
+    const __m256i high_bits = load256(kPairHighBits.data());
+    const __m256i low_bits = load256(kPairLowBits.data());
+    // The four colors in the first bytes of each lane, to be looked up by a byte shuffle.
+    uint32_t palette_word;
+    std::memcpy(&palette_word, colors, sizeof(palette_word));
+    const __m256i palette = _mm256_set1_epi32(static_cast<int>(palette_word));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i data =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+        for (size_t k = 0; k < 4; ++k) {
+            const __m256i spread = _mm256_shuffle_epi8(data, load256(kSpread8[k].data()));
+            const __m256i hi = _mm256_cmpeq_epi8(_mm256_and_si256(spread, high_bits), high_bits);
+            const __m256i lo = _mm256_cmpeq_epi8(_mm256_and_si256(spread, low_bits), low_bits);
+            const __m256i index = _mm256_or_si256(_mm256_and_si256(hi, _mm256_set1_epi8(2)),
+                                                  _mm256_and_si256(lo, _mm256_set1_epi8(1)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8 + k * 32),
+                                _mm256_shuffle_epi8(palette, index));
+        }
+    }
+    gfx2bppRun(bytes + i, count - i, colors, out + i * 8);
+}
+
+CGA_TARGET("avx2") void pack4bppAvx2(const uint8_t* pixels, const size_t count, uint8_t* out) {
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        __m256i a = _mm256_and_si256(load256(pixels + i), low_nibbles);
+        __m256i b = _mm256_and_si256(load256(pixels + i + 32), low_nibbles);
+        a = _mm256_and_si256(_mm256_or_si256(a, _mm256_srli_epi16(a, 4)), low_bytes);
+        b = _mm256_and_si256(_mm256_or_si256(b, _mm256_srli_epi16(b, 4)), low_bytes);
+        // The pack works within lanes; put the quarters back in order.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0b11'01'10'00);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), packed);
+    }
+    pack4bppSse2(pixels + i, count - i, out + i / 2);
+}
+
+constexpr CgaKernels kAvx2Kernels{
+    "avx2",
+    textKernel<textHcharAvx2, 8>,
+    textKernel<textLcharAvx2, 16>,
+    gfx1bppAvx2,
+    gfx2bppAvx2,
+    pack4bppAvx2,
+};
+
+bool hostHasAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The CPU must have AVX and the OS must save the YMM registers, as well as the CPU having AVX2.
+    __cpuid(info, 1);
+    constexpr int kOsxsave = 1 << 27;
+    constexpr int kAvx = 1 << 28;
+    if ((info[2] & (kOsxsave | kAvx)) != (kOsxsave | kAvx) || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // CGA_KERNELS_X86
+}
+
+bool cgaKernelLevelSupported(const CgaKernelLevel level) {
+    switch (level) {
+        case CgaKernelLevel::Scalar:
+            return true;
+#ifdef CGA_KERNELS_X86
+        case CgaKernelLevel::Sse2:
+            return true; // Part of x86-64
+        case CgaKernelLevel::Avx2:
+        {
+            static const bool has_avx2 = hostHasAvx2();
+            return has_avx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+const CgaKernels& cgaKernels(const CgaKernelLevel level) {
+    switch (level) {
+#ifdef CGA_KERNELS_X86
+        case CgaKernelLevel::Sse2:
+            return kSse2Kernels;
+        case CgaKernelLevel::Avx2:
+            return kAvx2Kernels;
+#endif
+        default:
+            return kScalarKernels;
+    }
+}
+
+const CgaKernels& cgaKernels() {
+    static const CgaKernels& best = cgaKernels(
+        cgaKernelLevelSupported(CgaKernelLevel::Avx2) ? CgaKernelLevel::Avx2 :
+        cgaKernelLevelSupported(CgaKernelLevel::Sse2) ? CgaKernelLevel::Sse2 : CgaKernelLevel::Scalar);
+    return best;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Span kernels for the CGA rasterizer. Each expands a run of characters or graphics bytes on one scanline into
+// palette indices, one byte per pixel, in a single pass, and pack_4bpp converts pixels to the packed frame buffer
+// layout. Every kernel has a scalar version and, on x86-64, SSE2 and AVX2 versions; all of them give the same result.
+// cgaKernels() picks the fastest one the host supports.
+
+enum class CgaKernelLevel : uint8_t
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// How a span of text is drawn.
+struct CgaTextSpan
+{
+    static constexpr size_t kNoCursor = SIZE_MAX;
+
+    const uint8_t* font_row; // The scanline's row of each glyph: glyph g's row is font_row[g * 8]
+    bool blinking; // Attribute bit 7 blinks the character rather than brightening the background
+    bool blink_off; // Blinking characters are in their off phase, and draw as background
+    // Index of the character under the cursor, or kNoCursor. The cursor covers the first 8 pixels of its character
+    // in its foreground color, in both text widths; the rest of a 40 column character is color 0.
+    size_t cursor;
+};
+
+struct CgaKernels
+{
+    const char* name;
+    // Expand count character/attribute pairs to 8 pixels each (80 column text).
+    void (*text_hchar)(const uint8_t* cells, size_t count, const CgaTextSpan& span, uint8_t* out);
+    // Expand count character/attribute pairs to 16 pixels each, every glyph pixel doubled (40 column text).
+    void (*text_lchar)(const uint8_t* cells, size_t count, const CgaTextSpan& span, uint8_t* out);
+    // Expand count bytes of 1 bpp graphics to 8 pixels each: color for set bits, 0 for clear ones (640x200).
+    void (*gfx_1bpp)(const uint8_t* bytes, size_t count, uint8_t color, uint8_t* out);
+    // Expand count bytes of 2 bpp graphics to 4 pixels each, doubled, through colors[0..3] (320x200).
+    void (*gfx_2bpp)(const uint8_t* bytes, size_t count, const uint8_t* colors, uint8_t* out);
+    // Pack count pixels, count a multiple of 8, two to a byte, the left one in the low nibble.
+    void (*pack_4bpp)(const uint8_t* pixels, size_t count, uint8_t* out);
+};
+
+// Pack 8 pixels, one in each byte of pixels from the low byte up, as pack_4bpp does.
+constexpr uint32_t packCgaPixels(uint64_t pixels) {
+    pixels &= 0x0F0F0F0F0F0F0F0Full;
+    pixels = (pixels | pixels >> 4) & 0x00FF00FF00FF00FFull;
+    pixels = (pixels | pixels >> 8) & 0x0000FFFF0000FFFFull;
+    return static_cast<uint32_t>(pixels | pixels >> 16);
+}
+
+[[nodiscard]] bool cgaKernelLevelSupported(CgaKernelLevel level);
+// The kernels of a level. The level must be supported by the host.
+[[nodiscard]] const CgaKernels& cgaKernels(CgaKernelLevel level);
+// The fastest kernels the host supports, chosen on the first call.
+[[nodiscard]] const CgaKernels& cgaKernels();
@@ -1,22 +1,51 @@
 #ifndef CPU_H
 #define CPU_H
 
+#include <cassert>
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <format>
+#include <array>
+#include <utility>
 #include <SDL3/SDL_log.h>
 #include <deque>
+#include <memory>
 
 #include "../xtce_blue.h"
 #include "Bus.h"
+#include "LoopDetector.h"
+#include "RepFastPath.h"
 #include "SnifferDecoder.h"
 
-#include "microcode.h"
+#include "MicrocodeTablesData.h"
 #include "cpu_types.h"
 
-#define LINE_ENDING_SIZE 1
-#define DEBUG_MC 1
+// Instrumentation policies for the cycle loop.
+// The policy is a template parameter of run_for() and stepToNextInstruction() rather than of Cpu itself, so one Cpu
+// (and the Bus it owns) can be driven by either instantiation, switching between calls without copying any state.
+// The flags are tested with a plain if (the core sticks to C++11); they are constants, so the dead side folds away.
+struct DebugPolicy
+{
+    static constexpr bool kCycleLog = true; // Bus sniffer updates and the cycle log
+    static constexpr bool kBreakpoints = true; // Per-cycle breakpoint checks
+    static constexpr bool kHistory = true; // Instruction history for the debugger
+    static constexpr bool kChecks = true; // Internal consistency checks
+    static constexpr bool kFastForward = false; // Skip idle stretches (HLT) in bulk instead of cycle by cycle
+};
+
+struct FastPolicy
+{
+    static constexpr bool kCycleLog = false;
+    static constexpr bool kBreakpoints = false;
+    static constexpr bool kHistory = false;
+    static constexpr bool kChecks = false;
+    static constexpr bool kFastForward = true;
+};
+
+// How the EU executes microcode. Both engines are cycle-exact and produce the same cycle log. Specialized runs a step
+// function compiled for each ROM word instead of decoding the word every cycle.
+enum class MicrocodeEngine { Interpreter, Specialized };
 
 template <typename BusType = Bus, typename WordT = uint8_t, std::size_t QueueLen = 4>
 class Cpu
@@ -30,39 +59,6 @@ class Cpu
         );
     static_assert(QueueLen > 0, "QueueLen must be > 0");
 
-    enum GroupDecodeFlags
-    {
-        // The original 15 outputs of the Group decode PLA
-        groupMemory = 1, // This signal controls the M/IO (S2) status line
-        groupInitialEARead = 2, // This signal indicates that the effective address is read by the instruction.
-        groupMicrocodePointerFromOpcode = 4, // Group 3/4/5 opcode - microcode address will be determined by ModR/M.
-        groupNonPrefix = 8, // This line controls whether the instruction is a prefix or not.
-        groupEffectiveAddress = 0x10, // This signal indicates whether the instruction has a ModR/M byte.
-        groupAddSubBooleanRotate = 0x20, // This signal specifies the top bit for an ALU operation.
-        groupNonFlagSet = 0x40, // This signal determines whether the instruction directly updates flags (not CMC).
-        groupMNotAccumulator = 0x80, // This signal controls whether the instruction uses the AL or AX register for M.
-        groupNonSegregEA = 0x100, // This signal controls whether an instruction indexes a segment register.
-        groupNoDirectionBit = 0x200, // This signal controls whether an opcode encodes a direction bit.
-        groupMicrocoded = 0x400, // This signal indicates whether the instruction is microcoded or not.
-        groupNoWidthInOpcodeBit0 = 0x800, // This signal indicates whether the opcode encodes width in bit 0
-        groupByteOrWordAccess = 0x1000, // This signal indicates whether the instruction accesses byte or word data.
-        groupF1ZZFromPrefix = 0x2000,
-        groupIncDec = 0x4000, // This signal indicates whether carry is allowed to be updated.
-
-        // Direct column outputs
-        groupLoadRegisterImmediate = 0x10000,
-        groupWidthInOpcodeBit3 = 0x20000,
-        groupCMC = 0x40000,
-        groupHLT = 0x80000,
-        groupREP = 0x100000,
-        groupSegmentOverride = 0x200000,
-        groupLOCK = 0x400000,
-        groupCLI = 0x800000,
-
-        // This is not part of the PLA outputs, but we derive it here for convenience
-        groupLoadSegmentRegister = 0x1000000,
-    };
-
 public:
     enum class RunResult { Ok, Halt, BreakpointHit, OffRails };
 
@@ -101,14 +97,14 @@ public:
 
     // Default constructor: default-construct the bus and initialize CPU state
     Cpu() :
-        _consoleLogging(false), _bus() {
+        _bus() {
         initializeCommon();
     }
 
     // Forwarding constructor: allow callers to construct CpuT with arguments forwarded to BusType's constructor.
     template <typename... Args>
     explicit Cpu(Args&&... args) :
-        _consoleLogging(false), _bus(std::forward<Args>(args)...) {
+        _bus(std::forward<Args>(args)...) {
         initializeCommon();
     }
 
@@ -134,13 +130,26 @@ public:
 
     bool isLogInstructions() const { return _log_instructions; }
 
+    void setMicrocodeEngine(const MicrocodeEngine engine) { _microcodeEngine = engine; }
+    MicrocodeEngine getMicrocodeEngine() const { return _microcodeEngine; }
+
+    // REP MOVS/STOS/LODS batching. Only the fast policy batches; Verify steps each batch and checks it instead.
+    void setRepFastPathMode(const RepFastPathMode mode) { _repFastPath.setMode(mode); }
+    RepFastPathMode getRepFastPathMode() const { return _repFastPath.mode(); }
+    const RepFastPathStats& getRepFastPathStats() const { return _repFastPath.stats(); }
+
+    // Busy-wait loop skipping. Only the fast policy skips; Verify steps each skip and checks it instead.
+    void setLoopSkipMode(const LoopSkipMode mode) { _loopDetector.setMode(mode); }
+    LoopSkipMode getLoopSkipMode() const { return _loopDetector.mode(); }
+    const LoopSkipStats& getLoopSkipStats() const { return _loopDetector.stats(); }
+
     void setOffRailsDetection(const bool state, int badOpcodeCt = OFF_RAILS_CT) {
         _off_rails_detection = state;
         _bad_opcode_ct = badOpcodeCt;
     }
 
     std::vector<InstructionHistoryEntry> getHistory(size_t lines) {
-        return _history.getLast(lines);
+        return _debug->history.getLast(lines);
     }
 
     uint16_t getInstructionPointer() const {
@@ -153,7 +162,7 @@ public:
     std::string log() const {
         // Assemble buffered lines into a single string on request
         std::string out;
-        for (const auto& s : _logBuffer) {
+        for (const auto& s : _debug->logBuffer) {
             out += s;
         }
         return out;
@@ -174,16 +183,14 @@ public:
         _microcodePointer = 0x1800;
         _busState = tIdle;
         _ioType = ioPassive;
-        _snifferDecoder.reset();
+        _debug->sniffer.reset();
         _prefetching = true;
-        _logBuffer.clear();
+        _debug->logBuffer.clear();
         pc() = 0;
         _nmiRequested = false;
         _alu = 0;
         _aluInput = 0;
-        _queueBytes = 0;
-        _queue = 0;
-        _newQueue = {};
+        _queue.clear();
         _segmentOverride = -1;
         _f1 = false;
         _repne = false;
@@ -191,7 +198,6 @@ public:
         _loaderState = 0;
         _read_prefix = false;
         _lastMicrocodePointer = -1;
-        _dequeueing = false;
         _ioCancelling = 0;
         _ioRequested = false;
         _t4 = false;
@@ -200,6 +206,8 @@ public:
         _lastIOType = ioPassive;
         _t5 = false;
         _interruptPending = false;
+        _extraHaltDelay = false;
+        _savedAddress = 0;
         _ready = true;
         //_cyclesUntilCanLowerQueueFilled = 0;
         _locking = false;
@@ -217,51 +225,166 @@ public:
 
         // Instruction tracking
         _inst_address = 0;
-        _history.clear();
+        _debug->history.clear();
+        _repFastPath.reset();
+        _loopDetector.reset();
 
         _bad_opcode_ct = 0;
         _off_rails = false;
     }
 
+    // Save or load the CPU and, through it, the bus and devices (see SaveState.h). This covers everything the next
+    // cycle depends on: registers, the microcode sequencer, the bus state machine and the prefetch queue. Debugger,
+    // logging and fast forwarding state is left out; the fast forwarding caches start over after a load.
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar.section("CPU ", [&] {
+            ar(_registers);
+            _queue.serialize(ar);
+            ar(_cycle);
+            ar(_ioAddress);
+            ar(_group);
+            ar(_nextGroup);
+            ar(_savedAddress);
+            ar(_busState);
+            ar(_state);
+            ar(_ioType);
+            ar(_lastIOType);
+            ar(_ioSegment);
+            ar(_counter);
+            ar(_segmentOverride);
+            ar(_aluInput);
+            ar(_loaderState);
+            ar(_source);
+            ar(_destination);
+            ar(_type);
+            ar(_segment);
+            ar(_lastMicrocodePointer);
+            ar(_ioCancelling);
+            ar(_ioIndex);
+            ar(_microcodePointer);
+            ar(_nextMicrocodePointer);
+            ar(_microcodeReturn);
+            ar(_inst_address);
+            ar(_ioReadData);
+            ar(_ioWriteData);
+            ar(_alu);
+            ar(_opcode);
+            ar(_modRM);
+            ar(_nextModRM);
+            ar(_operands);
+            ar(_parity);
+            ar(_carry);
+            ar(_carryLatch);
+            ar(_zero);
+            ar(_superZero);
+            ar(_auxiliary);
+            ar(_sign);
+            ar(_overflow);
+            ar(_f1);
+            ar(_repne);
+            ar(_lock);
+            ar(_prefetching);
+            ar(_rni);
+            ar(_in_instruction);
+            ar(_nx);
+            ar(_updateFlags);
+            ar(_mIsM);
+            ar(_skipRNI);
+            ar(_useMemory);
+            ar(_read_prefix);
+            ar(_wordSize);
+            ar(_ioRequested);
+            ar(_t4);
+            ar(_t5);
+            ar(_t6);
+            ar(_prefetchDelayed);
+            ar(_queueFlushing);
+            ar(_queueFilled);
+            ar(_interruptPending);
+            ar(_extraHaltDelay);
+            ar(_ready);
+            ar(_locking);
+            ar(_nmiRequested);
+            ar(_bad_opcode_ct);
+            if (Archive::kLoading) {
+                // Only run_for() and stepToNextInstruction() look at this, and they clear it first.
+                _inst_boundary = false;
+            }
+        });
+        _bus.serialize(ar);
+        if (Archive::kLoading) {
+            _repFastPath.reset();
+            _loopDetector.reset();
+        }
+    }
+
+    template <typename Policy = DebugPolicy>
     RunResult run_for(const int cycleCt) {
 
         _inst_boundary = false;
-        sanity_check();
+        if (Policy::kChecks) {
+            sanity_check();
+        }
         // Clear the breakpoint status if we're being asked to run again
         _breakpointHit = false;
         _off_rails = false;
+        // Devices may have been poked between calls, so batches and loops are only found within one call.
+        _repFastPath.reset();
+        _loopDetector.reset();
 
         for (int i = 0; i < cycleCt; i++) {
-            simulateCycle();
+            if (Policy::kFastForward) {
+                if (isIdleHalted() && !interruptPending()) {
+                    i += fastForwardHalt(cycleCt - i) - 1;
+                    continue;
+                }
+            }
+            simulateCycle<Policy>();
 
-            // If we've reached an instruction boundary this cycle, check the breakpoint
-            if (_inst_boundary) {
-                _inst_boundary = false;
-                if (_hasBreakpoint) {
-                    uint16_t realIP = getRealIP();
-                    if (cs() == _breakpoint_cs && realIP == _breakpoint_ip) {
-                        _breakpointHit = true;
-                        return RunResult::BreakpointHit;
+            if (Policy::kFastForward) {
+                if (_f1 && _repFastPath.mode() != RepFastPathMode::Off && atRepLoopHead()) {
+                    i += repBatch(cycleCt - i - 1);
+                }
+                // The fast policies don't check breakpoints, so the boundary is the loop detector's to clear.
+                if (_inst_boundary) {
+                    _inst_boundary = false;
+                    if (_loopDetector.mode() != LoopSkipMode::Off) {
+                        i += skipLoop(cycleCt - i - 1);
                     }
                 }
             }
 
-            if (_breakpointHit) {
-                // Stop executing further cycles if a breakpoint was hit by other means
-                return RunResult::BreakpointHit;
+            if (Policy::kBreakpoints) {
+                // If we've reached an instruction boundary this cycle, check the breakpoint
+                if (_inst_boundary) {
+                    _inst_boundary = false;
+                    if (_hasBreakpoint) {
+                        uint16_t realIP = getRealIP();
+                        if (cs() == _breakpoint_cs && realIP == _breakpoint_ip) {
+                            _breakpointHit = true;
+                            return RunResult::BreakpointHit;
+                        }
+                    }
+                }
+
+                if (_breakpointHit) {
+                    // Stop executing further cycles if a breakpoint was hit by other means
+                    return RunResult::BreakpointHit;
+                }
             }
 
+            // Under every policy, so a runaway CPU stops on the instruction that was detected.
             if (_off_rails) {
                 return RunResult::OffRails;
             }
         }
-
         return RunResult::Ok;
     }
 
     void run() {
         do {
-            simulateCycle();
+            simulateCycle<DebugPolicy>();
         }
         while ((getRealIP() != _stopIP + 2 || cs() != _stopSeg) && _cycle < _executeEndCycle);
     }
@@ -272,17 +395,20 @@ public:
 
     // Run CPU cycles until the next instruction boundary is reached.
     // Returns the number of CPU cycles executed.
+    template <typename Policy = DebugPolicy>
     int stepToNextInstruction() {
         _inst_boundary = false;
+        _repFastPath.reset();
+        _loopDetector.reset();
         int cycles = 0;
         // if _rni is true, clear it first by cycling the CPU until it becomes false.
         while (_rni && _state != stateHalted) {
-            simulateCycle();
+            simulateCycle<Policy>();
         }
         //_rni = false;
         // Run cycles until _rni becomes true or the CPU halts.
         while (!_inst_boundary && _state != stateHalted) {
-            simulateCycle();
+            simulateCycle<Policy>();
             ++cycles;
             // Prevent infinite loop in funky situations by limiting cycles
             if (cycles > 1000000) {
@@ -301,7 +427,7 @@ public:
     }
 
     uint16_t getRealIP() {
-        return pc() - _queueBytes;
+        return pc() - _queue.size();
     }
 
     void setTestNumber(uint32_t n) {
@@ -356,6 +482,12 @@ private:
 
     }
 
+    // Decoded microcode ROM and PLA tables. These are immutable and shared by every Cpu instance; see
+    // MicrocodeTables.h.
+    static constexpr const MicrocodeTables& tables() {
+        return std::is_same<WordT, uint16_t>::value ? MicrocodeTableData<>::k8086 : MicrocodeTableData<>::k8088;
+    }
+
     // Extracted common initialization logic so we can reuse it in all constructors.
     void initializeCommon() {
         _logStartCycle = 0;
@@ -366,304 +498,6 @@ private:
         _registers[21] = 0xffff;
         _registers[23] = 0;
 
-        std::cout << "CPU initializing." << std::endl;
-
-        // Initialize the microcode data and put it in a format more suitable for interpreting
-
-        // Select 8086 based on template WordT parameter.
-        static const bool use8086 = std::is_same<WordT, uint16_t>::value;
-
-        // Initialize an array to hold the 512 21-bit microcode instruction words.
-        uint32_t instructions[512];
-        for (unsigned int& instruction : instructions) {
-            instruction = 0;
-        }
-
-        // Load the main microcode ROM
-        // Iterate through 84 rows of microcode data.
-        for (int y = 0; y < 84; ++y) {
-            // Iterate through left and right columns.
-            for (int half = 0; half < 2; ++half) {
-                std::string filename = (half == 1 ? "l" : "r");
-                filename += (use8086 ? "a" : "");
-                std::string_view s = get_file(filename);
-                // Iterate through the width of the ROM block (64).
-                for (int x = 0; x < 64; ++x) {
-                    int b = s[y * (64 + LINE_ENDING_SIZE) + (63 - x)] == '0' ? 1 : 0;
-                    instructions[x * 8 + half * 4 + y % 4] |= (b << (20 - (y >> 2)));
-                }
-            }
-        }
-
-        for (int i = 0; i < 512; ++i) {
-            int w = instructions[i];
-#if DEBUG_MC
-            std::cout << std::format("{:03X}: {:021b}\n", i, static_cast<unsigned int>(w));
-#endif
-
-            // The microcode word is somewhat scrambled compared to the word layout diagram you may have seen in online
-            // documentation. We unscramble it here and store the decoded fields in the _microcode array.
-
-            // See https://www.righto.com/2022/11/how-8086-processors-microcode-engine.html for an in-depth description
-            // of the microcode format.
-
-            // Decode Type. There are 6 different types of micro-instruction, implying a different word format.
-            // All word formats share a source field, destination field, and 'update flags' flag, so we can decode the
-            // common fields here.
-
-            // The type field is either 2 or 3 bits. If 3 bits, the high bit is set.
-            int typ = (w >> 7) & 7;
-            if ((typ & 4) == 0) {
-                // High bit is not set, so this is a 2-bit type field. Shift right to discard the low bit.
-                typ >>= 1;
-            }
-
-            // Decode Source field
-            int s = ((w >> 13) & 1) + ((w >> 10) & 6) + ((w >> 11) & 0x18);
-
-            // Decode Destination field
-            int d = ((w >> 20) & 1) + ((w >> 18) & 2) + ((w >> 16) & 4) + ((w >> 14) & 8) + ((w >> 12) & 0x10);
-
-            // Decode 'update flags' flag
-            int f = (w >> 10) & 1;
-
-            // _microcode has four bytes for each decoded word - Destination, Source, (F + type), Operands
-            _microcode[i * 4] = d;
-            _microcode[i * 4 + 1] = s;
-            _microcode[i * 4 + 2] = (f << 3) + typ; // Pack F and type together
-            _microcode[i * 4 + 3] = w & 0xff; // Low 8 bits are operands - they require further unpacking.
-        }
-
-#if DEBUG_MC
-        std::cout << "Instruction words loaded." << std::endl;
-#endif
-
-        // Read in the stage1 decoder PLA ROM logic.
-        // The 8088 utilizes a "match decoder" which takes an 11-bit input and activates one column of the microcode
-        // ROM. This decoder is implemented as a programmable logic array (PLA) with 128 columns. The match logic
-        // allows a match on 0, 1, or "don't care" for each of the 11 input bits.
-
-        // To implement efficient microcode lookups, we expand the PLA data into a full 11-bit (2048-entry) lookup
-        // table, _microcodeIndex. This LUT is by nature sparse, but we shouldn't ever attempt to access a non-mapped
-        // entry during normal operation.
-        int stage1[128];
-        for (int x = 0; x < 128; ++x) {
-            stage1[x] = 0;
-        }
-        for (int g = 0; g < 9; ++g) {
-            // Width of each ROM file is 16, except for groups 0 and 8 which are 8.
-            int n = 16;
-            if (g == 0 || g == 8) {
-                n = 8;
-            }
-
-            // This array provides the X bit position offset for each group.
-            int xx[9] = {0, 8, 24, 40, 56, 72, 88, 104, 120};
-            int xp = xx[g];
-
-            // Iterate through top and bottom halves of each ROM file.
-            for (int h = 0; h < 2; ++h) {
-                std::string filename = decimal(g) + (h == 0 ? "t" : "b") + ".txt";
-#if DEBUG_MC
-                std::cout << "Loading microcode file: " << filename << std::endl;
-#endif
-                std::string_view s = get_file(filename);
-
-                // Iterate through the height of each ROM file (11 rows).
-                for (int y = 0; y < 11; ++y) {
-                    for (int x = 0; x < n; ++x) {
-                        int b = s[y * (n + LINE_ENDING_SIZE) + x] == '0' ? 1 : 0;
-                        if (b != 0) {
-                            // Stage1 is written in reverse-order.
-                            stage1[127 - (x + xp)] |= 1 << (y * 2 + (h ^ (y <= 2 ? 1 : 0)));
-                        }
-                    }
-                }
-            }
-        }
-
-        // Iterate through all possible 11-bit input combinations (2048), simulating all possible inputs into the
-        // decoder PLA.
-        for (int i = 0; i < 2048; ++i) {
-            static const int ba[] = {7, 2, 1, 0, 5, 6, 8, 9, 10, 3, 4};
-
-            // Scan through the decoder. There is one decoder column for every 4 microcode words.
-            for (int j = 0; j < 128; ++j) {
-                int s1 = stage1[j];
-                // Skip empty decoder slots as they cannot match anything
-                if (s1 == 0) {
-                    continue;
-                }
-                bool matches = true;
-                // The decoder uses 11-bit matches. Increment a bit index from 0..10.
-                for (int b = 0; b < 11; ++b) {
-                    int x = (s1 >> (ba[b] * 2)) & 3;
-                    int ib = (i >> (10 - b)) & 1;
-                    if (!(x == 0 || (x == 1 && ib == 1) || (x == 2 && ib == 0))) {
-                        matches = false;
-                        break;
-                    }
-                }
-
-                if (matches) {
-                    // This 11-bit input matches this decoder column, save it to the LUT.
-                    _microcodeIndex[i] = j;
-                    break;
-                }
-            }
-        }
-
-        // Decode the translation PLA.
-        // The translation PLA takes 8 bits of input and outputs a full 13-bit microcode address and a 1-bit segment
-        // specifier.
-
-        // The inputs vary depending on the type of lookup.
-        // For looking up an EA calculation microcode address, the inputs are 5 bits from the ModRM byte.
-
-        std::string translationFile = use8086 ? "translation_8086.txt" : "translation_8088.txt";
-#if DEBUG_MC
-        std::cout << "Loading translation ROM: " << translationFile << std::endl;
-#endif
-        std::string_view translationString = get_file(translationFile);
-        int tsp = 0;
-        char c = translationString[0];
-
-        // Iterate through the first 33 rows of the translation file (empty lines will be skipped)
-        for (int i = 0; i < 33; ++i) {
-            int mask = 0;
-            int bits = 0;
-            int output = 0;
-
-            // Iterate through the 8-character match mask that starts each line, constructing a bit mask
-            // for matching.
-            for (int j = 0; j < 8; ++j) {
-                if (c != '?') {
-                    mask |= 128 >> j;
-                }
-                if (c == '1') {
-                    bits |= 128 >> j;
-                }
-                c = translationString[++tsp];
-            }
-
-            // Iterate through the 14-character addresses corresponding to each match mask
-            for (int j = 0; j < 14; ++j) {
-                while (c != '0' && c != '1') {
-                    // Skip any whitespace
-                    c = translationString[++tsp];
-                }
-                if (c == '1') {
-                    // Set the corresponding output bit
-                    output |= 8192 >> j;
-                }
-                c = translationString[++tsp];
-            }
-            // Consume rest of line
-            while (c != 0x0A) {
-                c = translationString[++tsp];
-            }
-            // Consume newlines
-            while (c == 0x0A) {
-                c = translationString[++tsp];
-            }
-
-            for (int j = 0; j < 256; ++j) {
-                if ((j & mask) == bits) {
-#if DEBUG_MC
-                    std::cout << "Translation output: " << std::format("{:02X}: {:014b}\n", j, output);
-#endif
-                    _translation[j] = output;
-                }
-            }
-        }
-
-        // Decode the group decode PLA.
-        // The group decode PLA takes 9 bits of input (from opcode and prefixes) and outputs 15 control bits.
-
-        // For a detailed examination of the group decode PLA, see
-        // https://www.righto.com/2023/05/8086-processor-group-decode-rom.html
-
-        int groupInput[38 * 18];
-        int groupOutput[38 * 15];
-        std::string_view groupString = get_file("group.txt");
-
-        // Iterate through each column of the group decode ROM.
-        for (int x = 0; x < 38; ++x) {
-            // Iterate through the first 15 rows of the group decode ROM.
-            for (int y = 0; y < 15; ++y) {
-                groupOutput[y * 38 + x] = groupString[y * (38 + LINE_ENDING_SIZE) + x] == '0' ? 0 : 1;
-            }
-            for (int y = 0; y < 18; ++y) {
-                c = groupString[((y / 2) + 15) * (38 + LINE_ENDING_SIZE) + x];
-                if ((y & 1) == 0) {
-                    groupInput[y * 38 + x] = (c == '*' || c == '0') ? 1 : 0;
-                }
-                else {
-                    groupInput[y * 38 + x] = (c == '*' || c == '1') ? 1 : 0;
-                }
-            }
-        }
-        static const int groupYY[18] = {1, 0, 3, 2, 4, 6, 5, 7, 11, 10, 12, 13, 8, 9, 15, 14, 16, 17};
-        for (int x = 0; x < 34; ++x) {
-            if (x == 11) {
-                // Column 11 doesn't activate any outputs.
-                continue;
-            }
-
-            for (int i = 0; i < 0x101; ++i) {
-                bool found = true;
-                for (int j = 0; j < 9; ++j) {
-                    int y0 = groupInput[groupYY[j * 2] * 38 + x];
-                    int y1 = groupInput[groupYY[j * 2 + 1] * 38 + x];
-                    int b = (i >> j) & 1;
-                    if ((y0 == 1 && b == 1) || (y1 == 1 && b == 0)) {
-                        found = false;
-                        break;
-                    }
-                }
-                if (found) {
-                    int g = 0;
-                    for (int j = 0; j < 15; ++j) {
-                        g |= groupOutput[j * 38 + x] << j;
-                    }
-                    if (x == 10) {
-                        g |= groupLoadRegisterImmediate;
-                    }
-                    if (x == 12) {
-                        g |= groupWidthInOpcodeBit3;
-                    }
-                    if (x == 13) {
-                        g |= groupCMC;
-                    }
-                    if (x == 14) {
-                        g |= groupHLT;
-                    }
-                    if (x == 31) {
-                        g |= groupREP;
-                    }
-                    if (x == 32) {
-                        g |= groupSegmentOverride;
-                    }
-                    if (x == 33) {
-                        g |= groupLOCK;
-                    }
-                    if (i == 0xFA) {
-                        g |= groupCLI;
-                    }
-                    if (i == 0x8E || (i & 0xE7) == 0x07) {
-                        g |= groupLoadSegmentRegister;
-                    }
-                    _groups[i] = g;
-                }
-            }
-        }
-
-#if DEBUG_MC
-        for (int i = 0; i < 256; i++) {
-            std::cout << std::format("{:02X}:{:08X}\n", i, _groups[i]);
-        }
-#endif
-
         _microcodePointer = 0;
         _microcodeReturn = 0;
     }
@@ -674,23 +508,24 @@ private:
         }
     }
 
+    template <typename Policy>
     uint8_t queueRead(const QueueReadState qs) {
-        const uint8_t q1 = _queue & 0xff;
-        uint8_t q2 = 0;
-        _newQueue.pop(q2);
-        if (_log_instructions) {
-            if (_disassembler.disassemble(q2, qs == QueueReadState::FirstByte, _disassembly)) {
-                InstructionHistoryEntry ihe;
-                ihe.cs = cs();
-                ihe.ip = _inst_address;
-                ihe.disassembly = _disassembly;
-                _history.push(ihe);
+        const uint8_t b = _queue.pop();
+        if (Policy::kHistory) {
+            if (_log_instructions) {
+                if (_debug->disassembler.disassemble(b, qs == QueueReadState::FirstByte, _debug->disassembly)) {
+                    InstructionHistoryEntry ihe;
+                    ihe.cs = cs();
+                    ihe.ip = _inst_address;
+                    ihe.disassembly = _debug->disassembly;
+                    _debug->history.push(ihe);
+                }
             }
         }
-        assert(q1 == q2);
-        _dequeueing = true;
-        _snifferDecoder.queueOperation(qs);
-        return q1;
+        if (Policy::kCycleLog) {
+            _debug->sniffer.queueOperation(qs);
+        }
+        return b;
     }
 
     int modRMReg() const { return (_modRM >> 3) & 7; }
@@ -833,7 +668,7 @@ private:
         // Bit 2 is don't care.
         // Bits 3-5 are ModRM bits 0-3 (RM field).
         // Bits 6-7 are ModRM bits 6-7 (Mod field).
-        const int t = _translation[2 + ((_modRM & 7) << 3) + (_modRM & 0xc0)];
+        const int t = tables().translation[2 + ((_modRM & 7) << 3) + (_modRM & 0xc0)];
         // Bit 0 of the translation PLA output for an EA calculation address selects either DS or SS.
         _segment = (lowBit(t) ? 2 : 3);
         // Save the return address and jump to EA calculation microcode. This takes one cycle.
@@ -1135,49 +970,83 @@ private:
             | (_carry ? 1 : 0);
     }
 
+    template <typename Policy>
     uint32_t readSource() {
-        uint32_t v;
         switch (_source) {
             case 7: // Q
-                if (_queueBytes == 0) {
-                    _state = stateWaitingForQueueData;
-                    return 0;
-                }
-                return queueRead(QueueReadState::SubsequentByte);
+                return readQueue<Policy>();
             case 8: // A (AL)
             case 9: // C (CL)? - not used
             case 10: // E (DL)? - not used
             case 11: // L (BL)? - not used
-                return rb(_source & 3);
+                return readByteLow();
             case 16: // X (AH)
             case 17: // B (CH)? - not used
-                return rb((_source & 3) + 4);
+                return readByteHigh();
             case 18: // M
-                if ((_group & groupMNotAccumulator) == 0) {
-                    // This group decode ROM output forces M to use AL/AX.
-                    return (_wordSize ? ax() : al());
-                }
-                if ((_group & groupEffectiveAddress) == 0) {
-                    return rw();
-                }
-                return getMemOrReg(_mIsM);
+                return readM();
             case 19: // R
-                if ((_group & groupEffectiveAddress) == 0) {
-                    // This opcode has no ModR/M, so R is encoded in the opcode.
-                    // This is used by PUSH/POP sreg instructions 06, 0E, 16, & 1E
-                    return sr((_opcode >> 3) & 7);
-                }
-                return getMemOrReg(!_mIsM);
+                return readR();
             case 20: // SIGMA
-                v = doALU();
-                if (_updateFlags) {
-                    updateFlags();
-                }
-                return v;
+                return readSigma();
             case 22: // CR
-                _wordSize = true; // HACK: not sure how this happens for INT0 on the hardware
-                return _microcodePointer & 0xf;
+                return readCR();
+        }
+        return readRegister();
+    }
+
+    // Source handlers. The interpreter reaches these through readSource(); the specialized engine calls them directly.
+    template <typename Policy>
+    uint32_t readQueue() {
+        if (_queue.isEmpty()) {
+            _state = stateWaitingForQueueData;
+            return 0;
+        }
+        return queueRead<Policy>(QueueReadState::SubsequentByte);
+    }
+
+    uint32_t readByteLow() {
+        return rb(_source & 3);
+    }
+
+    uint32_t readByteHigh() {
+        return rb((_source & 3) + 4);
+    }
+
+    uint32_t readM() {
+        if ((_group & groupMNotAccumulator) == 0) {
+            // This group decode ROM output forces M to use AL/AX.
+            return (_wordSize ? ax() : al());
+        }
+        if ((_group & groupEffectiveAddress) == 0) {
+            return rw();
+        }
+        return getMemOrReg(_mIsM);
+    }
+
+    uint32_t readR() {
+        if ((_group & groupEffectiveAddress) == 0) {
+            // This opcode has no ModR/M, so R is encoded in the opcode.
+            // This is used by PUSH/POP sreg instructions 06, 0E, 16, & 1E
+            return sr((_opcode >> 3) & 7);
+        }
+        return getMemOrReg(!_mIsM);
+    }
+
+    uint32_t readSigma() {
+        uint32_t v = doALU();
+        if (_updateFlags) {
+            updateFlags();
         }
+        return v;
+    }
+
+    uint32_t readCR() {
+        _wordSize = true; // HACK: not sure how this happens for INT0 on the hardware
+        return _microcodePointer & 0xf;
+    }
+
+    uint32_t readRegister() {
         return _registers[_source];
     }
 
@@ -1187,83 +1056,128 @@ private:
             case 9: // C (CL)? - not used
             case 10: // E (DL)? - not used
             case 11: // L (BL)? - not used
-                rb(_destination & 3) = v;
+                writeByteLow(v);
                 break;
             case 15: // F
-                // Ensure our reserved flags are always set correctly
-                flags() = (v & 0xFFD5) | 0xF002;
+                writeFlags(v);
                 break;
             case 16: // X (AH)
             case 17: // B (CH)? - not used
-                rb((_destination & 3) + 4) = v;
+                writeByteHigh(v);
                 break;
             case 18: // M
-                if (_alu == 7) {
-                    // If ALU operation is CMP, we don't write back to M.
-                    break;
-                }
-                if ((_group & groupMNotAccumulator) == 0) {
-                    // This opcode is fixed to use AL or AX.
-                    if (!_wordSize) {
-                        al() = static_cast<uint8_t>(v);
-                    }
-                    else {
-                        ax() = v;
-                    }
-                    break;
-                }
-                if ((_group & groupEffectiveAddress) == 0) {
-                    // Opcode has no ModR/M
-                    if ((_group & groupLoadRegisterImmediate) != 0 && (_opcode & 8) == 0) {
-                        // Write to a byte register
-                        rb(_opcode & 7) = v;
-                    }
-                    else if ((_group & groupWidthInOpcodeBit3) != 0 && ((_opcode & 8) != 0)) {
-                        // Write to a byte register
-                        rb(_opcode & 7) = v;
-                    }
-                    else {
-                        // Write to a word register
-                        rw() = v;
-                    }
-                }
-                else {
-                    // Opcode has a ModR/M
-                    setMemOrReg(_mIsM, v);
-                    _skipRNI = _mIsM && _useMemory;
-                }
+                writeM(v);
                 break;
             case 19: // R
-                if ((_group & groupEffectiveAddress) == 0) {
-                    sr((_opcode >> 3) & 7) = v;
-                }
-                else {
-                    setMemOrReg(!_mIsM, v);
-                }
+                writeR(v);
                 break;
             case 20: // tmpaL
-                tmpa() = (tmpa() & 0xff00) | (v & 0xff);
+                writeTmpaL(v);
                 break;
             case 21: // tmpbL - sign extend to tmpb
-                tmpb() = ((v & 0x80) != 0 ? 0xff00 : 0) | (v & 0xff);
+                writeTmpbL(v);
                 break;
             case 22: // tmpaH
-                tmpa() = (tmpa() & 0xff) | (v << 8);
+                writeTmpaH(v);
                 break;
             case 23: // tmpbH
-                tmpb() = (tmpb() & 0xff) | (v << 8);
+                writeTmpbH(v);
                 break;
             default:
                 if (_destination < 32) {
-                    _registers[_destination] = v;
+                    writeRegister(v);
                 }
                 else {
-                    std::cerr << "Unknown destination: " << _destination << std::endl;
+                    writeUnknown(v);
                 }
 
         }
     }
 
+    // Destination handlers, shared by both microcode engines like the source handlers above.
+    void writeByteLow(uint32_t v) {
+        rb(_destination & 3) = v;
+    }
+
+    void writeFlags(uint32_t v) {
+        // Ensure our reserved flags are always set correctly
+        flags() = (v & 0xFFD5) | 0xF002;
+    }
+
+    void writeByteHigh(uint32_t v) {
+        rb((_destination & 3) + 4) = v;
+    }
+
+    void writeM(uint32_t v) {
+        if (_alu == 7) {
+            // If ALU operation is CMP, we don't write back to M.
+            return;
+        }
+        if ((_group & groupMNotAccumulator) == 0) {
+            // This opcode is fixed to use AL or AX.
+            if (!_wordSize) {
+                al() = static_cast<uint8_t>(v);
+            }
+            else {
+                ax() = v;
+            }
+            return;
+        }
+        if ((_group & groupEffectiveAddress) == 0) {
+            // Opcode has no ModR/M
+            if ((_group & groupLoadRegisterImmediate) != 0 && (_opcode & 8) == 0) {
+                // Write to a byte register
+                rb(_opcode & 7) = v;
+            }
+            else if ((_group & groupWidthInOpcodeBit3) != 0 && ((_opcode & 8) != 0)) {
+                // Write to a byte register
+                rb(_opcode & 7) = v;
+            }
+            else {
+                // Write to a word register
+                rw() = v;
+            }
+        }
+        else {
+            // Opcode has a ModR/M
+            setMemOrReg(_mIsM, v);
+            _skipRNI = _mIsM && _useMemory;
+        }
+    }
+
+    void writeR(uint32_t v) {
+        if ((_group & groupEffectiveAddress) == 0) {
+            sr((_opcode >> 3) & 7) = v;
+        }
+        else {
+            setMemOrReg(!_mIsM, v);
+        }
+    }
+
+    void writeTmpaL(uint32_t v) {
+        tmpa() = (tmpa() & 0xff00) | (v & 0xff);
+    }
+
+    void writeTmpbL(uint32_t v) {
+        tmpb() = ((v & 0x80) != 0 ? 0xff00 : 0) | (v & 0xff);
+    }
+
+    void writeTmpaH(uint32_t v) {
+        tmpa() = (tmpa() & 0xff) | (v << 8);
+    }
+
+    void writeTmpbH(uint32_t v) {
+        tmpb() = (tmpb() & 0xff) | (v << 8);
+    }
+
+    void writeRegister(uint32_t v) {
+        _registers[_destination] = v;
+    }
+
+    void writeUnknown(uint32_t) {
+        std::cerr << "Unknown destination: " << _destination << std::endl;
+    }
+
     void busAccessDone(const uint8_t high) {
         opr() |= high << 8;
         if ((_operands & 0x10) != 0) {
@@ -1338,69 +1252,17 @@ private:
         _ioRequested = true;
     }
 
+    template <typename Policy>
     void doSecondHalf() {
         switch (_type) {
             case 0: // short jump
-                if (!condition(_operands >> 4))
-                    break;
-                _microcodePointer =
-                    (_microcodePointer & 0x1ff0) + (_operands & 0xf);
-                _state = stateSingleCycleWait;
+                shortJump();
                 break;
             case 1: // precondition ALU
-                _alu = _operands >> 3;
-                // Preconditioning the ALU unlocks the carry latch.
-                _carryLatch = true;
-                _nx = lowBit(_operands);
-                if (_mIsM && _useMemory && _alu != 7 && (_group & groupEffectiveAddress) != 0) {
-                    _nx = false;
-                }
-                _aluInput = (_operands >> 1) & 3;
-                if (_alu == 0x11) {
-                    // XI
-                    readFlags();
-                    _alu = ((((_opcode & 0x80) != 0 ? _modRM : _opcode) >> 3) & 7) |
-                        ((_opcode >> 3) & 8) |
-                        ((_group & groupAddSubBooleanRotate) != 0 ? 0 : 0x10);
-                }
+                preconditionALU();
                 break;
             case 4:
-                switch ((_operands >> 3) & 0x0f) {
-                    case 0: // MAXC
-                        _counter = _wordSize ? 15 : 7;
-                        break;
-                    case 1: // FLUSH
-                        _queueBytes = 0;
-                        _queue = 0;
-                        _newQueue.clear();
-                        _snifferDecoder.queueOperation(QueueReadState::Flush);
-                        _queueFlushing = true;
-                        break;
-                    case 2: // CF1
-                        _f1 = !_f1;
-                        break;
-                    case 3: // CITF
-                        setIF(false);
-                        flags() &= ~0x100;
-                        break;
-                    case 4: // RCY
-                        _carry = false;
-                        _carryLatch = false;
-                        break;
-                    case 6: // CCOF
-                        _carry = false;
-                        setCF(false);
-                        setOF(false);
-                        break;
-                    case 7: // SCOF
-                        _carry = true;
-                        setCF(true);
-                        setOF(true);
-                        break;
-                    case 8: // WAIT
-                        // Don't know what this does!
-                        break;
-                }
+                doMisc<Policy>((_operands >> 3) & 0x0f);
                 doSecondMisc();
                 break;
             case 6:
@@ -1408,74 +1270,296 @@ private:
                 break;
             case 5: // long jump or call
             case 7:
-            {
-                int mc_ptr =
-                (((_microcodeIndex[_microcodePointer >> 2] << 2) +
-                    (_microcodePointer & 3)) << 2) >> 2;
-
-                if (mc_ptr == 0x1c5) {
-                    std::cout << "INT0: CF is " << (flags() & 1) << std::endl;
-                }
-
-                if (!condition(_operands >> 4)) {
-                    break;
-                }
-                _skipRNI = false;
-                if (_type == 7) {
-                    _microcodeReturn = _microcodePointer;
-                }
-                _microcodePointer = _translation[
-                    ((_type & 2) << 6) +
-                    ((_operands << 3) & 0x78) +
-                    ((_group & groupInitialEARead) == 0 ? 4 : 0) +
-                    ((_modRM & 0xc0) == 0 ? 1 : 0)] >> 1;
-
-                // int mc_ptr_dst =
-                // (((_microcodeIndex[_microcodePointer >> 2] << 2) +
-                //     (_microcodePointer & 3)) << 2) >> 2;
-                //std::cout << std::format("Long jump/call from {:03X} to {:03X}\n", mc_ptr, mc_ptr_dst);
-                _state = stateSingleCycleWait;
+                longJump();
                 break;
-            }
             default:
                 break;
         }
     }
 
-    void busStart() {
-        bool memory = (_group & groupMemory) != 0;
-        switch ((_operands >> 5) & 3) {
-            case 0:
-                _ioType = memory ? ioReadMemory : ioReadPort;
-                break;
-            case 1:
-                _ioType = ioInterruptAcknowledge;
-                break;
-            case 2:
-                _ioType = memory ? ioWriteMemory : ioWritePort;
-                break;
-            case 3:
-                _ioType = ioHalt;
-                break;
-            default:
-                break;
+    // Second-half handlers, shared by both microcode engines.
+    void shortJump() {
+        if (!condition(_operands >> 4)) {
+            return;
+        }
+        _microcodePointer =
+            (_microcodePointer & 0x1ff0) + (_operands & 0xf);
+        _state = stateSingleCycleWait;
+    }
+
+    void preconditionALU() {
+        _alu = _operands >> 3;
+        // Preconditioning the ALU unlocks the carry latch.
+        _carryLatch = true;
+        _nx = lowBit(_operands);
+        if (_mIsM && _useMemory && _alu != 7 && (_group & groupEffectiveAddress) != 0) {
+            _nx = false;
+        }
+        _aluInput = (_operands >> 1) & 3;
+        if (_alu == 0x11) {
+            // XI
+            readFlags();
+            _alu = ((((_opcode & 0x80) != 0 ? _modRM : _opcode) >> 3) & 7) |
+                ((_opcode >> 3) & 8) |
+                ((_group & groupAddSubBooleanRotate) != 0 ? 0 : 0x10);
+        }
+    }
+
+    template <typename Policy>
+    void doMisc(const int op) {
+        switch (op) {
+            case 0: // MAXC
+                _counter = _wordSize ? 15 : 7;
+                break;
+            case 1: // FLUSH
+                _queue.clear();
+                if (Policy::kCycleLog) {
+                    _debug->sniffer.queueOperation(QueueReadState::Flush);
+                }
+                _queueFlushing = true;
+                break;
+            case 2: // CF1
+                _f1 = !_f1;
+                break;
+            case 3: // CITF
+                setIF(false);
+                flags() &= ~0x100;
+                break;
+            case 4: // RCY
+                _carry = false;
+                _carryLatch = false;
+                break;
+            case 6: // CCOF
+                _carry = false;
+                setCF(false);
+                setOF(false);
+                break;
+            case 7: // SCOF
+                _carry = true;
+                setCF(true);
+                setOF(true);
+                break;
+            case 8: // WAIT
+                // Don't know what this does!
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Type 4 with the misc operation fixed at compile time, so the specialized engine skips the inner switch.
+    template <typename Policy, int Op>
+    void misc() {
+        doMisc<Policy>(Op);
+        doSecondMisc();
+    }
+
+    void longJump() {
+        int mc_ptr =
+        (((tables().microcodeIndex[_microcodePointer >> 2] << 2) +
+            (_microcodePointer & 3)) << 2) >> 2;
+
+        if (mc_ptr == 0x1c5) {
+            std::cout << "INT0: CF is " << (flags() & 1) << std::endl;
+        }
+
+        if (!condition(_operands >> 4)) {
+            return;
+        }
+        _skipRNI = false;
+        if (_type == 7) {
+            _microcodeReturn = _microcodePointer;
+        }
+        _microcodePointer = tables().translation[
+            ((_type & 2) << 6) +
+            ((_operands << 3) & 0x78) +
+            ((_group & groupInitialEARead) == 0 ? 4 : 0) +
+            ((_modRM & 0xc0) == 0 ? 1 : 0)] >> 1;
+
+        // int mc_ptr_dst =
+        // (((tables().microcodeIndex[_microcodePointer >> 2] << 2) +
+        //     (_microcodePointer & 3)) << 2) >> 2;
+        //std::cout << std::format("Long jump/call from {:03X} to {:03X}\n", mc_ptr, mc_ptr_dst);
+        _state = stateSingleCycleWait;
+    }
+
+    // Specialized engine: one step function per ROM word, instantiated at compile time from the constant microcode
+    // tables. Every field of the word is a template constant, so the source/destination/type switches fold away and
+    // each step is straight-line code. The EU still yields to the BIU after every micro-instruction exactly as the
+    // interpreter does.
+    static constexpr std::size_t kMicrocodeWords = sizeof(MicrocodeTables::microcode) / 4;
+
+    template <typename Policy, int Source>
+    uint32_t specializedRead() {
+        switch (Source) {
+            case 7:
+                return readQueue<Policy>();
+            case 8:
+            case 9:
+            case 10:
+            case 11:
+                return rb(Source & 3);
+            case 16:
+            case 17:
+                return rb((Source & 3) + 4);
+            case 18:
+                return readM();
+            case 19:
+                return readR();
+            case 20:
+                return readSigma();
+            case 22:
+                return readCR();
+            default:
+                return _registers[Source];
+        }
+    }
+
+    template <int Destination>
+    void specializedWrite(const uint32_t v) {
+        switch (Destination) {
+            case 8:
+            case 9:
+            case 10:
+            case 11:
+                rb(Destination & 3) = v;
+                break;
+            case 15:
+                writeFlags(v);
+                break;
+            case 16:
+            case 17:
+                rb((Destination & 3) + 4) = v;
+                break;
+            case 18:
+                writeM(v);
+                break;
+            case 19:
+                writeR(v);
+                break;
+            case 20:
+                writeTmpaL(v);
+                break;
+            case 21:
+                writeTmpbL(v);
+                break;
+            case 22:
+                writeTmpaH(v);
+                break;
+            case 23:
+                writeTmpbH(v);
+                break;
+            default:
+                if (Destination < 32) {
+                    // Masked so that the index stays in range in instances where this branch is dead.
+                    _registers[Destination & 31] = v;
+                }
+                else {
+                    writeUnknown(v);
+                }
+                break;
+        }
+    }
+
+    template <typename Policy, int Type, int Operands>
+    void specializedSecondHalf() {
+        switch (Type) {
+            case 0:
+                if (!condition(Operands >> 4)) {
+                    return;
+                }
+                _microcodePointer = (_microcodePointer & 0x1ff0) + (Operands & 0xf);
+                _state = stateSingleCycleWait;
+                break;
+            case 1:
+                preconditionALU();
+                break;
+            case 4:
+                misc<Policy, (Operands >> 3) & 0x0f>();
+                break;
+            case 5:
+            case 7:
+                longJump();
+                break;
+            case 6:
+                startIO();
+                break;
+            default:
+                break;
+        }
+    }
+
+    template <typename Policy, std::size_t Word>
+    static void specializedStep(Cpu& cpu) {
+        constexpr const uint8_t* m = &tables().microcode[Word << 2];
+        constexpr int type = m[2] & 7;
+
+        cpu.advanceMicrocodePointer();
+        cpu._destination = m[0];
+        cpu._source = m[1];
+        cpu._type = type;
+        cpu._updateFlags = ((m[2] & 8) != 0);
+        cpu._operands = m[3];
+        const uint32_t v = cpu.template specializedRead<Policy, m[1]>();
+        if (m[1] == 7 && cpu._state == stateWaitingForQueueData) {
+            // Empty queue prevents further execution. The interpreter resumes this word.
+            return;
+        }
+        cpu.template specializedWrite<m[0]>(v);
+        cpu.template specializedSecondHalf<Policy, type, m[3]>();
+    }
+
+    typedef void (*SpecializedStep)(Cpu&);
+
+    // The step functions of every ROM word, in microcode table order.
+    template <typename Policy, std::size_t... Words>
+    static const SpecializedStep* specializedSteps(IndexList<Words...>) {
+        static const SpecializedStep steps[] = {&Cpu::template specializedStep<Policy, Words>...};
+        return steps;
+    }
+
+    template <typename Policy>
+    void executeSpecialized() {
+        const SpecializedStep* steps = specializedSteps<Policy>(typename MakeIndexList<kMicrocodeWords>::Type());
+        steps[(tables().microcodeIndex[_microcodePointer >> 2] << 2) + (_microcodePointer & 3)](*this);
+    }
+
+    void busStart() {
+        bool memory = (_group & groupMemory) != 0;
+        switch ((_operands >> 5) & 3) {
+            case 0:
+                _ioType = memory ? ioReadMemory : ioReadPort;
+                break;
+            case 1:
+                _ioType = ioInterruptAcknowledge;
+                break;
+            case 2:
+                _ioType = memory ? ioWriteMemory : ioWritePort;
+                break;
+            case 3:
+                _ioType = ioHalt;
+                break;
+            default:
+                break;
         }
     }
 
 
     // Main microcode execution function. Represents one cycle of the Execution Unit (EU).
+    template <typename Policy>
     void executeMicrocode() {
-        uint8_t* m;
+        const uint8_t* m;
         uint32_t v;
 
-        // Sanity check of newQueue implementation
-        _newQueue.check(_queue);
-
         switch (_state) {
             case stateRunning:
                 _lastMicrocodePointer = _microcodePointer;
-                m = &_microcode[
-                    ((_microcodeIndex[_microcodePointer >> 2] << 2) +
+                if (_microcodeEngine == MicrocodeEngine::Specialized) {
+                    executeSpecialized<Policy>();
+                    break;
+                }
+                m = &tables().microcode[
+                    ((tables().microcodeIndex[_microcodePointer >> 2] << 2) +
                         (_microcodePointer & 3)) << 2];
                 advanceMicrocodePointer();
                 _destination = m[0];
@@ -1485,26 +1569,26 @@ private:
                 // Unpack the F bit from the type field.
                 _updateFlags = ((m[2] & 8) != 0);
                 _operands = m[3];
-                v = readSource();
+                v = readSource<Policy>();
                 if (_state == stateWaitingForQueueData) {
                     // Empty queue prevents further execution.
                     break;
                 }
                 writeDestination(v);
-                doSecondHalf();
+                doSecondHalf<Policy>();
                 break;
 
             case stateWaitingForQueueData:
-                if (_queueBytes == 0) {
+                if (_queue.isEmpty()) {
                     // Still no data. Try again next cycle.
                     break;
                 }
                 // We have a byte in the queue, so resume running.
                 _state = stateRunning;
                 // We can read the source now, so we can read it and immediately write back.
-                writeDestination(readSource());
+                writeDestination(readSource<Policy>());
                 // Process the operands part of the microcode word.
-                doSecondHalf();
+                doSecondHalf<Policy>();
                 break;
 
             case stateSuspending:
@@ -1520,8 +1604,8 @@ private:
                 if (_ioType != ioPassive || _busState == t4 || _t4) {
                     break;
                 }
-                pc() -= _queueBytes;
-                _queueBytes = 0; // so that realIP() is correct
+                pc() -= _queue.size();
+                _queue.clear(); // so that realIP() is correct
                 _state = stateRunning;
                 break;
 
@@ -1625,7 +1709,9 @@ private:
                 break;
 
             case stateHalting2:
-                _snifferDecoder.setStatus(static_cast<int>(ioHalt));
+                if (Policy::kCycleLog) {
+                    _debug->sniffer.setStatus(static_cast<int>(ioHalt));
+                }
                 _state = stateHalting1;
                 break;
 
@@ -1635,7 +1721,9 @@ private:
 
             case stateHalted:
                 // The CPU is halted!
-                _snifferDecoder.setStatus(static_cast<int>(ioPassive));
+                if (Policy::kCycleLog) {
+                    _debug->sniffer.setStatus(static_cast<int>(ioPassive));
+                }
                 // Stay halted until an interrupt occurs
                 if (!interruptPending()) {
                     break;
@@ -1656,12 +1744,13 @@ private:
     void setNextMicrocode(const int nextState, const int nextMicrocode) {
         _nextMicrocodePointer = nextMicrocode;
         _loaderState = nextState | 1;
-        _nextGroup = _groups[nextMicrocode >> 4];
+        _nextGroup = tables().groups[nextMicrocode >> 4];
     }
 
     // Handles reading the next opcode byte.
     // The 8088 processes interrupts, traps and NMI at this point, so any of these states will prevent normal opcode
     // fetching.
+    template <typename Policy>
     void readOpcode(const int nextState) {
 
         // Don't service interrupts after prefixes.
@@ -1686,17 +1775,17 @@ private:
         }
 
         // No interrupt conditions, so load the next opcode byte from the prefetch queue.
-        if (_queueBytes != 0) {
+        if (!_queue.isEmpty()) {
             if (!_in_instruction) {
                 // Starting a new instruction
                 _inst_boundary = true;
                 _in_instruction = true;
             }
-            QueueEntry qe = {};
-            _newQueue.peekEntry(qe);
-            _inst_address = qe.address;
-            setNextMicrocode(nextState, queueRead(QueueReadState::FirstByte) << 4);
-            _snifferDecoder.queueOperation(QueueReadState::FirstByte);
+            _inst_address = _queue.frontAddress();
+            setNextMicrocode(nextState, queueRead<Policy>(QueueReadState::FirstByte) << 4);
+            if (Policy::kCycleLog) {
+                _debug->sniffer.queueOperation(QueueReadState::FirstByte);
+            }
             return;
         }
         _loaderState = nextState & 2;
@@ -1724,6 +1813,7 @@ private:
 
     // Attempt to complete the current bus cycle. If the bus is not ready, return tWait to indicate we need to continue
     // waiting. Otherwise, complete the bus operation and return t4 to indicate the cycle is done.
+    template <typename Policy>
     BusState completeIO(const bool write) {
         if (!_ready) {
             return tWait;
@@ -1731,20 +1821,39 @@ private:
         if (!write) {
             // Perform a bus read
             _ioReadData = _bus.read();
-            _snifferDecoder.setData(_ioReadData);
+            if (Policy::kCycleLog) {
+                _debug->sniffer.setData(_ioReadData);
+            }
         }
         else {
             // Perform a bus write
             _ioReadData = _ioWriteData;
         }
         _bus.setPassiveOrHalt(true);
-        _snifferDecoder.setStatus(static_cast<int>(ioPassive));
+        if (Policy::kFastForward) {
+            if (_repFastPath.isRecording()) {
+                if (!write) {
+                    _repFastPath.recordRead(_cycle, _ioReadData);
+                }
+                _repFastPath.recordPassiveOrHalt(_cycle, true);
+            }
+            if (_loopDetector.isRecording()) {
+                if (!write) {
+                    _loopDetector.recordRead(_cycle, _ioReadData);
+                }
+                _loopDetector.recordPassiveOrHalt(_cycle, true);
+            }
+        }
+        if (Policy::kCycleLog) {
+            _debug->sniffer.setStatus(static_cast<int>(ioPassive));
+        }
         _lastIOType = _ioType;
         _ioType = ioPassive;
         return t4;
     }
 
     // Execute one CPU cycle.
+    template <typename Policy>
     void simulateCycle() {
         BusState nextState = _busState;
         const bool write = _ioType == ioWriteMemory || _ioType == ioWritePort;
@@ -1755,15 +1864,28 @@ private:
         bool prefetchCompleting = false;
         switch (_busState) {
             case t1:
-                _snifferDecoder.setAddress(_ioAddress);
+                if (Policy::kCycleLog) {
+                    _debug->sniffer.setAddress(_ioAddress);
+                }
                 _bus.startAccess(_ioAddress, static_cast<int>(_ioType));
+                if (Policy::kFastForward) {
+                    if (_repFastPath.isRecording()) {
+                        _repFastPath.recordAccess(_cycle, static_cast<uint8_t>(_ioType),
+                            static_cast<uint8_t>(_ioSegment), _ioIndex);
+                    }
+                    if (_loopDetector.isRecording()) {
+                        _loopDetector.recordAccess(_cycle, static_cast<uint8_t>(_ioType), _ioAddress);
+                    }
+                }
                 nextState = t2;
                 break;
             case t2:
-                _snifferDecoder.setStatusHigh(_ioSegment);
-                _snifferDecoder.setBusOperation(static_cast<int>(_ioType));
-                if (write) {
-                    _snifferDecoder.setData(_ioWriteData);
+                if (Policy::kCycleLog) {
+                    _debug->sniffer.setStatusHigh(_ioSegment);
+                    _debug->sniffer.setBusOperation(static_cast<int>(_ioType));
+                    if (write) {
+                        _debug->sniffer.setData(_ioWriteData);
+                    }
                 }
                 if (_ioType == ioInterruptAcknowledge) {
                     _bus.setLock(_state == stateWaitingUntilFirstByteDone);
@@ -1772,18 +1894,23 @@ private:
                 break;
             case t3:
                 // This is a check for the prefetch delay policy.
-                if (_ioType == ioPrefetch && _queueBytes == 3 && !_dequeueing) {
+                if (_ioType == ioPrefetch && _queue.isAtPolicyLen() && !_queue.isDequeueing()) {
                     _queueFilled = true;
                     //_cyclesUntilCanLowerQueueFilled = 3;
                 }
-                nextState = completeIO(write);
+                nextState = completeIO<Policy>(write);
                 break;
             case tWait:
-                nextState = completeIO(write);
+                nextState = completeIO<Policy>(write);
                 break;
             case t4:
                 if (_lastIOType == ioWriteMemory || _lastIOType == ioWritePort) {
                     _bus.write(_ioReadData);
+                    if (Policy::kFastForward) {
+                        if (_repFastPath.isRecording()) {
+                            _repFastPath.recordWrite(_cycle, _ioReadData);
+                        }
+                    }
                 }
                 if (_lastIOType == ioPrefetch) {
                     prefetchCompleting = true;
@@ -1792,26 +1919,17 @@ private:
                 _t4 = true;
                 break;
         }
-        if (_dequeueing) {
-            _dequeueing = false;
-            _queue >>= 8;
-            --_queueBytes;
-            // Don't need to adjust newQueue here as we did that when popping.
-        }
+        _queue.commitPop();
         //if (_cyclesUntilCanLowerQueueFilled == 0 || (_cyclesUntilCanLowerQueueFilled == 1 && _queueBytes < 3)) {
         //_cyclesUntilCanLowerQueueFilled = 0;
-        if ((_queueBytes < 3 || (_busState == tIdle && (_lastIOType != ioPrefetch || (!_t4 && !_t5))))) {
-            if (_busState == tIdle && !(_t4 && _lastIOType == ioPrefetch) && _queueBytes < 4) {
-                _queueFilled = false;
-            }
-        }
+        updateQueueFilled();
         //}
         //else
         //    --_cyclesUntilCanLowerQueueFilled;
 
         // We can execute microcode in loader states 2 & 3.
         if ((_loaderState & 2) != 0) {
-            executeMicrocode();
+            executeMicrocode<Policy>();
         }
 
         // Handle LOCK prefix.
@@ -1819,12 +1937,15 @@ private:
             _locking = false;
             _lock = true;
             _bus.setLock(true);
+            if (Policy::kFastForward) {
+                _loopDetector.abort(_cycle);
+            }
         }
 
         // Handle the instruction loader state machine.
         switch (_loaderState) {
             case 0:
-                readOpcode(0);
+                readOpcode<Policy>(0);
                 break;
             case 1:
             case 3:
@@ -1851,9 +1972,9 @@ private:
                     }
                     else {
                         _loaderState = 1;
-                        if (_queueBytes != 0) {
+                        if (!_queue.isEmpty()) {
                             // SC
-                            _nextModRM = queueRead(QueueReadState::SubsequentByte);
+                            _nextModRM = queueRead<Policy>(QueueReadState::SubsequentByte);
                             startMicrocodeInstruction();
                         }
                     }
@@ -1861,10 +1982,12 @@ private:
                 break;
             case 2:
                 if (_rni) {
-                    readOpcode(0);
+                    readOpcode<Policy>(0);
                 }
                 else if (_nx) {
-                    readOpcode(2);
+                    // NX ends the instruction like RNI, a cycle early, so the next one is a boundary too.
+                    _in_instruction = false;
+                    readOpcode<Policy>(2);
                 }
                 break;
             default:
@@ -1873,10 +1996,8 @@ private:
 
         // If we just completed a prefetch, add the byte to the queue.
         if (prefetchCompleting) {
-            _newQueue.push_word(static_cast<WordT>(_ioReadData), pc());
-            _queue |= (_ioReadData << (_queueBytes << 3));
-            ++_queueBytes;
-            ++pc();
+            _queue.pushWord(static_cast<WordT>(_ioReadData), pc());
+            pc() += sizeof(WordT);
         }
 
         if (nextState == tIdle && _ioType != ioPassive) {
@@ -1887,7 +2008,17 @@ private:
             }
 
             _bus.setPassiveOrHalt(_ioType == ioHalt);
-            _snifferDecoder.setStatus(static_cast<int>(_ioType));
+            if (Policy::kFastForward) {
+                if (_repFastPath.isRecording()) {
+                    _repFastPath.recordPassiveOrHalt(_cycle, _ioType == ioHalt);
+                }
+                if (_loopDetector.isRecording()) {
+                    _loopDetector.recordPassiveOrHalt(_cycle, _ioType == ioHalt);
+                }
+            }
+            if (Policy::kCycleLog) {
+                _debug->sniffer.setStatus(static_cast<int>(_ioType));
+            }
         }
         if (canStartPrefetch()) {
             _ioType = ioPrefetch;
@@ -1897,43 +2028,45 @@ private:
             _queueFlushing = false;
             _prefetching = true;
         }
-        // If cycle logging is enabled we want to capture logs regardless of the configured end cycle.
-        if (_cycleLogging && _cycle < _logEndCycle) {
-            _snifferDecoder.setAEN(_bus.getAEN());
-            _snifferDecoder.setDMA(_bus.getDMA());
-            _snifferDecoder.setPITBits(_bus.pitBits());
-            _snifferDecoder.setBusOperation(_bus.getBusOperation());
-            _snifferDecoder.setInterruptFlag(intf());
-            if (_bus.getDMAS3()) {
-                _savedAddress = _ioAddress;
-                _snifferDecoder.setAddress(_bus.getDMAAddress());
-            }
-            else {
-                if (_bus.getDMADelayedT2()) {
-                    _snifferDecoder.setAddress(_savedAddress);
-                    //_snifferDecoder.setStatus((int)_ioType);
-                    _snifferDecoder.setBusOperation(static_cast<int>(_ioType));
-                }
-            }
-            _snifferDecoder.setReady(_ready);
-            _snifferDecoder.setLock(_lock);
-            _snifferDecoder.setDMAS(_bus.getDMAS());
-            _snifferDecoder.setIRQs(_bus.getIRQLines());
-            _snifferDecoder.setINT(_bus.interruptPending());
-            //_snifferDecoder.setCGA(_bus.getCGA());
-
-            std::string l = _bus.snifferExtra() + _snifferDecoder.getLine();
-            l = pad(l, 103) + microcodeString();
-            if (_cycle >= _logStartCycle) {
-                // Always respect console logging
-                if (_consoleLogging) {
-                    std::cout << l << std::endl;
-                }
-                // Also append into the ring-buffer when cycle logging is enabled
-                if (_cycleLogging) {
-                    _logBuffer.push_back(l);
-                    if (_logBuffer.size() > _logCapacity) {
-                        _logBuffer.pop_front();
+        if (Policy::kCycleLog) {
+            // If cycle logging is enabled we want to capture logs regardless of the configured end cycle.
+            if (_cycleLogging && _cycle < _logEndCycle) {
+                _debug->sniffer.setAEN(_bus.getAEN());
+                _debug->sniffer.setDMA(_bus.getDMA());
+                _debug->sniffer.setPITBits(_bus.pitBits());
+                _debug->sniffer.setBusOperation(_bus.getBusOperation());
+                _debug->sniffer.setInterruptFlag(intf());
+                if (_bus.getDMAS3()) {
+                    _savedAddress = _ioAddress;
+                    _debug->sniffer.setAddress(_bus.getDMAAddress());
+                }
+                else {
+                    if (_bus.getDMADelayedT2()) {
+                        _debug->sniffer.setAddress(_savedAddress);
+                        //_debug->sniffer.setStatus((int)_ioType);
+                        _debug->sniffer.setBusOperation(static_cast<int>(_ioType));
+                    }
+                }
+                _debug->sniffer.setReady(_ready);
+                _debug->sniffer.setLock(_lock);
+                _debug->sniffer.setDMAS(_bus.getDMAS());
+                _debug->sniffer.setIRQs(_bus.getIRQLines());
+                _debug->sniffer.setINT(_bus.interruptPending());
+                //_debug->sniffer.setCGA(_bus.getCGA());
+
+                std::string l = _bus.snifferExtra() + _debug->sniffer.getLine();
+                l = pad(l, 103) + microcodeString();
+                if (_cycle >= _logStartCycle) {
+                    // Always respect console logging
+                    if (_consoleLogging) {
+                        std::cout << l << std::endl;
+                    }
+                    // Also append into the ring-buffer when cycle logging is enabled
+                    if (_cycleLogging) {
+                        _debug->logBuffer.push_back(l);
+                        if (_debug->logBuffer.size() > _debug->logCapacity) {
+                            _debug->logBuffer.pop_front();
+                        }
                     }
                 }
             }
@@ -1944,6 +2077,587 @@ private:
         _bus.tick();
     }
 
+    void updateQueueFilled() {
+        if ((_queue.size() < QueueLen - 1 ||
+            (_busState == tIdle && (_lastIOType != ioPrefetch || (!_t4 && !_t5))))) {
+            if (_busState == tIdle && !(_t4 && _lastIOType == ioPrefetch) && _queue.size() < QueueLen) {
+                _queueFilled = false;
+            }
+        }
+    }
+
+    // True when the CPU is halted with the BIU idle and nothing in flight. In this state a cycle of simulateCycle()
+    // only advances the bus and samples INTR until an interrupt wakes the CPU.
+    bool isIdleHalted() const {
+        return _state == stateHalted && _busState == tIdle && _ioType == ioPassive && !_ioRequested &&
+            !_t4 && !_t5 && !_t6 && !_prefetching && !_queueFlushing && !_locking && !_rni && !_nx &&
+            _loaderState == 2 && !_queue.isDequeueing();
+    }
+
+    // HLT fast-forward: run up to maxCycles idle halted cycles, stopping before the cycle that would wake the CPU.
+    // Each pass ticks the bus in bulk up to the next tick that might change the interrupt state; INTR is constant
+    // until then, so sampling it once per pass matches sampling it every cycle. Returns the cycles consumed.
+    int fastForwardHalt(const int maxCycles) {
+        int cycles = 0;
+        updateQueueFilled();
+        while (cycles < maxCycles && !interruptPending()) {
+            _interruptPending = _bus.interruptPending();
+            uint32_t n = _bus.ticksUntilNextEvent();
+            if (_interruptPending && intf()) {
+                // The CPU wakes on the next cycle.
+                n = 1;
+            }
+            n = std::min(n, static_cast<uint32_t>(maxCycles - cycles));
+            _bus.tickFor(n);
+            _cycle += n;
+            cycles += static_cast<int>(n);
+        }
+        return cycles;
+    }
+
+    // Append everything about the CPU that decides how execution continues from here. The cycle counter and the
+    // debugging aids (logs, history, sniffer, breakpoints) are left out.
+    void appendCpuState(StateBuffer& out) const {
+        out.put(_registers);
+        _queue.appendState(out);
+        out.put(_nmiRequested);
+        out.put(_busState);
+        out.put(_prefetching);
+        out.put(_ioType);
+        out.put(_ioAddress);
+        out.put(_ioIndex);
+        out.put(_ioReadData);
+        out.put(_ioWriteData);
+        out.put(_ioSegment);
+        out.put(_lastIOType);
+        out.put(_group);
+        out.put(_nextGroup);
+        out.put(_microcodePointer);
+        out.put(_nextMicrocodePointer);
+        out.put(_microcodeReturn);
+        out.put(_counter);
+        out.put(_alu);
+        out.put(_segmentOverride);
+        out.put(_f1);
+        out.put(_repne);
+        out.put(_lock);
+        out.put(_opcode);
+        out.put(_modRM);
+        out.put(_carry);
+        out.put(_carryLatch);
+        out.put(_zero);
+        out.put(_superZero);
+        out.put(_auxiliary);
+        out.put(_sign);
+        out.put(_parity);
+        out.put(_overflow);
+        out.put(_aluInput);
+        out.put(_nextModRM);
+        out.put(_loaderState);
+        out.put(_rni);
+        out.put(_inst_address);
+        out.put(_in_instruction);
+        out.put(_nx);
+        out.put(_state);
+        out.put(_source);
+        out.put(_destination);
+        out.put(_type);
+        out.put(_updateFlags);
+        out.put(_operands);
+        out.put(_mIsM);
+        out.put(_skipRNI);
+        out.put(_useMemory);
+        out.put(_read_prefix);
+        out.put(_wordSize);
+        out.put(_segment);
+        out.put(_lastMicrocodePointer);
+        out.put(_microcodeEngine);
+        out.put(_ioCancelling);
+        out.put(_ioRequested);
+        out.put(_t4);
+        out.put(_t5);
+        out.put(_t6);
+        out.put(_prefetchDelayed);
+        out.put(_queueFlushing);
+        out.put(_queueFilled);
+        out.put(_interruptPending);
+        out.put(_extraHaltDelay);
+        out.put(_savedAddress);
+        out.put(_ready);
+        out.put(_locking);
+        out.put(_bad_opcode_ct);
+    }
+
+    // The cycle after the RPTS loop of REP MOVS, STOS or LODS jumps back for another iteration.
+    bool atRepLoopHead() const {
+        const uint8_t op = _opcode & 0xfe;
+        return _state == stateSingleCycleWait && _microcodePointer == ((_opcode << 4) | 1) &&
+            (op == 0xa4 || op == 0xaa || op == 0xac);
+    }
+
+    RepFastPath::Semantics repSemantics() const {
+        const uint8_t width = _wordSize ? 2 : 1;
+        switch (_opcode & 0xfe) {
+            case 0xa4: // MOVS: read into OPR, write it back out
+                return {1u << 6, width, width, true};
+            case 0xaa: // STOS
+                return {0, 0, width, false};
+            default: // LODS: read into OPR, copy it to AL/AX
+                return {(1u << 6) | (1u << 24), width, 0, false};
+        }
+    }
+
+    // REP string fast path, called at the head of the RPTS loop with maxCycles left to run. If the iteration starting
+    // here repeats the reference, run the iterations that fit before DMA, INTR or the end of the count in closed form:
+    // each takes the reference's length in cycles and issues its accesses at the same cycles with the addresses moved
+    // on, so the CPU goes straight to the state stepping them would have left. Returns the cycles run.
+    int repBatch(const int maxCycles) {
+        const RepFastPath::Semantics semantics = repSemantics();
+        if (_repFastPath.isVerifying()) {
+            if (_cycle < _repFastPath.verifyEnd()) {
+                return 0;
+            }
+            finishRepVerification();
+        }
+        const uint32_t window = std::min(_bus.ticksUntilNextEvent(), _bus.ticksUntilDMARequest());
+        if (window == 0) {
+            _repFastPath.disturbed();
+            return 0;
+        }
+        StateBuffer& state = _repFastPath.state();
+        state.clear();
+        appendRepState(state, semantics);
+        const uint32_t iterations = _repFastPath.visit(_cycle, repRegisters(), _ioIndex, window,
+            static_cast<uint32_t>(maxCycles), semantics);
+        if (iterations == 0) {
+            return 0;
+        }
+        if (_repFastPath.mode() == RepFastPathMode::Verify) {
+            _repFastPath.beginVerification(_cycle, iterations, opr());
+            return 0;
+        }
+
+        // Move the data through the bus without stepping it cycle by cycle. Until DMA or INTR, only writes to device
+        // memory (such as CGA VRAM) and the age of the last access depend on the tick they happen on, so the bus is
+        // advanced in bulk up to those and then to the end of the batch. ready() and INTR stay the same throughout,
+        // and the CPU already holds the values it sampled.
+        const RepFastPath::Reference& reference = _repFastPath.reference();
+        const uint16_t steps = _repFastPath.batchSteps();
+        const uint64_t cycles = static_cast<uint64_t>(iterations) * reference.length;
+        uint16_t value = opr();
+        uint16_t previous = value;
+        uint64_t ticked = 0;
+        uint64_t lastAccess = 0;
+        uint32_t lastAddress = 0;
+        int lastType = 0;
+        for (uint32_t n = 0; n < iterations; ++n) {
+            const auto step = static_cast<uint16_t>(steps + n);
+            uint8_t bytes[2] = {0, 0};
+            size_t reads = 0;
+            size_t writes = 0;
+            for (size_t next = 0; next < reference.ops.size(); ++next) {
+                const RepFastPath::BusOp op =
+                    _repFastPath.expectedOp(next, step, static_cast<uint64_t>(n) * reference.length);
+                switch (op.kind) {
+                    case RepFastPath::OpKind::Access:
+                        lastAddress = physicalAddress(op.segment, op.index);
+                        lastType = op.type;
+                        lastAccess = op.cycle;
+                        if (op.type == ioWriteMemory && !_bus.isHostMemory(lastAddress)) {
+                            _bus.tickFor(static_cast<uint32_t>(op.cycle - ticked));
+                            ticked = op.cycle;
+                        }
+                        _bus.startAccess(lastAddress, lastType);
+                        break;
+                    case RepFastPath::OpKind::PassiveOrHalt:
+                        _bus.setPassiveOrHalt(op.value != 0);
+                        break;
+                    case RepFastPath::OpKind::Read:
+                        bytes[reads++] = _bus.read();
+                        break;
+                    case RepFastPath::OpKind::Write:
+                        if (!semantics.copiesReads) {
+                            bytes[writes] = op.value;
+                        }
+                        _bus.write(bytes[writes++]);
+                        break;
+                }
+            }
+            previous = value;
+            value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+        // Start the last access again at its own tick, so the bus counts its age from there.
+        _bus.tickFor(static_cast<uint32_t>(lastAccess - ticked));
+        _bus.startAccess(lastAddress, lastType);
+        _bus.tickFor(static_cast<uint32_t>(cycles - lastAccess));
+        applyRepBatch(static_cast<uint16_t>(steps + iterations), value, previous);
+
+        _cycle += cycles;
+        _repFastPath.batched(iterations);
+        return static_cast<int>(cycles);
+    }
+
+    // Move the CPU to the state stepping leaves it in at the head the given number of steps past the reference head.
+    // value is the data the last iteration moved and previous the data the one before it moved.
+    void applyRepBatch(const uint16_t steps, const uint16_t value, const uint16_t previous) {
+        const RepFastPath::Reference& reference = _repFastPath.reference();
+        const RepFastPath::Semantics& semantics = reference.semantics;
+        for (size_t r = 0; r < RepFastPath::kRegisters; ++r) {
+            if ((semantics.dataRegisters & (1u << r)) == 0) {
+                _registers[r] = static_cast<uint16_t>(reference.registers[r] + steps * reference.registerSteps[r]);
+            }
+        }
+        // Each iteration's ALU step decrements the count and sets the flag latches from the result. Repeat the last
+        // one on the value its input register had then.
+        uint16_t& input = _registers[_aluInput + 12];
+        const uint16_t result = input;
+        input = static_cast<uint16_t>(result - reference.registerSteps[_aluInput + 12]);
+        doALU();
+        input = result;
+
+        _ioIndex = static_cast<uint16_t>(reference.ioIndex + steps * reference.ioIndexStep);
+        _ioAddress = physicalAddress(_ioSegment, _ioIndex);
+        if (semantics.dataRegisters != 0) {
+            // Each access leaves the value it moved in OPR and its last byte in the read latch; the write latch holds
+            // the high byte of OPR as the last access started.
+            opr() = value;
+            _ioReadData = static_cast<uint8_t>(_wordSize ? value >> 8 : value);
+            _ioWriteData = static_cast<uint8_t>((semantics.copiesReads ? value : previous) >> 8);
+            if ((semantics.dataRegisters & (1u << 24)) != 0) {
+                if (_wordSize) {
+                    ax() = value;
+                }
+                else {
+                    al() = static_cast<uint8_t>(value);
+                }
+            }
+        }
+    }
+
+    // Verify mode: the batch has been stepped. Compare the state stepping left with the state applyRepBatch() predicts
+    // from the same data, then put the stepped state back.
+    void finishRepVerification() {
+        uint16_t steps;
+        uint16_t value;
+        uint16_t previous;
+        _repFastPath.verifiedBatch(steps, value, previous);
+        StateBuffer stepped;
+        appendCpuState(stepped);
+        const RepLatches saved = saveRepLatches();
+        applyRepBatch(steps, value, previous);
+        StateBuffer predicted;
+        appendCpuState(predicted);
+        restoreRepLatches(saved);
+        _repFastPath.finishVerification(_cycle, stepped == predicted);
+    }
+
+    // The fields that move on with every iteration of the RPTS loop: the registers, the last access, the flag latches
+    // the count decrement sets and the data latches.
+    struct RepLatches
+    {
+        RepFastPath::Registers registers;
+        uint32_t ioAddress;
+        uint16_t ioIndex;
+        uint8_t ioReadData;
+        uint8_t ioWriteData;
+        bool zero;
+        bool superZero;
+        bool sign;
+        uint8_t parity;
+        bool overflow;
+        bool auxiliary;
+    };
+
+    RepFastPath::Registers repRegisters() const {
+        RepFastPath::Registers registers;
+        std::copy(_registers, _registers + RepFastPath::kRegisters, registers.begin());
+        return registers;
+    }
+
+    RepLatches saveRepLatches() const {
+        return {repRegisters(), _ioAddress, _ioIndex, _ioReadData, _ioWriteData, _zero, _superZero, _sign,
+            _parity, _overflow, _auxiliary};
+    }
+
+    void restoreRepLatches(const RepLatches& latches) {
+        std::copy(latches.registers.begin(), latches.registers.end(), _registers);
+        _ioAddress = latches.ioAddress;
+        _ioIndex = latches.ioIndex;
+        _ioReadData = latches.ioReadData;
+        _ioWriteData = latches.ioWriteData;
+        _zero = latches.zero;
+        _superZero = latches.superZero;
+        _sign = latches.sign;
+        _parity = latches.parity;
+        _overflow = latches.overflow;
+        _auxiliary = latches.auxiliary;
+    }
+
+    // Append the state at a head of the RPTS loop with the fields that move on every iteration cleared. RepFastPath
+    // checks the registers itself, and applyRepBatch() recomputes the rest. The data latches only move if the iteration
+    // moves data through OPR.
+    void appendRepState(StateBuffer& out, const RepFastPath::Semantics& semantics) {
+        const RepLatches saved = saveRepLatches();
+        for (uint16_t& r : _registers) {
+            r = 0;
+        }
+        _ioAddress = 0;
+        _ioIndex = 0;
+        if (semantics.dataRegisters != 0) {
+            _ioReadData = 0;
+            _ioWriteData = 0;
+        }
+        _zero = false;
+        _superZero = false;
+        _sign = false;
+        _parity = 0;
+        _overflow = false;
+        _auxiliary = false;
+        appendCpuState(out);
+        restoreRepLatches(saved);
+    }
+
+    // Busy-wait loop skipping, called at every instruction boundary with maxCycles left to run. At a visit to the head
+    // of a loop that repeats a period (see LoopDetector), evaluate the periods that follow and skip the ones that end
+    // before INTR may change, read nothing that may change before they read it and leave a period to step before
+    // maxCycles: each issues the period's bus cycles at the same offsets, with the data addresses the evaluation gave,
+    // and the registers come out as the evaluation left them. Returns the cycles skipped.
+    int skipLoop(const int maxCycles) {
+        if (!_loopDetector.atBoundary(cs(), _inst_address, _cycle)) {
+            return 0;
+        }
+        StateBuffer& state = _loopDetector.state();
+        state.clear();
+        appendLoopState(state);
+        if (_loopDetector.isVerifying()) {
+            _loopDetector.finishVerification(_cycle, state == _loopDetector.period().state &&
+                sameLoopRegisters(loopRegisters(), _loopDetector.verifiedRegisters()));
+            return 0;
+        }
+        const uint32_t window = _bus.ticksUntilNextEvent();
+        const LoopDetector::Period* period = _loopDetector.visit(_cycle, loopRegisters(), window);
+        if (period == nullptr) {
+            return 0;
+        }
+        if (!_loopDetector.isPeriodChecked()) {
+            if (!checkLoopPeriod(*period)) {
+                _loopDetector.reject(_cycle);
+                return 0;
+            }
+            _loopDetector.periodChecked();
+        }
+        LoopDetector::Registers registers = loopRegisters();
+        std::vector<LoopEvaluator::Read> reads;
+        bool bounded = false;
+        const uint32_t periods =
+            evaluateLoop(*period, window, static_cast<uint32_t>(maxCycles), registers, reads, bounded);
+        if (periods == 0) {
+            if (!bounded) {
+                _loopDetector.reject(_cycle);
+            }
+            return 0;
+        }
+        if (_loopDetector.mode() == LoopSkipMode::Verify) {
+            _loopDetector.beginVerification(_cycle, periods, registers, reads);
+            return 0;
+        }
+
+        // Nothing the periods read changes while they run and none of them writes, so the bus only needs to see the
+        // accesses start at the right ticks for DMA and wait states to come out the same.
+        const uint64_t cycles = static_cast<uint64_t>(periods) * period->length;
+        uint64_t ticked = 0;
+        size_t read = 0;
+        for (uint32_t n = 0; n < periods; ++n) {
+            const uint64_t start = static_cast<uint64_t>(n) * period->length;
+            for (const LoopDetector::BusOp& op : period->ops) {
+                if (op.kind == LoopDetector::OpKind::Read) {
+                    continue;
+                }
+                _bus.tickFor(static_cast<uint32_t>(start + op.cycle - ticked));
+                ticked = start + op.cycle;
+                if (op.kind == LoopDetector::OpKind::PassiveOrHalt) {
+                    _bus.setPassiveOrHalt(op.value != 0);
+                }
+                else {
+                    _bus.startAccess(op.type == ioPrefetch ? op.address : reads[read++].address, op.type);
+                }
+            }
+        }
+        _bus.tickFor(static_cast<uint32_t>(cycles - ticked));
+        applyLoopRegisters(registers);
+
+        _cycle += cycles;
+        _loopDetector.skipped(periods);
+        return static_cast<int>(cycles);
+    }
+
+    // Source of bytes for LoopEvaluator that checks a recorded period: data comes from what the period read.
+    struct RecordedLoopSource
+    {
+        BusType& bus;
+        const LoopDetector::Period& period;
+        size_t next;
+
+        bool code(const uint32_t address, uint8_t& value) {
+            uint32_t stableTicks = 0;
+            return bus.stableRead(address, ioPrefetch, value, stableTicks);
+        }
+
+        bool read(const uint32_t address, const uint8_t type, uint8_t& value) {
+            if (next >= period.reads.size() || period.reads[next].address != address ||
+                period.reads[next].type != type) {
+                return false;
+            }
+            value = period.reads[next++].value;
+            return true;
+        }
+    };
+
+    // Source of bytes for LoopEvaluator for the periods after the current head: data comes from the bus, in a bus
+    // cycle of the same type as the recorded period's, from the same address unless the period's addresses may move,
+    // and has to stay the same until the period reads it.
+    struct PredictedLoopSource
+    {
+        BusType& bus;
+        const LoopDetector::Period& period;
+        uint64_t start; // Ticks from now to the start of the period being evaluated
+        size_t next;
+        bool changes; // Set if a read failed only because its value may change before the period reads it
+
+        bool code(const uint32_t address, uint8_t& value) {
+            uint32_t stableTicks = 0;
+            return bus.stableRead(address, ioPrefetch, value, stableTicks);
+        }
+
+        bool read(const uint32_t address, const uint8_t type, uint8_t& value) {
+            if (next >= period.reads.size()) {
+                return false;
+            }
+            const LoopEvaluator::Read& expected = period.reads[next];
+            uint32_t stableTicks = 0;
+            if (type != expected.type || (!period.addressesMayMove && address != expected.address) ||
+                !bus.stableRead(address, type, value, stableTicks)) {
+                return false;
+            }
+            if (start + period.readCycles[next] >= stableTicks) {
+                changes = true;
+                return false;
+            }
+            ++next;
+            return true;
+        }
+    };
+
+    // Check that the evaluator takes the period from the registers it started with to the ones it ended with, reading
+    // what it read.
+    bool checkLoopPeriod(const LoopDetector::Period& period) {
+        LoopDetector::Registers registers = period.registers;
+        std::vector<LoopEvaluator::Read> reads;
+        RecordedLoopSource source = {_bus, period, 0};
+        return LoopEvaluator::run(registers, period.path, source, reads) && reads.size() == period.reads.size() &&
+            sameLoopRegisters(registers, period.endRegisters);
+    }
+
+    // Evaluate the periods that follow from registers, moving them on to the end of the last one that can be skipped
+    // and appending the bytes those read to reads. A period can be skipped if it repeats the recorded one, ends before
+    // the window in which INTR stays the same does, and leaves at least one period of maxCycles to step, so that the
+    // temporaries are set again before run_for() returns. Returns the number of periods, and sets bounded if the
+    // periods stopped at one of these limits, or at a read that may change, rather than where the loop stops
+    // repeating the period.
+    uint32_t evaluateLoop(const LoopDetector::Period& period, const uint32_t window, const uint32_t maxCycles,
+        LoopDetector::Registers& registers, std::vector<LoopEvaluator::Read>& reads, bool& bounded) {
+        const uint32_t length = period.length;
+        bounded = true;
+        if (length == 0 || maxCycles < 2 * length) {
+            return 0;
+        }
+        // The last cycle skipped samples INTR before the tick that may change it, and the bus's INTR at the head the
+        // skip ends on is the one the period started with.
+        const uint32_t limit = std::min(window - 1, maxCycles - length) / length;
+        uint32_t periods = 0;
+        while (periods < limit) {
+            LoopDetector::Registers next = registers;
+            const size_t first = reads.size();
+            PredictedLoopSource source = {_bus, period, static_cast<uint64_t>(periods) * length, 0, false};
+            if (!LoopEvaluator::run(next, period.path, source, reads) || reads.size() - first != period.reads.size()) {
+                reads.resize(first);
+                bounded = source.changes;
+                break;
+            }
+            registers = next;
+            ++periods;
+        }
+        return periods;
+    }
+
+    // The registers LoopEvaluator works on.
+    LoopDetector::Registers loopRegisters() const {
+        LoopDetector::Registers registers;
+        std::copy(_registers, _registers + registers.size(), registers.begin());
+        return registers;
+    }
+
+    // Whether the segment registers, FLAGS and the general registers are the same.
+    static bool sameLoopRegisters(const LoopDetector::Registers& a, const LoopDetector::Registers& b) {
+        return std::equal(a.begin(), a.begin() + 4, b.begin()) && a[15] == b[15] &&
+            std::equal(a.begin() + 24, a.end(), b.begin() + 24);
+    }
+
+    void applyLoopRegisters(const LoopDetector::Registers& registers) {
+        std::copy(registers.begin(), registers.begin() + 4, _registers);
+        _registers[15] = registers[15];
+        std::copy(registers.begin() + 24, registers.end(), _registers + 24);
+    }
+
+    // The fields a pass through a busy-wait loop may leave different at its head besides the general registers and
+    // FLAGS: the temporaries and the flag latches, which the instructions set before they use them, and the data
+    // latches, which every bus cycle sets first.
+    struct LoopLatches
+    {
+        LoopDetector::Registers registers;
+        uint8_t ioReadData;
+        uint8_t ioWriteData;
+        bool carry;
+        bool zero;
+        bool superZero;
+        bool sign;
+        uint8_t parity;
+        bool overflow;
+        bool auxiliary;
+    };
+
+    // Append the state at a loop head with the general registers, FLAGS and the latches cleared, followed by the
+    // bus's timing state. LoopDetector compares the rest, and LoopEvaluator takes care of the registers.
+    void appendLoopState(StateBuffer& out) {
+        const LoopLatches saved = {loopRegisters(), _ioReadData, _ioWriteData, _carry, _zero, _superZero, _sign,
+            _parity, _overflow, _auxiliary};
+        static const int kCleared[] = {5, 6, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31};
+        for (const int r : kCleared) {
+            _registers[r] = 0;
+        }
+        _ioReadData = 0;
+        _ioWriteData = 0;
+        _carry = false;
+        _zero = false;
+        _superZero = false;
+        _sign = false;
+        _parity = 0;
+        _overflow = false;
+        _auxiliary = false;
+        appendCpuState(out);
+        std::copy(saved.registers.begin(), saved.registers.end(), _registers);
+        _ioReadData = saved.ioReadData;
+        _ioWriteData = saved.ioWriteData;
+        _carry = saved.carry;
+        _zero = saved.zero;
+        _superZero = saved.superZero;
+        _sign = saved.sign;
+        _parity = saved.parity;
+        _overflow = saved.overflow;
+        _auxiliary = saved.auxiliary;
+        _bus.appendTimingState(out);
+    }
+
     static std::string pad(const std::string& s, int n) {
         return s + std::string(std::max(0, n - static_cast<int>(s.length())), ' ');
     }
@@ -2031,10 +2745,10 @@ private:
         };
 
         int mcIndex =
-        ((_microcodeIndex[_lastMicrocodePointer >> 2] << 2) +
+        ((tables().microcodeIndex[_lastMicrocodePointer >> 2] << 2) +
             (_lastMicrocodePointer & 3)) << 2;
         int mcLineNumber = mcIndex >> 2;
-        uint8_t* m = &_microcode[mcIndex];
+        const uint8_t* m = &tables().microcode[mcIndex];
         int d = m[0];
         int s = m[1];
         int t = m[2] & 7;
@@ -2461,53 +3175,35 @@ private:
         return ((_registers[segment] << 4) + offset) & 0xFFFFF;
     }
 
-    std::string _log;
-    // Ring buffer of recent log lines for cycle logging
-    std::deque<std::string> _logBuffer;
-    size_t _logCapacity = 1000; // default capacity (lines)
-    bool _cycleLogging = false; // enabled via GUI
-    BusType _bus;
-
 public:
     // Cycle log API
     void setCycleLogging(bool v) { _cycleLogging = v; }
     bool isCycleLogging() const { return _cycleLogging; }
-    void clearCycleLog() { _logBuffer.clear(); }
+    void clearCycleLog() { _debug->logBuffer.clear(); }
 
     void setCycleLogCapacity(size_t c) {
-        _logCapacity = c;
-        while (_logBuffer.size() > _logCapacity)
-            _logBuffer.pop_front();
+        _debug->logCapacity = c;
+        while (_debug->logBuffer.size() > _debug->logCapacity)
+            _debug->logBuffer.pop_front();
     }
 
-    const std::deque<std::string>& getCycleLogBuffer() const { return _logBuffer; }
-    size_t getCycleLogSize() const { return _logBuffer.size(); }
-    size_t getCycleLogCapacity() const { return _logCapacity; }
+    const std::deque<std::string>& getCycleLogBuffer() const { return _debug->logBuffer; }
+    size_t getCycleLogSize() const { return _debug->logBuffer.size(); }
+    size_t getCycleLogCapacity() const { return _debug->logCapacity; }
     // Append a single line directly into the cycle log buffer (for diagnostics/UI)
     void appendCycleLogLine(const std::string& line) {
-        _logBuffer.push_back(line);
-        if (_logBuffer.size() > _logCapacity) {
-            _logBuffer.pop_front();
+        _debug->logBuffer.push_back(line);
+        if (_debug->logBuffer.size() > _debug->logCapacity) {
+            _debug->logBuffer.pop_front();
         }
     }
 
     std::string getQueueString() const {
-        return _newQueue.getQueueString();
-        // // Return the bytes in the queue as hex bytes from index 0 .. _queueBytes-1
-        // if (_queueBytes <= 0)
-        //     return std::string();
-        // std::string out;
-        // for (int i = 0; i < _queueBytes; ++i) {
-        //     const uint8_t b = static_cast<uint8_t>((_queue >> (i * 8)) & 0xFF);
-        //     if (!out.empty())
-        //         out += ' ';
-        //     out += std::format("{:02X}", static_cast<unsigned>(b));
-        // }
-        // return out;
+        return _queue.getQueueString();
     }
 
     std::string getQueueDebugString() const {
-        const auto debug = _newQueue.getDebug();
+        const auto debug = _queue.getDebug();
         std::ostringstream oss;
         for (const auto& entry : debug) {
             oss << std::format("{:02X}[{:04X}] ", static_cast<unsigned>(entry.data), entry.address);
@@ -2516,25 +3212,24 @@ public:
     }
 
 private:
-    class InstructionQueue
+    // The prefetch queue: a fixed ring buffer holding each fetched byte and the IP it was fetched from.
+    // The BIU commits a dequeue one cycle after the EU reads a byte. pop() returns the byte immediately, but the byte
+    // stays counted in size() until commitPop() runs at the start of the next cycle, so size() always matches the
+    // queue length the hardware sees (and the one the real IP is derived from).
+    class PrefetchQueue
     {
     public:
-        typedef std::size_t size_type;
-
-        InstructionQueue() :
-            head_(0)
-            , tail_(0)
-            , size_(0) {
-        }
+        typedef uint8_t size_type;
 
         void clear() {
             head_ = 0;
             tail_ = 0;
-            size_ = 0;
+            count_ = 0;
+            dequeueing_ = false;
         }
 
         size_type size() const {
-            return size_;
+            return count_ + (dequeueing_ ? 1 : 0);
         }
 
         static size_type capacity() {
@@ -2542,82 +3237,84 @@ private:
         }
 
         bool isEmpty() const {
-            return size_ == 0;
+            return size() == 0;
         }
 
-        bool full() const {
-            return size_ == QueueLen;
+        bool isDequeueing() const {
+            return dequeueing_;
         }
 
-        size_type freeSpace() const {
-            return QueueLen - size_;
-        }
+        bool isAtPolicyLen() const {
+            const size_type sz = size();
+            const size_type cap = QueueLen;
 
-        bool hasRoom() const {
-            return freeSpace() >= sizeof(WordT);
+            if (std::is_same<WordT, uint8_t>::value) {
+                // 8088: queue is "almost full" when it has capacity-1 bytes
+                return (sz == cap - 1);
+            }
+            else {
+                // 8086: queue is "almost full" when size is cap-1 or cap-2
+                // (since fetch requires 2-byte room)
+                return (sz == cap - 1) || (sz == cap - 2);
+            }
         }
 
-        // Push a single entry (byte + address). Returns false if full.
-        bool push(uint8_t data, uint16_t address) {
-            if (full()) {
-                return false;
+        // Push a "native word".
+        // For uint8_t: pushes one byte at address.
+        // For uint16_t: pushes two bytes (little-endian) at address, address+1.
+        // The BIU only fetches when the queue has room for a whole word.
+        void pushWord(const WordT word, const uint16_t address) {
+            assert(QueueLen - count_ >= sizeof(WordT));
+            if (std::is_same<WordT, uint8_t>::value) {
+                push(static_cast<uint8_t>(word), address);
+            }
+            else {
+                const uint16_t w = static_cast<uint16_t>(word);
+                push(static_cast<uint8_t>(w & 0x00FFu), address);
+                push(static_cast<uint8_t>((w >> 8) & 0x00FFu), address + 1);
             }
-            buffer_[head_].data = data;
-            buffer_[head_].address = address;
-            advanceHead();
-            return true;
         }
 
-        // Pop oldest entry. Returns false if empty.
-        bool popEntry(QueueEntry& out) {
-            if (isEmpty()) {
-                return false;
-            }
-            out = buffer_[tail_];
-            advanceTail();
-            return true;
+        // Read the oldest byte. The queue length doesn't drop until commitPop().
+        uint8_t pop() {
+            assert(count_ > 0);
+            const uint8_t b = data_[tail_];
+            tail_ = next(tail_);
+            --count_;
+            dequeueing_ = true;
+            return b;
         }
 
-        bool pop(uint8_t& out) {
-            if (isEmpty()) {
-                return false;
-            }
-            out = buffer_[tail_].data;
-            advanceTail();
-            return true;
+        void commitPop() {
+            dequeueing_ = false;
         }
 
-        // Peek the oldest entry without removing it. Returns false if empty.
-        bool peekEntry(QueueEntry& out) const {
-            if (isEmpty()) {
-                return false;
-            }
-            out = buffer_[tail_];
-            return true;
+        // Address of the oldest byte not yet read.
+        uint16_t frontAddress() const {
+            return address_[tail_];
         }
 
-        // Push a "native word".
-        // For uint8_t: pushes one byte at address.
-        // For uint16_t: pushes two bytes (little-endian) at address, address+1.
-        // Returns false if not enough room for all bytes.
-        bool push_word(WordT word, const uint16_t address) {
-            if (const size_type bytes_needed = sizeof(WordT); freeSpace() < bytes_needed) {
-                return false;
-            }
+        // Save or load the ring as it stands (see SaveState.h).
+        template <typename Archive>
+        void serialize(Archive& ar) {
+            ar(data_);
+            ar(address_);
+            ar(head_);
+            ar(tail_);
+            ar(count_);
+            ar(dequeueing_);
+        }
 
-            if (std::is_same<WordT, uint8_t>::value) {
-                uint8_t b = static_cast<uint8_t>(word);
-                return push(b, address);
+        // Append the queue's contents, oldest first, independent of where they sit in the ring.
+        void appendState(StateBuffer& out) const {
+            out.put(count_);
+            out.put(dequeueing_);
+            size_type index = tail_;
+            for (size_type count = 0; count < count_; ++count) {
+                out.put(data_[index]);
+                out.put(address_[index]);
+                index = next(index);
             }
-
-            const uint16_t w = static_cast<uint16_t>(word);
-            const uint8_t lo = static_cast<uint8_t>(w & 0x00FFu);
-            const uint8_t hi = static_cast<uint8_t>((w >> 8) & 0x00FFu);
-
-            // We already know we have room.
-            push(lo, address);
-            push(hi, address + 1);
-            return true;
         }
 
         std::string getQueueString() const {
@@ -2625,17 +3322,15 @@ private:
 
             // Print each byte from oldest (tail) to newest (head)
             size_type index = tail_;
-            for (size_type count = 0; count < size_; ++count) {
-                const uint8_t b = buffer_[index].data;
-
+            for (size_type count = 0; count < count_; ++count) {
                 // Two-digit upper-case hex
                 oss << std::uppercase
                     << std::hex
                     << std::setw(2)
                     << std::setfill('0')
-                    << static_cast<unsigned>(b);
+                    << static_cast<unsigned>(data_[index]);
 
-                index = (index + 1) % QueueLen;
+                index = next(index);
             }
 
             return oss.str();
@@ -2643,62 +3338,35 @@ private:
 
         std::vector<QueueEntry> getDebug() const {
             std::vector<QueueEntry> out;
-            out.reserve(size_); // avoid reallocations
+            out.reserve(count_); // avoid reallocations
 
             size_type index = tail_;
-            for (size_type count = 0; count < size_; ++count) {
-                out.push_back(buffer_[index]);
-                index = (index + 1) % QueueLen;
+            for (size_type count = 0; count < count_; ++count) {
+                out.push_back({data_[index], address_[index]});
+                index = next(index);
             }
 
             return out;
         }
 
-        bool isAtPolicyLen() const {
-            const size_type sz = size_;
-            const size_type cap = QueueLen;
-
-            if (std::is_same<WordT, uint8_t>::value) {
-                // 8088: queue is "almost full" when it has capacity-1 bytes
-                return (sz == cap - 1);
-            }
-            else {
-                // 8086: queue is "almost full" when size is cap-1 or cap-2
-                // (since fetch requires 2-byte room)
-                return (sz == cap - 1) || (sz == cap - 2);
-            }
-        }
-
-        void check(const uint32_t expected) const {
-            uint32_t packed = 0;
-            size_type index = tail_;
-
-            // Only pack up to 4 bytes in FIFO order
-            const size_type limit = (size_ < 4) ? size_ : 4;
-
-            for (size_type i = 0; i < limit; ++i) {
-                const uint8_t b = buffer_[index].data;
-                packed |= (static_cast<uint32_t>(b) << (i * 8)); // little-endian
-                index = (index + 1) % QueueLen;
-            }
-
-            assert(packed == expected);
-        }
-
     private:
-        std::array<QueueEntry, QueueLen> buffer_;
-        size_type head_; // next write
-        size_type tail_; // next read
-        size_type size_; // number of valid entries
+        std::array<uint8_t, QueueLen> data_{};
+        std::array<uint16_t, QueueLen> address_{};
+        size_type head_{0}; // next write
+        size_type tail_{0}; // next read
+        size_type count_{0}; // bytes not yet read by the EU
+        bool dequeueing_{false}; // a byte was read this cycle; the BIU commits the dequeue next cycle
 
-        void advanceHead() {
-            head_ = (head_ + 1) % QueueLen;
-            ++size_;
+        static size_type next(const size_type index) {
+            return (index + 1 == QueueLen) ? 0 : index + 1;
         }
 
-        void advanceTail() {
-            tail_ = (tail_ + 1) % QueueLen;
-            --size_;
+        void push(const uint8_t data, const uint16_t address) {
+            assert(count_ < QueueLen);
+            data_[head_] = data;
+            address_[head_] = address;
+            head_ = next(head_);
+            ++count_;
         }
     };
 
@@ -2832,83 +3500,66 @@ private:
             (_microcodePointer & 0xFFF0) | ((_microcodePointer + 1) & 0xf);
     }
 
-    int _stopIP;
-    int _stopSeg;
-
+    // Per-cycle state. Everything simulateCycle() and the microcode engines touch on a typical cycle is gathered here,
+    // starting on a cache line boundary, so that one emulated cycle touches as few cache lines as possible.
+    alignas(64) uint16_t _registers[32];
+    PrefetchQueue _queue{};
     uint64_t _cycle;
-    uint64_t _logStartCycle;
-    uint64_t _logEndCycle = UINT64_MAX;
-    uint64_t _executeEndCycle;
-    bool _consoleLogging;
-
-    bool _nmiRequested; // Not actually set anywhere yet
-
-    BusState _busState;
-    bool _prefetching;
-
-    IOType _ioType;
     uint32_t _ioAddress;
-    uint16_t _ioIndex;
-    uint8_t _ioReadData;
-    uint8_t _ioWriteData;
-    int _ioSegment;
-    IOType _lastIOType;
-
-    SnifferDecoder _snifferDecoder;
-
-    uint16_t _registers[32];
-    uint32_t _queue;
-    InstructionQueue _newQueue{};
-    int _queueBytes;
-    uint8_t* _byteRegisters[8];
-    uint8_t _microcode[4 * 512];
-    uint8_t _microcodeIndex[2048];
-    uint16_t _translation[256];
-    uint32_t _groups[257];
     uint32_t _group;
     uint32_t _nextGroup;
+    uint32_t _savedAddress;
+    BusState _busState;
+    MicrocodeState _state;
+    IOType _ioType;
+    IOType _lastIOType;
+    MicrocodeEngine _microcodeEngine{MicrocodeEngine::Interpreter};
+    int _ioSegment;
+    int _counter; // only 4 bits on the CPU
+    int _segmentOverride;
+    int _aluInput;
+    int _loaderState;
+    int _source;
+    int _destination;
+    int _type;
+    int _segment;
+    int _lastMicrocodePointer;
+    int _ioCancelling;
+    uint32_t _testNumber = 0;
+    uint16_t _ioIndex;
     uint16_t _microcodePointer;
     uint16_t _nextMicrocodePointer;
     uint16_t _microcodeReturn;
-    int _counter; // only 4 bits on the CPU
+    uint16_t _inst_address{0x0000};
+    uint8_t _ioReadData;
+    uint8_t _ioWriteData;
     uint8_t _alu;
-    int _segmentOverride;
-    bool _f1;
-    bool _repne;
-    bool _lock;
     uint8_t _opcode;
     uint8_t _modRM;
+    uint8_t _nextModRM;
+    uint8_t _operands;
+    uint8_t _parity{0};
     bool _carry{false};
     bool _carryLatch{false}; // This latch enables updating the carry flag.
     bool _zero{false};
     bool _superZero{false};
     bool _auxiliary{false};
     bool _sign{false};
-    uint8_t _parity{0};
     bool _overflow{false};
-    int _aluInput;
-    uint8_t _nextModRM;
-    int _loaderState;
+    bool _f1;
+    bool _repne;
+    bool _lock;
+    bool _prefetching;
     bool _rni{false}; // Microcode signal to read next instruction
-    uint16_t _inst_address{0x0000};
     bool _inst_boundary{false};
     bool _in_instruction{false};
     bool _nx{false}; // Microcode signal to read next instruction early (1-cycle pipeline)
-    MicrocodeState _state;
-    int _source;
-    int _destination;
-    int _type;
     bool _updateFlags{false};
-    uint8_t _operands;
     bool _mIsM;
     bool _skipRNI;
     bool _useMemory;
     bool _read_prefix{false};
     bool _wordSize;
-    int _segment;
-    int _lastMicrocodePointer;
-    bool _dequeueing;
-    int _ioCancelling;
     bool _ioRequested;
     bool _t4;
     bool _t5;
@@ -2918,27 +3569,51 @@ private:
     bool _queueFilled;
     bool _interruptPending;
     bool _extraHaltDelay;
-    uint32_t _savedAddress;
     bool _ready = true;
     //int _cyclesUntilCanLowerQueueFilled;
     bool _locking = false;
+    bool _nmiRequested; // Not actually set anywhere yet
+    uint8_t* _byteRegisters[8];
+
+    BusType _bus;
+
+    // Fast forwarding. Only their recording flags are read on every cycle.
+    RepFastPath _repFastPath;
+    LoopDetector _loopDetector;
+
+    // Run control, breakpoints and logging switches, read once per call or only under DebugPolicy.
+    int _stopIP;
+    int _stopSeg;
+    uint64_t _logStartCycle;
+    uint64_t _logEndCycle = UINT64_MAX;
+    uint64_t _executeEndCycle;
+    bool _consoleLogging = false;
+    bool _cycleLogging = false; // enabled via GUI
+    bool _log_instructions = false;
     // Breakpoint state
     bool _hasBreakpoint = false;
     bool _breakpointHit = false;
     uint16_t _breakpoint_cs = 0;
     uint16_t _breakpoint_ip = 0;
-    uint32_t _testNumber = 0;
-
-    bool _log_instructions = false;
-    std::string _disassembly;
-    InstructionHistory _history;
-    Disassembler _disassembler;
 
     // Off-rails detection
     bool _off_rails_detection = false;
     int _bad_opcode_max = OFF_RAILS_CT;
     int _bad_opcode_ct = 0;
     bool _off_rails = false;
+
+    // Debugger and tracing state. Only DebugPolicy and the GUI use it, so it is kept out of line.
+    struct DebugState
+    {
+        std::deque<std::string> logBuffer; // Ring buffer of recent log lines for cycle logging
+        size_t logCapacity = 1000; // default capacity (lines)
+        SnifferDecoder sniffer;
+        std::string disassembly;
+        InstructionHistory history;
+        Disassembler disassembler;
+    };
+
+    std::unique_ptr<DebugState> _debug{new DebugState()};
 };
 
 #endif
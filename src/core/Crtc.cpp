@@ -280,205 +280,3 @@ void Crtc6845::update_cursor_data() {
         cursor_end_line_ = static_cast<uint8_t>(CRTC_ROW_MAX - 1);
     }
 }
-
-// Return the immediate status of the cursor
-bool Crtc6845::cursor_immediate() const {
-    bool cur = cursor_enabled_
-        && (vma_ == cursor_address_)
-        && cursor_data_[static_cast<size_t>(vlc_c9_ & 0x1F)];
-
-    if (has_cursor_blink_rate_) {
-        cur = cur && blink_state_;
-    }
-    return cur;
-}
-
-// Tick the CRTC
-// Returns (status_ptr, current_vma)
-std::pair<const Crtc6845::CrtcStatusBits*, uint16_t>
-Crtc6845::tick(const HBlankCallback& hblank_cb) {
-    // transient pulses low unless we fire them this tick
-    status_.hsync = false;
-    status_.vsync = false;
-
-    if (hcc_c0_ == 0) {
-        status_.hborder = false;
-        if (vcc_c4_ == 0) {
-            // We are at the first character of a CRTC frame. Update start address.
-            vma_ = start_address_latch_;
-        }
-    }
-
-    if (hcc_c0_ < 2) {
-        // When C0 < 2 evaluate last_line flag status.
-        // LOGON SYSTEM v1.6 pg 73
-        if (vcc_c4_ == reg_[4]) {
-            last_row_ = true;
-            last_line_ = (vlc_c9_ == reg_[9]);
-            vtac_c5_ = 0;
-        }
-    }
-
-    // Update horizontal character counter
-    hcc_c0_++;
-
-    // Advance video memory address offset
-    vma_++;
-    char_col_ = 0;
-
-    // Process horizontal blanking period
-    if (status_.hblank) {
-        // increment HSYNC counter
-        hsc_c3l_++;
-
-        // Allow the adapter to supply effective HSYNC width
-        const uint8_t eff = hblank_cb ? hblank_cb() : reg_[3];
-        hsync_target_ = std::min(eff, reg_[3]);
-
-        if (hsc_c3l_ == hsync_target_) {
-            // Logical end of scanline (fire HSYNC pulse)
-            if (status_.vblank) {
-                // Count VSYNC lines during vblank
-                //vsc_c3h_++;
-                if (vsc_c3h_ == CRTC_VBLANK_HEIGHT) {
-                    in_last_vblank_line_ = true;
-                    vsc_c3h_ = 0;
-                    status_.vsync = true;
-                }
-            }
-
-            char_col_ = 0;
-            status_.hsync = true;
-        }
-
-        // End HBLANK when we reach R3 (sync width)
-        if (hsc_c3l_ == reg_[3]) {
-            status_.hblank = false;
-            hsc_c3l_ = 0;
-        }
-    }
-
-    if (hcc_c0_ == reg_[1]) {
-        // C0 == R1. Entering right overscan.
-        if (vlc_c9_ == reg_[9]) {
-            // Last scanline of this character row; save VMA' for next row
-            vma_t_ = vma_;
-        }
-        status_.den = false;
-        status_.hborder = true;
-    }
-
-    if (hcc_c0_ == reg_[2]) {
-        // Enter HBLANK at HorizontalSyncPosition
-        const uint8_t eff = hblank_cb ? hblank_cb() : reg_[3];
-        hsync_target_ = eff;
-        status_.hblank = true;
-        hsc_c3l_ = 0;
-    }
-
-    if ((hcc_c0_ == (reg_[0] + 1)) && in_last_vblank_line_) {
-        // Right before the new frame begins, draw one char of border.
-        // When we roll to +1 we clear VBLANK soon after.
-        status_.hborder = true;
-    }
-
-    if (hcc_c0_ == (reg_[0] + 1)) {
-        // C0 == R0: Leaving left overscan, finished scanning row
-
-        if (status_.vblank) {
-            // If we are in VBLANK, advance Vertical Sync Counter
-            vsc_c3h_ += 1;
-        }
-
-        if (in_last_vblank_line_) {
-            // Leave VBLANK after last line.
-            in_last_vblank_line_ = false;
-            status_.vblank = false;
-        }
-
-        // Reset Horizontal Character Counter and increment character row counter
-        hcc_c0_ = 0;
-        status_.hborder = false;
-        // Wrap vertical line counter (5 bits)
-        vlc_c9_ = (vlc_c9_ + 1) & 0x1F;
-
-        // Return video memory address to starting position for next character row
-        vma_ = vma_t_;
-        char_col_ = 0;
-
-        if (!status_.vblank && (vcc_c4_ < reg_[6])) {
-            // Start the new row
-            status_.den = true;
-            status_.hborder = false;
-        }
-
-        if (vlc_c9_ == reg_[9] + 1) {
-            // C9 == R9 We finished drawing this row of characters
-            vlc_c9_ = 0;
-            // Increment Vertical Character Counter for next row
-            vcc_c4_++;
-            // Set vma to starting position for next character row
-            vma_ = vma_t_;
-
-            if (vcc_c4_ == reg_[7]) {
-                // C4 == R7: We've reached vertical sync
-                status_.vblank = true;
-                status_.den = false;
-
-                if (has_cursor_blink_rate_) {
-                    cursor_blink_ct_++;
-                    if (cursor_blink_ct_ == cursor_blink_rate_) {
-                        cursor_blink_ct_ = 0;
-                        blink_state_ = !blink_state_;
-                    }
-                }
-            }
-
-            if (last_line_) {
-                in_vta_ = true;
-                last_row_ = false;
-                last_line_ = false;
-            }
-        }
-
-        if (vcc_c4_ == reg_[6]) {
-            // C4 == R6: Enter lower overscan area.
-            status_.den = false;
-            status_.vborder = true;
-        }
-
-        // if (vcc_c4_ == reg_[4] + 1) {
-        //     // We are at vertical total, start incrementing vertical total adjust counter.
-        //     in_vta_ = true;
-        // }
-
-        if (in_vta_) {
-            // We are in vertical total adjust.
-            if (vtac_c5_ == reg_[5]) {
-                // We have reached vertical total adjust. We are at the end of the top overscan.
-                in_vta_ = false;
-                vtac_c5_ = 0;
-                hcc_c0_ = 0;
-                vcc_c4_ = 0;
-                vlc_c9_ = 0;
-                char_col_ = 0;
-
-                start_address_latch_ = start_address_;
-                vma_ = start_address_;
-                vma_t_ = vma_;
-
-                status_.den = true;
-                status_.vborder = false;
-                status_.vblank = false;
-            }
-            else {
-                vtac_c5_++;
-            }
-        }
-    }
-
-    // Update cursor bit based on current position
-    status_.cursor = cursor_immediate();
-
-    return {&status_, vma_};
-}
@@ -4,7 +4,6 @@
 #include <array>
 #include <vector>
 #include <string>
-#include <functional>
 #include <utility>
 #include <algorithm>
 #include <sstream>
@@ -68,8 +67,6 @@ public:
     static constexpr size_t REGISTER_MAX = 17;
     static constexpr uint8_t REGISTER_UNREADABLE_VALUE = 0xFF;
 
-    using HBlankCallback = std::function<uint8_t(void)>;
-
 public:
     explicit Crtc6845();
 
@@ -106,11 +103,269 @@ public:
         in_last_vblank_line_ = false;
     }
 
+    // Save or load the registers, counters and status (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar(reg_);
+        ar(reg_select_);
+        ar(start_address_);
+        ar(start_address_latch_);
+        ar(lightpen_position_);
+        ar(cursor_data_);
+        ar(cursor_address_);
+        ar(cursor_enabled_);
+        ar(cursor_start_line_);
+        ar(cursor_end_line_);
+        ar(blink_state_);
+        ar(cursor_blink_ct_);
+        ar(has_cursor_blink_rate_);
+        ar(cursor_blink_rate_);
+        ar(hcc_c0_);
+        ar(char_col_);
+        ar(vlc_c9_);
+        ar(vcc_c4_);
+        ar(vsc_c3h_);
+        ar(hsc_c3l_);
+        ar(vtac_c5_);
+        ar(in_vta_);
+        ar(last_line_);
+        ar(last_row_);
+        ar(vma_);
+        ar(vma_t_);
+        ar(hsync_target_);
+        ar(status_);
+        ar(in_last_vblank_line_);
+    }
+
     void write(uint16_t rel_port, uint8_t data);
     [[nodiscard]] uint8_t read(uint16_t rel_port) const;
 
-    // Step one character time. Returns (status_ptr, current_vma).
-    std::pair<const CrtcStatusBits*, uint16_t> tick(const HBlankCallback& hblank_cb);
+    // Step one character time. hsync_width is the HSYNC width the adapter generates, in character times, which
+    // ends the sync early if R3 asks for a wider one. Defined here so it inlines into the adapter's character clock.
+    const CrtcStatusBits& tick(const uint8_t hsync_width) {
+        // transient pulses low unless we fire them this tick
+        status_.hsync = false;
+        status_.vsync = false;
+
+        if (hcc_c0_ == 0) {
+            status_.hborder = false;
+            if (vcc_c4_ == 0) {
+                // We are at the first character of a CRTC frame. Update start address.
+                vma_ = start_address_latch_;
+            }
+        }
+
+        if (hcc_c0_ < 2) {
+            // When C0 < 2 evaluate last_line flag status.
+            // LOGON SYSTEM v1.6 pg 73
+            if (vcc_c4_ == reg_[4]) {
+                last_row_ = true;
+                last_line_ = (vlc_c9_ == reg_[9]);
+                vtac_c5_ = 0;
+            }
+        }
+
+        // Update horizontal character counter
+        hcc_c0_++;
+
+        // Advance video memory address offset
+        vma_++;
+        char_col_ = 0;
+
+        // Process horizontal blanking period
+        if (status_.hblank) {
+            // increment HSYNC counter
+            hsc_c3l_++;
+
+            hsync_target_ = std::min(hsync_width, reg_[3]);
+
+            if (hsc_c3l_ == hsync_target_) {
+                // Logical end of scanline (fire HSYNC pulse)
+                if (status_.vblank) {
+                    // Count VSYNC lines during vblank
+                    //vsc_c3h_++;
+                    if (vsc_c3h_ == CRTC_VBLANK_HEIGHT) {
+                        in_last_vblank_line_ = true;
+                        vsc_c3h_ = 0;
+                        status_.vsync = true;
+                    }
+                }
+
+                char_col_ = 0;
+                status_.hsync = true;
+            }
+
+            // End HBLANK when we reach R3 (sync width)
+            if (hsc_c3l_ == reg_[3]) {
+                status_.hblank = false;
+                hsc_c3l_ = 0;
+            }
+        }
+
+        if (hcc_c0_ == reg_[1]) {
+            // C0 == R1. Entering right overscan.
+            if (vlc_c9_ == reg_[9]) {
+                // Last scanline of this character row; save VMA' for next row
+                vma_t_ = vma_;
+            }
+            status_.den = false;
+            status_.hborder = true;
+        }
+
+        if (hcc_c0_ == reg_[2]) {
+            // Enter HBLANK at HorizontalSyncPosition
+            hsync_target_ = hsync_width;
+            status_.hblank = true;
+            hsc_c3l_ = 0;
+        }
+
+        if ((hcc_c0_ == (reg_[0] + 1)) && in_last_vblank_line_) {
+            // Right before the new frame begins, draw one char of border.
+            // When we roll to +1 we clear VBLANK soon after.
+            status_.hborder = true;
+        }
+
+        if (hcc_c0_ == (reg_[0] + 1)) {
+            // C0 == R0: Leaving left overscan, finished scanning row
+
+            if (status_.vblank) {
+                // If we are in VBLANK, advance Vertical Sync Counter
+                vsc_c3h_ += 1;
+            }
+
+            if (in_last_vblank_line_) {
+                // Leave VBLANK after last line.
+                in_last_vblank_line_ = false;
+                status_.vblank = false;
+            }
+
+            // Reset Horizontal Character Counter and increment character row counter
+            hcc_c0_ = 0;
+            status_.hborder = false;
+            // Wrap vertical line counter (5 bits)
+            vlc_c9_ = (vlc_c9_ + 1) & 0x1F;
+
+            // Return video memory address to starting position for next character row
+            vma_ = vma_t_;
+            char_col_ = 0;
+
+            if (!status_.vblank && (vcc_c4_ < reg_[6])) {
+                // Start the new row
+                status_.den = true;
+                status_.hborder = false;
+            }
+
+            if (vlc_c9_ == reg_[9] + 1) {
+                // C9 == R9 We finished drawing this row of characters
+                vlc_c9_ = 0;
+                // Increment Vertical Character Counter for next row
+                vcc_c4_++;
+                // Set vma to starting position for next character row
+                vma_ = vma_t_;
+
+                if (vcc_c4_ == reg_[7]) {
+                    // C4 == R7: We've reached vertical sync
+                    status_.vblank = true;
+                    status_.den = false;
+
+                    if (has_cursor_blink_rate_) {
+                        cursor_blink_ct_++;
+                        if (cursor_blink_ct_ == cursor_blink_rate_) {
+                            cursor_blink_ct_ = 0;
+                            blink_state_ = !blink_state_;
+                        }
+                    }
+                }
+
+                if (last_line_) {
+                    in_vta_ = true;
+                    last_row_ = false;
+                    last_line_ = false;
+                }
+            }
+
+            if (vcc_c4_ == reg_[6]) {
+                // C4 == R6: Enter lower overscan area.
+                status_.den = false;
+                status_.vborder = true;
+            }
+
+            // if (vcc_c4_ == reg_[4] + 1) {
+            //     // We are at vertical total, start incrementing vertical total adjust counter.
+            //     in_vta_ = true;
+            // }
+
+            if (in_vta_) {
+                // We are in vertical total adjust.
+                if (vtac_c5_ == reg_[5]) {
+                    // We have reached vertical total adjust. We are at the end of the top overscan.
+                    in_vta_ = false;
+                    vtac_c5_ = 0;
+                    hcc_c0_ = 0;
+                    vcc_c4_ = 0;
+                    vlc_c9_ = 0;
+                    char_col_ = 0;
+
+                    start_address_latch_ = start_address_;
+                    vma_ = start_address_;
+                    vma_t_ = vma_;
+
+                    status_.den = true;
+                    status_.vborder = false;
+                    status_.vblank = false;
+                }
+                else {
+                    vtac_c5_++;
+                }
+            }
+        }
+
+        // Update cursor bit based on current position
+        status_.cursor = cursor_immediate();
+
+        return status_;
+    }
+
+    // Number of character times from now that only count: C0 and the address go up by one, the sync pulses stay
+    // low, and no row, sync, blanking or display boundary is reached. Zero when the next one does more.
+    [[nodiscard]] uint32_t charsUntilBoundary() const {
+        if (hcc_c0_ < 2 || status_.hblank) {
+            return 0;
+        }
+        const auto chars_until = [this](const int target) -> uint32_t {
+            return static_cast<uint32_t>((target - hcc_c0_ - 1) & 0xFF);
+        };
+        // Stop where C0 wraps, too: at 0 and 1 the row bookkeeping runs.
+        uint32_t n = 0x100u - hcc_c0_;
+        n = std::min({n, chars_until(reg_[1]), chars_until(reg_[2])});
+        if (reg_[0] < 0xFF) {
+            n = std::min(n, chars_until(reg_[0] + 1));
+        }
+        return n;
+    }
+
+    // Return the number of character times until the first one that might change display enable or vertical blank (the
+    // next one is 1). Only the character times where C0 reaches R1, which clears display enable, or R0 + 1 change them.
+    [[nodiscard]] uint32_t charsUntilStatusChange() const {
+        const auto chars_until = [this](const int target) -> uint32_t {
+            return static_cast<uint32_t>(((target - hcc_c0_ - 1) & 0xFF) + 1);
+        };
+        uint32_t n = status_.den ? chars_until(reg_[1]) : 0x100u;
+        if (reg_[0] < 0xFF) {
+            n = std::min(n, chars_until(reg_[0] + 1));
+        }
+        return n;
+    }
+
+    // Run n character times at once, exactly as n calls to tick() would. n may not exceed charsUntilBoundary().
+    void runChars(const uint32_t n) {
+        hcc_c0_ = static_cast<uint8_t>(hcc_c0_ + n);
+        vma_ = static_cast<uint16_t>(vma_ + n);
+        char_col_ = 0;
+        status_.hsync = false;
+        status_.vsync = false;
+        status_.cursor = cursor_immediate();
+    }
 
     [[nodiscard]] uint16_t start_address() const { return start_address_latch_; }
     [[nodiscard]] uint16_t address() const { return vma_; }
@@ -125,7 +380,17 @@ public:
 
     [[nodiscard]] uint16_t cursor_address() const { return cursor_address_; }
     [[nodiscard]] std::pair<uint8_t, uint8_t> cursor_extents() const { return {cursor_start_line_, cursor_end_line_}; }
-    [[nodiscard]] bool cursor_immediate() const; // current cursor output (includes blink gating)
+    // Current cursor output (includes blink gating)
+    [[nodiscard]] bool cursor_immediate() const {
+        bool cur = cursor_enabled_
+            && (vma_ == cursor_address_)
+            && cursor_data_[static_cast<size_t>(vlc_c9_ & 0x1F)];
+
+        if (has_cursor_blink_rate_) {
+            cur = cur && blink_state_;
+        }
+        return cur;
+    }
     [[nodiscard]] bool cursor_enabled() const { return cursor_enabled_; }
 
     [[nodiscard]] const std::array<uint8_t, 18>& get_registers() const { return reg_; }
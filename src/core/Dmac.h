@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <array>
 
+#include "StateBuffer.h"
+
 class DMAC
 {
 public:
@@ -273,6 +275,40 @@ public:
         return channel_;
     }
 
+    // Append what decides when the controller asks for the bus and which channel it serves next. The addresses and
+    // counts a transfer moves on don't change when it happens.
+    void appendTimingState(StateBuffer& out) const {
+        out.put(request_);
+        out.put(channel_);
+        out.put(priority_channel_);
+        out.put(command_);
+    }
+
+    // Save or load the controller's state (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        for (auto& c : channels_) {
+            ar(c.base_address);
+            ar(c.base_word_count);
+            ar(c.current_address);
+            ar(c.current_word_count);
+            ar(c.mode);
+            ar(c.tc);
+        }
+        ar(temporary_address_);
+        ar(temporary_word_count_);
+        ar(status_);
+        ar(command_);
+        ar(temporary_);
+        ar(mask_);
+        ar(request_);
+        ar(ack_);
+        ar(flip_flop_);
+        ar(channel_);
+        ar(priority_channel_);
+        ar(need_high_address_);
+    }
+
 private:
     struct Channel
     {
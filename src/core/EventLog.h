@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <string>
+
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off,
+};
+
+enum class LogDevice : uint8_t
+{
+    Bus,
+    DMAC,
+    FDC,
+    Keyboard,
+    CGA,
+};
+
+// Every message the devices can log. Each has a fixed device, level and format string in kLogEvents below.
+enum class LogEvent : uint16_t
+{
+    InterruptAcknowledge,
+    DmaPageWrite,
+    DmaChannel2Read,
+    DmaTerminalCount,
+    KeyboardDisabled,
+    KeyboardEnabled,
+    KeyboardReenabled,
+    KeyboardCleared,
+    KeyboardScancode,
+    KeyboardClockSetLow,
+    KeyboardClockSetHigh,
+    KeyboardClockFell,
+    KeyboardClockRose,
+    KeyboardResetDetected,
+    KeyboardClockLowTicks,
+    FdcWriteDor,
+    FdcWriteData,
+    FdcReadData,
+    FdcEarlyEop,
+    FdcResetStarted,
+    FdcResetComplete,
+    FdcCommandSpecify,
+    FdcCommandSenseInterrupt,
+    FdcCommandCheckDriveStatus,
+    FdcCommandCalibrate,
+    FdcCommandSeek,
+    FdcCommandReadData,
+    FdcCommandWriteData,
+    FdcSenseInterrupt,
+    FdcCalibrateComplete,
+    FdcSeekComplete,
+    FdcReadDataStart,
+    FdcWriteDataStart,
+    FdcWriteProtected,
+    FdcDmaStart,
+    FdcDmaComplete,
+    FdcIrqAlreadyPending,
+    CgaClockChangePending,
+    Count,
+};
+
+struct LogEventInfo
+{
+    LogEvent event;
+    LogDevice device;
+    LogLevel level;
+    const char* format; // std::format string over the record's arguments
+};
+
+inline constexpr std::array<LogEventInfo, static_cast<size_t>(LogEvent::Count)> kLogEvents{{
+    {LogEvent::InterruptAcknowledge, LogDevice::Bus, LogLevel::Debug, "Interrupt acknowledge: vector {:x}"},
+    {LogEvent::DmaPageWrite, LogDevice::Bus, LogLevel::Debug, "Write to DMA page register {}: {:02X}"},
+    {LogEvent::DmaChannel2Read, LogDevice::DMAC, LogLevel::Debug, "Channel 2 READ from address {:05X}"},
+    {LogEvent::DmaTerminalCount, LogDevice::DMAC, LogLevel::Info,
+        "Channel 2 terminal count reached at address [{:05X}], page [{:02X}], notifying FDC"},
+    {LogEvent::KeyboardDisabled, LogDevice::Bus, LogLevel::Info, "Disabling keyboard"},
+    {LogEvent::KeyboardEnabled, LogDevice::Bus, LogLevel::Info, "Enabling keyboard"},
+    {LogEvent::KeyboardReenabled, LogDevice::Bus, LogLevel::Info, "Re-enabling keyboard"},
+    {LogEvent::KeyboardCleared, LogDevice::Bus, LogLevel::Debug, "Clearing KSR & Interrupt"},
+    {LogEvent::KeyboardScancode, LogDevice::Keyboard, LogLevel::Debug, "Generated scancode: {:02X}"},
+    {LogEvent::KeyboardClockSetLow, LogDevice::Keyboard, LogLevel::Debug, "Setting clock line state to LOW"},
+    {LogEvent::KeyboardClockSetHigh, LogDevice::Keyboard, LogLevel::Debug, "Setting clock line state to HIGH"},
+    {LogEvent::KeyboardClockFell, LogDevice::Keyboard, LogLevel::Debug, "Clock line went low."},
+    {LogEvent::KeyboardClockRose, LogDevice::Keyboard, LogLevel::Debug, "Clock line went high."},
+    {LogEvent::KeyboardResetDetected, LogDevice::Keyboard, LogLevel::Info, "Detected reset condition on clock line."},
+    {LogEvent::KeyboardClockLowTicks, LogDevice::Keyboard, LogLevel::Trace, "Clock line low ticks: {}"},
+    {LogEvent::FdcWriteDor, LogDevice::FDC, LogLevel::Debug, "Write DOR: {:02X}"},
+    {LogEvent::FdcWriteData, LogDevice::FDC, LogLevel::Debug, "Write DATA: {:02X}"},
+    {LogEvent::FdcReadData, LogDevice::FDC, LogLevel::Debug, "Data register read -> {:02X}, {} bytes left"},
+    {LogEvent::FdcEarlyEop, LogDevice::FDC, LogLevel::Warning,
+        "DMA EOP signaled but {} bytes still left in operation!"},
+    {LogEvent::FdcResetStarted, LogDevice::FDC, LogLevel::Info, "Reset triggered via DOR. Beginning reset operation."},
+    {LogEvent::FdcResetComplete, LogDevice::FDC, LogLevel::Info, "Reset complete. Raising IRQ"},
+    {LogEvent::FdcCommandSpecify, LogDevice::FDC, LogLevel::Info, "Command SPECIFY"},
+    {LogEvent::FdcCommandSenseInterrupt, LogDevice::FDC, LogLevel::Info, "Command SENSE INTERRUPT"},
+    {LogEvent::FdcCommandCheckDriveStatus, LogDevice::FDC, LogLevel::Info, "Command CHECK DRIVE STATUS"},
+    {LogEvent::FdcCommandCalibrate, LogDevice::FDC, LogLevel::Info, "Command CALIBRATE"},
+    {LogEvent::FdcCommandSeek, LogDevice::FDC, LogLevel::Info, "Command SEEK"},
+    {LogEvent::FdcCommandReadData, LogDevice::FDC, LogLevel::Info, "Command READ DATA"},
+    {LogEvent::FdcCommandWriteData, LogDevice::FDC, LogLevel::Info, "Command WRITE DATA"},
+    {LogEvent::FdcSenseInterrupt, LogDevice::FDC, LogLevel::Debug,
+        "Handling Sense Interrupt. Returning ST0={:x} PCN={:x}"},
+    {LogEvent::FdcCalibrateComplete, LogDevice::FDC, LogLevel::Info, "Calibrate drive {} to cylinder 0, raising IRQ"},
+    {LogEvent::FdcSeekComplete, LogDevice::FDC, LogLevel::Info,
+        "Seek complete on drive {} to cylinder {}, raising IRQ"},
+    {LogEvent::FdcReadDataStart, LogDevice::FDC, LogLevel::Info,
+        "Read Data cmd for drive {}, C={}, H={}, S={}, N={}, EOT={}"},
+    {LogEvent::FdcWriteDataStart, LogDevice::FDC, LogLevel::Info,
+        "Write Data cmd for drive {}, C={}, H={}, S={}, N={}, EOT={}"},
+    {LogEvent::FdcWriteProtected, LogDevice::FDC, LogLevel::Warning, "Write Data error: disk is write-protected"},
+    {LogEvent::FdcDmaStart, LogDevice::FDC, LogLevel::Info, "Starting DMA operation: address {:08X}, word count: {}"},
+    {LogEvent::FdcDmaComplete, LogDevice::FDC, LogLevel::Info,
+        "DMA operation complete. EOP: {} Transferred {} bytes. Raising IRQ"},
+    {LogEvent::FdcIrqAlreadyPending, LogDevice::FDC, LogLevel::Error, "IRQ already pending when raising IRQ"},
+    {LogEvent::CgaClockChangePending, LogDevice::CGA, LogLevel::Debug, "Clock change pending"},
+}};
+
+// The table is indexed by event, so it has to stay in enum order.
+consteval bool logEventsInOrder() {
+    for (size_t i = 0; i < kLogEvents.size(); ++i) {
+        if (static_cast<size_t>(kLogEvents[i].event) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(logEventsInOrder(), "kLogEvents must list the events in LogEvent order");
+
+struct LogRecord
+{
+    static constexpr size_t kMaxArgs = 6;
+
+    uint64_t cycle;
+    LogEvent event;
+    uint32_t args[kMaxArgs];
+};
+
+// Device event log.
+//
+// Devices record fixed-size binary records into a ring buffer; nothing is formatted until a consumer drains the ring.
+// One thread (the emulation) logs and one thread drains, so the ring needs no locks: each side only ever writes its
+// own index. When the ring is full new records are dropped and counted rather than blocking the emulation. With
+// logging off, or an event below the current level, log() is a table lookup and a compare.
+class EventLog
+{
+public:
+    static constexpr size_t kCapacity = 4096;
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    // Records are stamped with the value this points at, normally the bus tick count.
+    void setClock(const uint64_t* clock) { clock_ = clock; }
+
+    void setLevel(const LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] bool enabled(const LogEvent event) const {
+        return kLogEvents[static_cast<size_t>(event)].level >= level_.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    void log(const LogEvent event, const Args... args) {
+        static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "Too many log arguments");
+        if (!enabled(event)) {
+            return;
+        }
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        records_[head & (kCapacity - 1)] = {clock_ != nullptr ? *clock_ : 0, event, {static_cast<uint32_t>(args)...}};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Pass every record logged so far to sink, oldest first. Returns the number of records drained.
+    template <typename Sink>
+    size_t drain(Sink&& sink) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        const size_t count = head - tail;
+        for (; tail != head; ++tail) {
+            sink(records_[tail & (kCapacity - 1)]);
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    // The number of records lost to a full ring.
+    [[nodiscard]] uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static const char* deviceName(const LogDevice device) {
+        switch (device) {
+            case LogDevice::Bus:
+                return "Bus";
+            case LogDevice::DMAC:
+                return "DMAC";
+            case LogDevice::FDC:
+                return "FDC";
+            case LogDevice::Keyboard:
+                return "Keyboard";
+            case LogDevice::CGA:
+                return "CGA";
+        }
+        return "?";
+    }
+
+    [[nodiscard]] static std::string format(const LogRecord& record) {
+        const LogEventInfo& info = kLogEvents[static_cast<size_t>(record.event)];
+        const uint32_t* a = record.args;
+        return std::format("[{}] {}: ", record.cycle, deviceName(info.device)) +
+            std::vformat(info.format, std::make_format_args(a[0], a[1], a[2], a[3], a[4], a[5]));
+    }
+
+private:
+    std::unique_ptr<LogRecord[]> records_{std::make_unique<LogRecord[]>(kCapacity)};
+    const uint64_t* clock_{nullptr};
+    std::atomic<LogLevel> level_{LogLevel::Off};
+    std::atomic<uint32_t> head_{0}; // Next record to write; only the logging thread stores it
+    std::atomic<uint32_t> tail_{0}; // Next record to read; only the draining thread stores it
+    std::atomic<uint64_t> dropped_{0};
+};
@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "Dmac.h"
+#include "EventLog.h"
 
 // -------------------------------- I/O ports ---------------------------------
 static constexpr uint16_t PORT_DOR = 2; // Digital Output Register (write)
@@ -150,6 +151,10 @@ public:
         pic_ = p;
     }
 
+    void attachLog(EventLog* log) {
+        log_ = log;
+    }
+
     // Insert/eject a disk image (raw CHS-linear).
     bool loadDisk(DriveIndex drv, const std::vector<uint8_t>& bytes, bool writeProtected = false) {
         if (drv >= 4) {
@@ -198,10 +203,10 @@ public:
         //std::cout << std::format("FDC: Write to port: {:0X} value: {:02X}", port, val) << std::endl;
         switch (port) {
             case PORT_DOR:
-                std::cout << std::format("FDC: Write DOR: {:02X}", val) << std::endl;
+                log(LogEvent::FdcWriteDor, val);
                 return writeDOR(val);
             case PORT_DATA:
-                std::cout << std::format("FDC: Write DATA: {:02X}", val) << std::endl;
+                log(LogEvent::FdcWriteData, val);
                 return writeDATA(val);
             default:
                 break;
@@ -219,15 +224,17 @@ public:
             return 0xFF;
         }
         const auto& d = drives_[sel_];
-        const uint32_t bps = sectorSizeFromN(op_.N);
-        const size_t off = chsToOffset(d, op_.C, op_.H, op_.S, bps);
-        if (off == SIZE_MAX) {
+        if (!dma_run_.valid || dma_run_.drive != sel_ || dma_run_.image != d.image.data() ||
+            dma_run_.image_size != d.image.size()) {
+            dma_run_ = {true, sel_, d.image.data(), d.image.size(),
+                        chsToOffset(d, op_.C, op_.H, op_.S, sectorSizeFromN(op_.N))};
+        }
+        if (dma_run_.offset == SIZE_MAX) {
             return 0xFF;
         }
 
-        const size_t addr = off + dma_byte_index_;
-        //std::cout << "offset: " << addr;
-        const uint8_t v = (addr < d.image.size()) ? d.image[addr] : 0xFF;
+        const size_t addr = dma_run_.offset + dma_byte_index_;
+        const uint8_t v = (addr < dma_run_.image_size) ? dma_run_.image[addr] : 0xFF;
         advanceByte();
         return v;
     }
@@ -252,7 +259,7 @@ public:
     void dmaDeviceEOP() {
 
         if (bytes_left_ > 0) {
-            std::cout << std::format("FDC: DMA EOP signaled but {} bytes still left in operation!\n", bytes_left_);
+            log(LogEvent::FdcEarlyEop, bytes_left_);
         }
 
         // Complete immediately if we're mid-op
@@ -306,6 +313,61 @@ public:
         resetInternal(false);
     }
 
+    // ----------------------------- Save states ------------------------------
+    // Save or load the controller and drives, including the disk images (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        for (Drive& d : drives_) {
+            ar(d.error_signal);
+            ar(d.cylinder);
+            ar(d.head);
+            ar(d.sector);
+            ar(d.max_cylinders);
+            ar(d.max_heads);
+            ar(d.max_sectors);
+            ar(d.ready);
+            ar(d.motor_on);
+            ar(d.positioning);
+            ar(d.have_disk);
+            ar(d.write_protected);
+            ar.vector(d.image);
+        }
+        ar(dor_);
+        ar(busy_);
+        ar(mrq_);
+        ar(dio_result_);
+        ar(sel_);
+        ar(cur_cmd_);
+        ar(expected_bytes_);
+        ar.deque(cmd_in_);
+        ar.deque(fifo_out_);
+        // Op field by field, so that its padding isn't saved.
+        ar(op_.kind);
+        ar(op_.dma_mode);
+        ar(op_.ticks);
+        ar(op_.C);
+        ar(op_.H);
+        ar(op_.S);
+        ar(op_.N);
+        ar(op_.EOT);
+        ar(bytes_left_);
+        ar(bytes_transferred_);
+        ar(dma_byte_index_);
+        ar(dma_start_address_);
+        ar(dma_word_count_);
+        ar(drq_);
+        ar(st0_);
+        ar(st1_);
+        ar(st2_);
+        ar(pcn_);
+        ar(irq_pending_);
+        ar(resetting_);
+        if constexpr (Archive::kLoading) {
+            // The images may have moved.
+            dma_run_ = {};
+        }
+    }
+
 private:
     struct Op
     {
@@ -315,9 +377,28 @@ private:
         uint8_t C = 0, H = 0, S = 1, N = 2, EOT = 0;
     };
 
+    template <typename... Args>
+    void log(const LogEvent event, const Args... args) {
+        if (log_ != nullptr) {
+            log_->log(event, args...);
+        }
+    }
+
+    // Where a READ DATA operation's bytes start in the image. The sectors it covers are contiguous, so the offset is
+    // found on the first byte rather than on every byte, and found again if the selected drive or its disk changes.
+    struct DmaRun
+    {
+        bool valid{false};
+        uint8_t drive{0};
+        const uint8_t* image{nullptr};
+        size_t image_size{0};
+        size_t offset{SIZE_MAX};
+    };
+
     std::array<Drive, 4> drives_{};
     DMAC* dmac_{};
     PIC* pic_{};
+    EventLog* log_{};
 
     // Controller regs/state
     uint8_t dor_ = 0;
@@ -339,6 +420,7 @@ private:
     size_t bytes_left_{0};
     size_t bytes_transferred_{0};
     size_t dma_byte_index_{0};
+    DmaRun dma_run_{};
     uint32_t dma_start_address_{0};
     uint16_t dma_word_count_{0};
     bool drq_{false};
@@ -366,6 +448,7 @@ private:
         bytes_left_ = 0;
         bytes_transferred_ = 0;
         dma_byte_index_ = 0;
+        dma_run_ = {};
         drq_ = false;
         irq_pending_ = false;
         if (pic_) {
@@ -458,7 +541,7 @@ private:
             busy_ = false;
             cur_cmd_ = Command::None;
         }
-        std::cout << std::format("FDC: Data register read -> {:02X}, {} bytes left", v, fifo_out_.size()) << std::endl;
+        log(LogEvent::FdcReadData, v, fifo_out_.size());
         return v;
     }
 
@@ -466,7 +549,7 @@ private:
         dor_ = v;
         if ((v & DOR_RESET_NOT) == 0) {
             // Reset when bit 2 is 0
-            std::cout << "FDC: Reset triggered via DOR. Beginning reset operation." << std::endl;
+            log(LogEvent::FdcResetStarted);
 
             op_ = Op{OpKind::Reset, 0};
             resetting_ = true;
@@ -502,37 +585,37 @@ private:
     void decodeOpcode(const uint8_t op) {
         switch (op & 0x1F) {
             case OPC_SPECIFY:
-                std::cout << "FDC: Command SPECIFY\n";
+                log(LogEvent::FdcCommandSpecify);
                 cur_cmd_ = Command::Specify;
                 expected_bytes_ = 3;
                 break;
             case OPC_SENSE_INT:
-                std::cout << "FDC: Command SENSE INTERRUPT\n";
+                log(LogEvent::FdcCommandSenseInterrupt);
                 cur_cmd_ = Command::SenseInt;
                 expected_bytes_ = 1;
                 break;
             case OPC_CHECK_STATUS:
-                std::cout << "FDC: Command CHECK DRIVE STATUS\n";
+                log(LogEvent::FdcCommandCheckDriveStatus);
                 cur_cmd_ = Command::CheckDriveStatus;
                 expected_bytes_ = 2;
                 break;
             case OPC_CALIBRATE:
-                std::cout << "FDC: Command CALIBRATE\n";
+                log(LogEvent::FdcCommandCalibrate);
                 cur_cmd_ = Command::Calibrate;
                 expected_bytes_ = 2;
                 break;
             case OPC_SEEK:
-                std::cout << "FDC: Command SEEK\n";
+                log(LogEvent::FdcCommandSeek);
                 cur_cmd_ = Command::Seek;
                 expected_bytes_ = 3;
                 break;
             case OPC_READ_DATA:
-                std::cout << "FDC: Command READ DATA\n";
+                log(LogEvent::FdcCommandReadData);
                 cur_cmd_ = Command::ReadData;
                 expected_bytes_ = 9;
                 break;
             case OPC_WRITE_DATA:
-                std::cout << "FDC: Command WRITE DATA\n";
+                log(LogEvent::FdcCommandWriteData);
                 cur_cmd_ = Command::WriteData;
                 expected_bytes_ = 9;
                 break;
@@ -625,8 +708,7 @@ private:
     }
 
     void handleSenseInt() {
-        std::cout << "FDC: Handling Sense Interrupt. Returning ST0=" << std::hex
-            << static_cast<int>(st0_) << " PCN=" << static_cast<int>(pcn_) << std::dec << "\n";
+        log(LogEvent::FdcSenseInterrupt, st0_, pcn_);
 
         setSenseResult(InterruptCode::Polling, sel_, drives_[sel_].cylinder);
         setIRQ(false);
@@ -649,7 +731,7 @@ private:
         sel_ = drv;
         drives_[drv].cylinder = 0;
         setSenseResult(InterruptCode::Normal, drv, 0);
-        std::cout << "FDC: Calibrate drive " << static_cast<int>(drv) << " to cylinder 0, raising IRQ\n";
+        log(LogEvent::FdcCalibrateComplete, drv);
         setIRQ(true);
         busy_ = false;
         mrq_ = true;
@@ -670,8 +752,7 @@ private:
         auto& d = drives_[sel_];
         d.cylinder = op_.C;
         setSenseResult(InterruptCode::Normal, sel_, d.cylinder);
-        std::cout << "FDC: Seek complete on drive " << static_cast<int>(sel_)
-            << " to cylinder " << static_cast<int>(d.cylinder) << ", raising IRQ\n";
+        log(LogEvent::FdcSeekComplete, sel_, d.cylinder);
         setIRQ(true);
         op_ = Op{};
         busy_ = false;
@@ -680,7 +761,7 @@ private:
 
     void completeReset() {
         reset();
-        std::cout << "FDC: Reset complete. Raising IRQ" << std::endl;
+        log(LogEvent::FdcResetComplete);
         setIRQ(true);
         op_ = Op{};
         busy_ = false;
@@ -697,14 +778,7 @@ private:
         const uint8_t drv = DH & 3;
         const uint8_t headReq = (DH >> 2) & 1;
 
-        std::cout << std::format(
-            "FDC: Read Data cmd for drive {}, C={}, H={}, S={}, N={}, EOT={}\n",
-            static_cast<int>(drv),
-            static_cast<int>(C),
-            static_cast<int>(H),
-            static_cast<int>(S),
-            static_cast<int>(N),
-            static_cast<int>(EOT));
+        log(LogEvent::FdcReadDataStart, drv, C, H, S, N, EOT);
 
         sel_ = drv;
         const auto& d = drives_[drv];
@@ -734,14 +808,7 @@ private:
         const uint8_t headReq = (DH >> 2) & 1;
         sel_ = drv;
 
-        std::cout << std::format(
-            "FDC: Write Data cmd for drive {}, C={}, H={}, S={}, N={}, EOT={}\n",
-            static_cast<int>(drv),
-            static_cast<int>(C),
-            static_cast<int>(H),
-            static_cast<int>(S),
-            static_cast<int>(N),
-            static_cast<int>(EOT));
+        log(LogEvent::FdcWriteDataStart, drv, C, H, S, N, EOT);
 
         const auto& d = drives_[drv];
         if (!d.have_disk || !d.ready || !d.motor_on) {
@@ -749,7 +816,7 @@ private:
             return;
         }
         if (d.write_protected) {
-            std::cout << "FDC: Write Data error: disk is write-protected\n";
+            log(LogEvent::FdcWriteProtected);
             endError(C, H, S, N, true, true);
             return;
         }
@@ -825,13 +892,12 @@ private:
                   const uint8_t EOT, const uint32_t bps) {
         op_ = {kind, true, 0, C, H, S, N, EOT};
         dma_byte_index_ = 0;
+        dma_run_ = {};
 
         dma_start_address_ = dmac_->getAddress(2);
         dma_word_count_ = dmac_->getWordCount(2) + 1; // +1 because count is words-1
 
-        std::cout << std::format("FDC: Starting DMA operation: address {:08X}, word count: {}\n",
-                                 dma_start_address_,
-                                 dma_word_count_);
+        log(LogEvent::FdcDmaStart, dma_start_address_, dma_word_count_);
 
         bytes_left_ = static_cast<size_t>(bps) * static_cast<size_t>((EOT >= S) ? (EOT - S + 1) : 1);
         bytes_transferred_ = 0;
@@ -891,12 +957,10 @@ private:
         op_ = Op{};
         d.sector = std::min<uint8_t>(lastR, d.max_sectors);
         // Signal completion via IRQ6
-        std::cout << std::format("FDC: DMA operation complete. EOP: {} Transferred {} bytes. Raising IRQ\n",
-                                 eop,
-                                 bytes_transferred_);
+        log(LogEvent::FdcDmaComplete, eop, bytes_transferred_);
 
         if (irq_pending_) {
-            std::cerr << "FDC: ERROR: IRQ already pending when raising IRQ\n";
+            log(LogEvent::FdcIrqAlreadyPending);
         }
         setIRQ(true);
     }
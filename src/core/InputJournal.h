@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// Everything that reaches the machine from outside while it runs.
+enum class InputKind : uint8_t
+{
+    ScanCode, // value is the scancode
+    InsertDisk, // value is the drive, disk the index of the image (see InputJournal::disk())
+    EjectDisk, // value is the drive
+    Reset, // Machine reset, which starts the cycle count again from 0
+    ResetCpu, // CPU reset, which does too
+};
+
+struct InputEvent
+{
+    uint64_t cycle; // CPU cycle at which the input took effect, counted from the last reset
+    InputKind kind;
+    uint8_t value;
+    bool write_protected; // For InsertDisk
+    uint32_t disk; // For InsertDisk
+};
+
+// A recording of a run: the save state it started from and every input, stamped with the CPU cycle it took effect
+// on. Emulation is deterministic, so loading the start state and applying each input at its cycle reproduces the run
+// exactly, however fast or slow it is replayed. Machine records into a journal and replays one; see
+// BasicMachine::startRecording() and BasicMachine::startReplay().
+//
+// The journal also keeps the cycle recording stopped on and a hash of the state there, so a replay can tell whether
+// it arrived where the recording did.
+//
+// File layout, in host byte order like save states:
+//
+//   header   "XTCEJRNL", then the format version (uint32)
+//   uint64   end cycle, then the end state hash (uint64)
+//   block    start state (uint32 size, bytes)
+//   uint32   number of disk images, then each as a block
+//   uint32   number of events, then each as cycle (uint64), kind, value, write_protected (uint8 each) and disk
+//            (uint32)
+class InputJournal
+{
+public:
+    static constexpr char kMagic[8] = {'X', 'T', 'C', 'E', 'J', 'R', 'N', 'L'};
+    static constexpr uint32_t kVersion = 1;
+
+    // FNV-1a over a save state, for comparing machine states cheaply.
+    [[nodiscard]] static uint64_t stateHash(const std::span<const uint8_t> state) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (const uint8_t b : state) {
+            hash = (hash ^ b) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    // Start a new recording from this save state.
+    void begin(const std::span<const uint8_t> start_state) {
+        start_state_.assign(start_state.begin(), start_state.end());
+        disks_.clear();
+        events_.clear();
+        end_cycle_ = 0;
+        end_hash_ = 0;
+    }
+
+    void addScanCode(const uint64_t cycle, const uint8_t scancode) {
+        events_.push_back({cycle, InputKind::ScanCode, scancode, false, 0});
+    }
+
+    void addInsertDisk(const uint64_t cycle, const uint8_t drive, const std::vector<uint8_t>& image,
+                       const bool write_protected) {
+        // The same image is usually inserted again and again; store it once.
+        auto it = std::ranges::find(disks_, image);
+        if (it == disks_.end()) {
+            it = disks_.insert(disks_.end(), image);
+        }
+        events_.push_back({cycle, InputKind::InsertDisk, drive, write_protected,
+                           static_cast<uint32_t>(it - disks_.begin())});
+    }
+
+    void addEjectDisk(const uint64_t cycle, const uint8_t drive) {
+        events_.push_back({cycle, InputKind::EjectDisk, drive, false, 0});
+    }
+
+    void addReset(const uint64_t cycle) {
+        events_.push_back({cycle, InputKind::Reset, 0, false, 0});
+    }
+
+    void addResetCpu(const uint64_t cycle) {
+        events_.push_back({cycle, InputKind::ResetCpu, 0, false, 0});
+    }
+
+    [[nodiscard]] static bool isReset(const InputEvent& e) {
+        return e.kind == InputKind::Reset || e.kind == InputKind::ResetCpu;
+    }
+
+    // Forget the inputs after cycle since the last reset, when the machine has gone back to it.
+    void discardAfter(const uint64_t cycle) {
+        const auto since_reset = std::find_if(events_.rbegin(), events_.rend(), isReset).base();
+        const auto after = std::find_if(since_reset, events_.end(),
+                                        [cycle](const InputEvent& e) { return e.cycle > cycle; });
+        events_.erase(after, events_.end());
+    }
+
+    // Finish the recording at cycle, in the state with this hash.
+    void end(const uint64_t cycle, const uint64_t hash) {
+        end_cycle_ = cycle;
+        end_hash_ = hash;
+    }
+
+    [[nodiscard]] const std::vector<uint8_t>& startState() const { return start_state_; }
+    [[nodiscard]] const std::vector<InputEvent>& events() const { return events_; }
+    [[nodiscard]] const std::vector<uint8_t>& disk(const uint32_t index) const { return disks_[index]; }
+    [[nodiscard]] uint64_t endCycle() const { return end_cycle_; }
+    [[nodiscard]] uint64_t endHash() const { return end_hash_; }
+
+    void write(std::vector<uint8_t>& out) const {
+        out.clear();
+        append(out, kMagic, sizeof(kMagic));
+        appendValue(out, kVersion);
+        appendValue(out, end_cycle_);
+        appendValue(out, end_hash_);
+        appendBlock(out, start_state_);
+        appendValue(out, static_cast<uint32_t>(disks_.size()));
+        for (const auto& d : disks_) {
+            appendBlock(out, d);
+        }
+        appendValue(out, static_cast<uint32_t>(events_.size()));
+        for (const auto& e : events_) {
+            appendValue(out, e.cycle);
+            appendValue(out, e.kind);
+            appendValue(out, e.value);
+            appendValue(out, e.write_protected);
+            appendValue(out, e.disk);
+        }
+    }
+
+    // Replace the journal with one written by write(). Returns false, leaving the journal empty, if data isn't a
+    // valid journal of this version.
+    bool read(const std::span<const uint8_t> data) {
+        Reader r{data};
+        char magic[sizeof(kMagic)]{};
+        uint32_t version = 0;
+        r.read(magic, sizeof(magic));
+        r.value(version);
+        if (!r.ok || !std::equal(std::begin(magic), std::end(magic), std::begin(kMagic)) || version != kVersion) {
+            begin({});
+            return false;
+        }
+        r.value(end_cycle_);
+        r.value(end_hash_);
+        r.block(start_state_);
+        uint32_t count = 0;
+        r.value(count);
+        disks_.clear();
+        for (uint32_t i = 0; r.ok && i < count; ++i) {
+            r.block(disks_.emplace_back());
+        }
+        r.value(count);
+        events_.clear();
+        for (uint32_t i = 0; r.ok && i < count; ++i) {
+            InputEvent e{};
+            r.value(e.cycle);
+            r.value(e.kind);
+            r.value(e.value);
+            r.value(e.write_protected);
+            r.value(e.disk);
+            events_.push_back(e);
+        }
+        if (!r.ok || r.cursor != data.size() || !valid()) {
+            begin({});
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Reader
+    {
+        std::span<const uint8_t> data;
+        size_t cursor{0};
+        bool ok{true};
+
+        void read(void* out, const size_t size) {
+            if (!ok || size > data.size() - cursor) {
+                ok = false;
+                return;
+            }
+            std::memcpy(out, data.data() + cursor, size);
+            cursor += size;
+        }
+
+        template <typename T>
+        void value(T& v) {
+            read(&v, sizeof(T));
+        }
+
+        void block(std::vector<uint8_t>& v) {
+            uint32_t size = 0;
+            value(size);
+            if (!ok || size > data.size() - cursor) {
+                ok = false;
+                return;
+            }
+            v.assign(data.begin() + static_cast<std::ptrdiff_t>(cursor),
+                     data.begin() + static_cast<std::ptrdiff_t>(cursor + size));
+            cursor += size;
+        }
+    };
+
+    static void append(std::vector<uint8_t>& out, const void* data, const size_t size) {
+        const size_t offset = out.size();
+        out.resize(offset + size);
+        std::memcpy(&out[offset], data, size);
+    }
+
+    template <typename T>
+    static void appendValue(std::vector<uint8_t>& out, const T value) {
+        append(out, &value, sizeof(T));
+    }
+
+    static void appendBlock(std::vector<uint8_t>& out, const std::vector<uint8_t>& block) {
+        appendValue(out, static_cast<uint32_t>(block.size()));
+        append(out, block.data(), block.size());
+    }
+
+    // Events in cycle order between resets, of known kinds, referring to disks that exist.
+    [[nodiscard]] bool valid() const {
+        uint64_t cycle = 0;
+        for (const auto& e : events_) {
+            if (e.cycle < cycle || e.kind > InputKind::ResetCpu ||
+                (e.kind == InputKind::InsertDisk && e.disk >= disks_.size())) {
+                return false;
+            }
+            cycle = isReset(e) ? 0 : e.cycle;
+        }
+        return true;
+    }
+
+    std::vector<uint8_t> start_state_;
+    std::vector<std::vector<uint8_t>> disks_;
+    std::vector<InputEvent> events_;
+    uint64_t end_cycle_{0};
+    uint64_t end_hash_{0};
+};
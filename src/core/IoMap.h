@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// A device's port handlers. The port passed in is the 10-bit decoded port number.
+struct IoHandler
+{
+    void* context{nullptr};
+    uint8_t (*read)(void* context, uint16_t port){nullptr};
+    void (*write)(void* context, uint16_t port, uint8_t data){nullptr};
+    // Match the whole port address instead of the low 10 bits, so the port doesn't alias above 0x3FF.
+    bool full_decode{false};
+};
+
+// I/O port dispatch. The PC/XT decodes only the low 10 address bits on the ISA bus, so every port resolves to one of
+// 1024 table entries in a single lookup. Handlers registered with full_decode only answer when no address bit above
+// A9 is set, for registers matched against the whole port number. Ports without a handler read as open bus and ignore
+// writes.
+//
+// Per-port access counts are kept while counting is enabled, for the profiling view.
+class IoMap
+{
+public:
+    static constexpr std::size_t kPortCount = 1024;
+    static constexpr uint16_t kPortMask = kPortCount - 1;
+
+    IoMap() {
+        clear();
+    }
+
+    void clear() {
+        handlers_.fill({});
+        resetCounts();
+    }
+
+    // Route count ports starting at first to the handler, replacing whatever was there.
+    bool mapPorts(const uint16_t first, const uint16_t count, const IoHandler& handler) {
+        if (first >= kPortCount || count > kPortCount - first) {
+            return false;
+        }
+        for (uint16_t port = first; port < first + count; ++port) {
+            handlers_[port] = handler;
+        }
+        return true;
+    }
+
+    [[nodiscard]] uint8_t read(const uint32_t address) {
+        const auto port = static_cast<uint16_t>(address & kPortMask);
+        if (counting_) {
+            ++read_counts_[port];
+        }
+        const IoHandler& handler = handlers_[port];
+        if (handler.read != nullptr && decodes(handler, address)) {
+            return handler.read(handler.context, port);
+        }
+        return 0xFF;
+    }
+
+    void write(const uint32_t address, const uint8_t data) {
+        const auto port = static_cast<uint16_t>(address & kPortMask);
+        if (counting_) {
+            ++write_counts_[port];
+        }
+        const IoHandler& handler = handlers_[port];
+        if (handler.write != nullptr && decodes(handler, address)) {
+            handler.write(handler.context, port, data);
+        }
+    }
+
+    [[nodiscard]] bool isMapped(const uint16_t port) const {
+        const IoHandler& handler = handlers_[port & kPortMask];
+        return handler.read != nullptr || handler.write != nullptr;
+    }
+
+    // The handler a read or write of this address reaches, or nullptr if the address isn't decoded.
+    [[nodiscard]] const IoHandler* handler(const uint32_t address) const {
+        const IoHandler& handler = handlers_[address & kPortMask];
+        return decodes(handler, address) ? &handler : nullptr;
+    }
+
+    void setCounting(const bool counting) { counting_ = counting; }
+    [[nodiscard]] bool isCounting() const { return counting_; }
+
+    void resetCounts() {
+        read_counts_.fill(0);
+        write_counts_.fill(0);
+    }
+
+    [[nodiscard]] uint64_t readCount(const uint16_t port) const { return read_counts_[port & kPortMask]; }
+    [[nodiscard]] uint64_t writeCount(const uint16_t port) const { return write_counts_[port & kPortMask]; }
+
+private:
+    [[nodiscard]] static bool decodes(const IoHandler& handler, const uint32_t address) {
+        return !handler.full_decode || address <= kPortMask;
+    }
+
+    bool counting_{false};
+    std::array<IoHandler, kPortCount> handlers_;
+    std::array<uint64_t, kPortCount> read_counts_;
+    std::array<uint64_t, kPortCount> write_counts_;
+};
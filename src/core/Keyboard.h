@@ -2,8 +2,8 @@
 #define SDL_MIN_KEYBOARD_H
 
 #include <cstdint>
-#include <format>
-#include <iostream>
+
+#include "EventLog.h"
 
 class Keyboard
 {
@@ -16,20 +16,24 @@ public:
         reset();
     }
 
+    void attachLog(EventLog* log) {
+        log_ = log;
+    }
+
     void setClockLineState(const bool state) {
-        std::cout << std::format("Keyboard: Setting clock line state to {}\n", state ? "HIGH" : "LOW");
+        log(state ? LogEvent::KeyboardClockSetHigh : LogEvent::KeyboardClockSetLow);
         if (!state && clock_line_state_) {
             // Clock line went high->low
-            std::cout << "Keyboard: Clock line went low." << std::endl;
+            log(LogEvent::KeyboardClockFell);
             resetting_ = true;
             clock_line_low_ticks_ = 0;
         }
         else if (state && !clock_line_state_) {
             // Clock line went low->high
-            std::cout << "Keyboard: Clock line went high." << std::endl;
+            log(LogEvent::KeyboardClockRose);
             if (clock_line_low_ticks_ >= kResetTicks) {
                 // Clock line was held low long enough to trigger reset.
-                std::cout << "Keyboard: Detected reset condition on clock line.\n";
+                log(LogEvent::KeyboardResetDetected);
                 resetting_ = true;
             }
             clock_line_high_ticks_ = 0;
@@ -48,7 +52,7 @@ public:
     void tick() {
         if (!clock_line_state_) {
             clock_line_low_ticks_++;
-            std::cout << std::format("Keyboard: Clock line low ticks: {}\n", clock_line_low_ticks_);
+            log(LogEvent::KeyboardClockLowTicks, clock_line_low_ticks_);
         }
         else {
             clock_line_high_ticks_++;
@@ -60,6 +64,16 @@ public:
         }
     }
 
+    // Save or load the keyboard's state (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar(clock_line_state_);
+        ar(send_reset_);
+        ar(resetting_);
+        ar(clock_line_low_ticks_);
+        ar(clock_line_high_ticks_);
+    }
+
     bool getScanCode(uint8_t& byte) {
         if (send_reset_) {
             byte = kResetByte;
@@ -70,6 +84,14 @@ public:
     }
 
 private:
+    template <typename... Args>
+    void log(const LogEvent event, const Args... args) {
+        if (log_ != nullptr) {
+            log_->log(event, args...);
+        }
+    }
+
+    EventLog* log_{nullptr};
     bool clock_line_state_{true};
     bool send_reset_{false};
     bool resetting_{false};
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "LoopEvaluator.h"
+#include "StateBuffer.h"
+
+// How the CPU treats busy-wait loops, such as a wait for the BIOS tick count or for the CGA's retrace.
+enum class LoopSkipMode
+{
+    Off,
+    On, // Skip whole periods of a detected loop in one step
+    Verify, // Detect loops and keep stepping them, checking each skip against what stepping actually did
+};
+
+struct LoopSkipStats
+{
+    uint64_t skips{0}; // Skips made (On) or checked (Verify)
+    uint64_t skippedCycles{0};
+    uint64_t mismatches{0}; // Verify only: skips that would not have matched stepping
+};
+
+// Period finder for busy-wait loops.
+//
+// The CPU reports every instruction boundary. A jump back by at most kMaxLoopBytes makes its target a candidate head,
+// and from then on the detector records the offsets of the instructions run and the CPU's bus operations, and the CPU
+// reports each visit to the head with its state serialized: the registers, the flag latches, the temporaries and the
+// data latch, which the next instructions set before they use them, are left out, and the bus adds its timing state
+// (see Bus::appendTimingState()). A loop that counts or walks a pointer while it waits for a device or a memory word
+// changes its registers on every pass, but the rest of its state comes back: the visit that repeats an earlier one
+// ends a period, which may span several passes when the loop and the DRAM refresh have different rhythms.
+//
+// The CPU checks the period with LoopEvaluator, which must reproduce the registers the period left from the ones it
+// started with and the data it read, then evaluates the periods that follow from the current registers. Every period
+// that takes the same path runs exactly like the recorded one, since the bus cycles and microcode of the instructions
+// LoopEvaluator knows depend on the data only through the branches taken. Only memory and device registers whose
+// value is known until the period reads them (Bus::stableRead()) can be read, and writes end recording: the loop has
+// to wait for an interrupt or for a device to change, and the skip stops short of both.
+class LoopDetector
+{
+public:
+    enum class OpKind : uint8_t
+    {
+        Access, // Bus::startAccess()
+        PassiveOrHalt, // Bus::setPassiveOrHalt()
+        Read, // Bus::read()
+    };
+
+    struct BusOp
+    {
+        uint64_t cycle; // CPU cycle the operation was issued in; for a period, cycles into it
+        uint32_t address; // Physical address or port, for Access
+        OpKind kind;
+        uint8_t type; // IOType, for Access and for a Read that completes a data access; 0 for other Reads
+        uint8_t value; // The passive/halt flag, or the byte read
+    };
+
+    typedef LoopEvaluator::Registers Registers;
+
+    static constexpr uint16_t kMaxLoopBytes = 256; // The furthest back a jump to a head may go
+    static constexpr size_t kMaxVisits = 64; // Visits to a head without finding a period before giving up on it
+    static constexpr uint64_t kMaxSpan = 4096; // Cycles of recording without finding a period, likewise
+    static constexpr uint64_t kCooldownCycles = 65536; // How long a head that gave no period is left alone
+    static constexpr size_t kCooldowns = 4;
+
+    // A run from one visit to the head to a later one that starts in the same state.
+    struct Period
+    {
+        uint32_t length{0};
+        std::vector<BusOp> ops; // cycle is relative to the start of the period
+        std::vector<uint16_t> path; // Offsets into CS of the instructions run, in order
+        std::vector<LoopEvaluator::Read> reads; // The data bytes read, in order
+        std::vector<uint32_t> readCycles; // Per read, cycles into the period of the bus read
+        // True if the last bus cycle started in the period is a prefetch, which leaves the same address on the bus
+        // every time. Otherwise data addresses have to stay the same too.
+        bool addressesMayMove{false};
+        Registers registers{}; // At the start of the period
+        Registers endRegisters{};
+        StateBuffer state; // At both ends
+    };
+
+    void setMode(const LoopSkipMode mode) {
+        mode_ = mode;
+        reset();
+    }
+
+    LoopSkipMode mode() const { return mode_; }
+    const LoopSkipStats& stats() const { return stats_; }
+
+    // Forget everything, including cooldowns. Called whenever the machine may have changed behind the CPU's back.
+    void reset() {
+        recording_ = false;
+        verifying_ = false;
+        checked_ = false;
+        have_last_ = false;
+        visits_.clear();
+        ops_.clear();
+        path_.clear();
+        for (Cooldown& c : cooldowns_) {
+            c.until = 0;
+        }
+    }
+
+    bool isRecording() const { return recording_; }
+    bool isVerifying() const { return verifying_; }
+
+    // Scratch buffer for the state at the current head.
+    StateBuffer& state() { return state_; }
+
+    const Period& period() const { return period_; }
+
+    // Whether the CPU has checked the current period with the evaluator. A period of the same length and path found
+    // later in the same recording is the same loop and needs no second check.
+    bool isPeriodChecked() const { return checked_; }
+    void periodChecked() { checked_ = true; }
+
+    // Called at every instruction boundary. Returns true at a visit to the head, where the CPU calls visit() (or
+    // finishVerification(), while verifying) with its state.
+    bool atBoundary(const uint16_t cs, const uint16_t ip, const uint64_t cycle) {
+        const bool jumpedBack = have_last_ && cs == last_cs_ && ip < last_ip_ && last_ip_ - ip <= kMaxLoopBytes;
+        last_cs_ = cs;
+        last_ip_ = ip;
+        have_last_ = true;
+        if (verifying_) {
+            return cycle >= verify_end_;
+        }
+        if (recording_) {
+            if (cs != cs_) {
+                // A far jump or an interrupt: the loop is left, but no worse for it.
+                stopRecording();
+            }
+            else if (ip == head_) {
+                return true;
+            }
+            else if (cycle - visits_.front().cycle > kMaxSpan) {
+                giveUp(cycle);
+            }
+            else {
+                path_.push_back(ip);
+                return false;
+            }
+        }
+        if (!jumpedBack || isCoolingDown(cs, ip, cycle)) {
+            return false;
+        }
+        recording_ = true;
+        checked_ = false;
+        cs_ = cs;
+        head_ = ip;
+        return true;
+    }
+
+    // Record a visit to the head with the state just written into state(). window is the number of ticks INTR is
+    // known to stay the same for. Returns the period ending here, or nullptr if this visit doesn't repeat one.
+    const Period* visit(const uint64_t cycle, const Registers& registers, const uint32_t window) {
+        const uint64_t hash = state_.hash();
+        for (size_t i = visits_.size(); i-- > 0;) {
+            const Visit& v = visits_[i];
+            if (v.hash == hash && v.state == state_) {
+                if (v.window < cycle - v.cycle) {
+                    break;
+                }
+                takePeriod(i, cycle, registers);
+                // Keep the visits from the period's start on, which later visits may repeat in turn.
+                trim(i);
+                addVisit(cycle, registers, window, hash);
+                return &period_;
+            }
+        }
+        if (visits_.size() >= kMaxVisits) {
+            giveUp(cycle);
+            return nullptr;
+        }
+        if (!visits_.empty()) {
+            path_.push_back(head_);
+        }
+        addVisit(cycle, registers, window, hash);
+        return nullptr;
+    }
+
+    // The CPU found that the period isn't a loop it can skip. Leave its head alone for a while.
+    void reject(const uint64_t cycle) {
+        giveUp(cycle);
+    }
+
+    // Called after the CPU skipped the given number of periods.
+    void skipped(const uint32_t periods) {
+        ++stats_.skips;
+        stats_.skippedCycles += static_cast<uint64_t>(periods) * period_.length;
+        stopRecording();
+    }
+
+    // Verify mode: instead of skipping, step the periods and compare what stepping did with the recorded period moved
+    // to the addresses in reads, the data bytes the evaluated periods read in order. The CPU finishes the
+    // verification at the first head visit on or after the cycle the skip would have ended on.
+    void beginVerification(const uint64_t cycle, const uint32_t periods, const Registers& registers,
+        std::vector<LoopEvaluator::Read>& reads) {
+        recording_ = true;
+        verifying_ = true;
+        verify_start_ = cycle;
+        verify_end_ = cycle + static_cast<uint64_t>(periods) * period_.length;
+        verify_periods_ = periods;
+        verify_registers_ = registers;
+        verify_next_ = 0;
+        verify_read_ = 0;
+        verify_match_ = true;
+        std::swap(verify_reads_, reads);
+    }
+
+    // The registers the skip being verified would have left.
+    const Registers& verifiedRegisters() const { return verify_registers_; }
+
+    // stateMatches is the CPU's comparison of its state at the head with the period's. Returns false on a mismatch.
+    bool finishVerification(const uint64_t cycle, const bool stateMatches) {
+        const bool match = verify_match_ && stateMatches && cycle == verify_end_ &&
+            verify_next_ == static_cast<uint64_t>(verify_periods_) * period_.ops.size();
+        ++stats_.skips;
+        stats_.skippedCycles += verify_end_ - verify_start_;
+        if (!match) {
+            reportMismatch(cycle);
+        }
+        stopRecording();
+        return match;
+    }
+
+    void recordAccess(const uint64_t cycle, const uint8_t type, const uint32_t address) {
+        // Only prefetches and reads of memory and ports (IOType 4, 5 and 1) can be part of the loop.
+        if (type != 1 && type != 4 && type != 5) {
+            abort(cycle);
+            return;
+        }
+        const BusOp op = {cycle, address, OpKind::Access, type, 0};
+        record(op);
+    }
+
+    void recordPassiveOrHalt(const uint64_t cycle, const bool passiveOrHalt) {
+        const BusOp op = {cycle, 0, OpKind::PassiveOrHalt, 0, static_cast<uint8_t>(passiveOrHalt)};
+        record(op);
+    }
+
+    void recordRead(const uint64_t cycle, const uint8_t value) {
+        const BusOp op = {cycle, 0, OpKind::Read, 0, value};
+        record(op);
+    }
+
+    // The CPU did something no skippable loop does. Stop recording, and leave the head alone for a while.
+    void abort(const uint64_t cycle) {
+        if (!recording_) {
+            return;
+        }
+        if (verifying_) {
+            ++stats_.skips;
+            reportMismatch(cycle);
+            stopRecording();
+            return;
+        }
+        giveUp(cycle);
+    }
+
+private:
+    struct Visit
+    {
+        uint64_t cycle;
+        uint64_t hash;
+        uint32_t window;
+        size_t op_index; // Where the stretch starting at this visit begins in ops_ and path_
+        size_t path_index;
+        Registers registers;
+        StateBuffer state;
+    };
+
+    struct Cooldown
+    {
+        uint16_t cs;
+        uint16_t ip;
+        uint64_t until;
+    };
+
+    void record(const BusOp& op) {
+        if (verifying_) {
+            verify_match_ = verify_match_ && matchesExpected(op);
+            ++verify_next_;
+        }
+        else {
+            ops_.push_back(op);
+        }
+    }
+
+    // Compare an operation stepped during verification with what the period predicts for it.
+    bool matchesExpected(const BusOp& actual) {
+        const size_t count = period_.ops.size();
+        if (count == 0 || verify_next_ >= static_cast<uint64_t>(verify_periods_) * count) {
+            return false;
+        }
+        const uint64_t n = verify_next_ / count;
+        const BusOp& expected = period_.ops[verify_next_ % count];
+        if (actual.kind != expected.kind || actual.cycle != verify_start_ + n * period_.length + expected.cycle) {
+            return false;
+        }
+        switch (actual.kind) {
+            case OpKind::Access:
+                if (actual.type != expected.type) {
+                    return false;
+                }
+                if (actual.type == 4) {
+                    return actual.address == expected.address;
+                }
+                return verify_read_ < verify_reads_.size() && actual.address == verify_reads_[verify_read_++].address;
+            case OpKind::PassiveOrHalt:
+                return actual.value == expected.value;
+            case OpKind::Read:
+                // Data reads may differ from the recorded period's; the evaluated periods read the same as stepping.
+                if (expected.type != 0) {
+                    return verify_read_ > 0 && actual.value == verify_reads_[verify_read_ - 1].value;
+                }
+                return actual.value == expected.value;
+        }
+        return false;
+    }
+
+    void addVisit(const uint64_t cycle, const Registers& registers, const uint32_t window, const uint64_t hash) {
+        visits_.push_back(Visit());
+        Visit& v = visits_.back();
+        v.cycle = cycle;
+        v.hash = hash;
+        v.window = window;
+        v.op_index = ops_.size();
+        v.path_index = path_.size();
+        v.registers = registers;
+        std::swap(v.state, state_);
+    }
+
+    // Make the stretch from visit i to the current one the period.
+    void takePeriod(const size_t i, const uint64_t cycle, const Registers& registers) {
+        const Visit& v = visits_[i];
+        const auto length = static_cast<uint32_t>(cycle - v.cycle);
+        const auto first = path_.begin() + static_cast<std::ptrdiff_t>(v.path_index);
+        const auto count = static_cast<size_t>(path_.end() - first);
+        if (checked_ && length == period_.length && period_.path.size() == 1 + count &&
+            std::equal(first, path_.end(), period_.path.begin() + 1) && v.state == period_.state) {
+            // The same period again, from the same state along the same path, so with the same bus operations. Only
+            // the data may differ, and the evaluator reads that from the bus.
+            period_.registers = v.registers;
+            period_.endRegisters = registers;
+            return;
+        }
+        std::vector<uint16_t> path(1, head_);
+        path.insert(path.end(), first, path_.end());
+        if (length != period_.length || path != period_.path) {
+            checked_ = false;
+        }
+        period_.length = length;
+        period_.path = std::move(path);
+        period_.ops.clear();
+        period_.reads.clear();
+        period_.readCycles.clear();
+        period_.addressesMayMove = false;
+        for (size_t n = v.op_index; n < ops_.size(); ++n) {
+            BusOp op = ops_[n];
+            op.cycle -= v.cycle;
+            if (op.kind == OpKind::Access) {
+                period_.addressesMayMove = op.type == 4;
+                if (op.type != 4) {
+                    const LoopEvaluator::Read read = {op.address, op.type, 0};
+                    period_.reads.push_back(read);
+                    period_.readCycles.push_back(0);
+                }
+            }
+            else if (op.kind == OpKind::Read && !period_.reads.empty() && n > v.op_index &&
+                lastAccessIsData(v.op_index, n)) {
+                period_.reads.back().value = op.value;
+                period_.readCycles.back() = static_cast<uint32_t>(op.cycle);
+                op.type = period_.reads.back().type;
+            }
+            period_.ops.push_back(op);
+        }
+        period_.registers = v.registers;
+        period_.endRegisters = registers;
+        period_.state = state_;
+    }
+
+    // Whether the bus cycle the read at ops_[n] completes, the last one started before it, reads data.
+    bool lastAccessIsData(const size_t first, const size_t n) const {
+        for (size_t i = n; i-- > first;) {
+            if (ops_[i].kind == OpKind::Access) {
+                return ops_[i].type != 4;
+            }
+        }
+        return false;
+    }
+
+    // Drop the visits before visit i, with what was recorded before it.
+    void trim(const size_t i) {
+        const size_t ops = visits_[i].op_index;
+        const size_t path = visits_[i].path_index;
+        ops_.erase(ops_.begin(), ops_.begin() + static_cast<std::ptrdiff_t>(ops));
+        path_.erase(path_.begin(), path_.begin() + static_cast<std::ptrdiff_t>(path));
+        visits_.erase(visits_.begin(), visits_.begin() + static_cast<std::ptrdiff_t>(i));
+        for (Visit& v : visits_) {
+            v.op_index -= ops;
+            v.path_index -= path;
+        }
+        // The visit ending the period comes next; the path between runs up to it.
+        path_.push_back(head_);
+    }
+
+    void stopRecording() {
+        recording_ = false;
+        verifying_ = false;
+        visits_.clear();
+        ops_.clear();
+        path_.clear();
+    }
+
+    void giveUp(const uint64_t cycle) {
+        Cooldown& c = cooldowns_[next_cooldown_];
+        next_cooldown_ = (next_cooldown_ + 1) % kCooldowns;
+        c.cs = cs_;
+        c.ip = head_;
+        c.until = cycle + kCooldownCycles;
+        stopRecording();
+    }
+
+    bool isCoolingDown(const uint16_t cs, const uint16_t ip, const uint64_t cycle) const {
+        for (const Cooldown& c : cooldowns_) {
+            if (c.cs == cs && c.ip == ip && cycle < c.until) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void reportMismatch(const uint64_t cycle) {
+        ++stats_.mismatches;
+        std::cout << std::format("Loop skip verification failed for the loop at {:04X}:{:04X} (cycle {})\n", cs_,
+            head_, cycle);
+    }
+
+    LoopSkipMode mode_{LoopSkipMode::On};
+    LoopSkipStats stats_{};
+
+    bool have_last_{false};
+    uint16_t last_cs_{0};
+    uint16_t last_ip_{0};
+
+    bool recording_{false};
+    uint16_t cs_{0};
+    uint16_t head_{0};
+    std::vector<Visit> visits_;
+    std::vector<BusOp> ops_;
+    std::vector<uint16_t> path_; // Offsets of the instructions since the first visit, with the head for each later one
+    StateBuffer state_;
+
+    Period period_;
+    bool checked_{false};
+
+    std::array<Cooldown, kCooldowns> cooldowns_{};
+    size_t next_cooldown_{0};
+
+    bool verifying_{false};
+    uint64_t verify_start_{0};
+    uint64_t verify_end_{0};
+    uint32_t verify_periods_{0};
+    Registers verify_registers_{};
+    std::vector<LoopEvaluator::Read> verify_reads_;
+    uint64_t verify_next_{0}; // Operations stepped so far
+    size_t verify_read_{0}; // Data accesses among them
+    bool verify_match_{true};
+};
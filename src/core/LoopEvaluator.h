@@ -0,0 +1,583 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Architectural model of the instructions busy-wait loops are made of: moves, compares, tests and arithmetic on
+// registers, reads of memory and ports, conditional jumps and LOOP. It follows a pass through a loop from the registers
+// and FLAGS alone, to predict where the pass goes, what it reads and what it leaves in the registers, without running
+// the microcode. Anything else, including every instruction that writes memory, a port, a segment register or the
+// stack, ends the evaluation. FLAGS come out the way the CPU's ALU sets them.
+//
+// Bytes come from a Source with two members: bool code(uint32_t address, uint8_t& value) for instruction bytes and
+// bool read(uint32_t address, uint8_t type, uint8_t& value) for data. Either may refuse, which ends the evaluation.
+class LoopEvaluator
+{
+public:
+    // The CPU's register file: ES, CS, SS and DS at 0-3, FLAGS at 15 and AX, CX, DX, BX, SP, BP, SI, DI at 24-31.
+    typedef std::array<uint16_t, 32> Registers;
+
+    // A byte of data read by one bus cycle.
+    struct Read
+    {
+        uint32_t address; // Physical address, or port
+        uint8_t type; // IOType: 1 for a port read, 5 for a memory read
+        uint8_t value;
+    };
+
+    // Run the instructions at each of path's offsets into CS in turn, starting from registers and moving them on, and
+    // check that the last one leads back to the first. The bytes read are appended to reads. Returns false if an
+    // instruction isn't modelled, the source refused a byte or the instructions didn't follow path.
+    template <typename Source>
+    static bool run(Registers& registers, const std::vector<uint16_t>& path, Source& source, std::vector<Read>& reads) {
+        if (path.empty()) {
+            return false;
+        }
+        Pass<Source> pass(registers, source, reads, path[0]);
+        for (const uint16_t ip : path) {
+            if (pass.ip() != ip || !pass.step()) {
+                return false;
+            }
+        }
+        return pass.ip() == path[0];
+    }
+
+private:
+    enum
+    {
+        kAX = 24,
+        kCX = 25,
+        kDX = 26,
+        kBX = 27,
+        kBP = 29,
+        kSI = 30,
+        kDI = 31,
+        kFlags = 15,
+    };
+
+    // FLAGS bits
+    enum
+    {
+        kCF = 0x001,
+        kPF = 0x004,
+        kAF = 0x010,
+        kZF = 0x040,
+        kSF = 0x080,
+        kDF = 0x400,
+        kOF = 0x800,
+    };
+
+    // The register or memory operand a ModR/M byte selects.
+    struct Operand
+    {
+        bool memory;
+        int reg; // Register number, for a register operand
+        int segment; // Segment register index, for a memory operand
+        uint16_t offset;
+    };
+
+    template <typename Source>
+    class Pass
+    {
+    public:
+        Pass(Registers& registers, Source& source, std::vector<Read>& reads, const uint16_t ip) :
+            r_(registers), source_(source), reads_(reads), ip_(ip) {
+        }
+
+        uint16_t ip() const { return ip_; }
+
+        // Run the instruction at ip().
+        bool step() {
+            segment_ = -1;
+            uint8_t op = 0;
+            if (!fetch(op)) {
+                return false;
+            }
+            while ((op & 0xe7) == 0x26) {
+                // Segment override prefix
+                segment_ = (op >> 3) & 3;
+                if (!fetch(op)) {
+                    return false;
+                }
+            }
+            word_ = (op & 1) != 0;
+            if (op < 0x40 && (op & 7) < 6) {
+                return arithmetic(op >> 3, op & 7);
+            }
+            if (op >= 0x40 && op < 0x50) {
+                // INC/DEC r16
+                word_ = true;
+                setRegister(op & 7, incDec(registerValue(op & 7), (op & 8) != 0));
+                return true;
+            }
+            if (op >= 0x70 && op < 0x80) {
+                return jumpShort(condition(op & 0x0f));
+            }
+            if (op >= 0xb0 && op < 0xc0) {
+                // MOV r, imm
+                word_ = op >= 0xb8;
+                uint16_t value = 0;
+                if (!fetchImmediate(value)) {
+                    return false;
+                }
+                setRegister(op & 7, value);
+                return true;
+            }
+
+            Operand e{};
+            uint16_t a = 0;
+            uint16_t b = 0;
+            int reg = 0;
+            switch (op) {
+                case 0x80: // ALU r/m, imm
+                case 0x81:
+                case 0x83: {
+                    if (!modRM(e, reg) || (e.memory && reg != 7) || !load(e, a)) {
+                        return false;
+                    }
+                    if (op == 0x83) {
+                        uint8_t imm = 0;
+                        if (!fetch(imm)) {
+                            return false;
+                        }
+                        b = static_cast<uint16_t>(static_cast<int8_t>(imm));
+                    }
+                    else if (!fetchImmediate(b)) {
+                        return false;
+                    }
+                    const uint16_t result = alu(reg, a, b);
+                    if (reg != 7) {
+                        setRegister(e.reg, result);
+                    }
+                    return true;
+                }
+                case 0x84: // TEST r/m, reg
+                case 0x85:
+                    if (!modRM(e, reg) || !load(e, a)) {
+                        return false;
+                    }
+                    alu(4, a, registerValue(reg));
+                    return true;
+                case 0x88: // MOV r/m, reg, with a register destination
+                case 0x89:
+                    if (!modRM(e, reg) || e.memory) {
+                        return false;
+                    }
+                    setRegister(e.reg, registerValue(reg));
+                    return true;
+                case 0x8a: // MOV reg, r/m
+                case 0x8b:
+                    if (!modRM(e, reg) || !load(e, a)) {
+                        return false;
+                    }
+                    setRegister(reg, a);
+                    return true;
+                case 0x90: // NOP
+                    return true;
+                case 0xa0: // MOV AL/AX, [offset]
+                case 0xa1: {
+                    uint16_t offset = 0;
+                    if (!fetchWord(offset) || !readMemory(segment(3), offset, a)) {
+                        return false;
+                    }
+                    setRegister(0, a);
+                    return true;
+                }
+                case 0xa8: // TEST AL/AX, imm
+                case 0xa9:
+                    if (!fetchImmediate(b)) {
+                        return false;
+                    }
+                    alu(4, registerValue(0), b);
+                    return true;
+                case 0xac: // LODS
+                case 0xad:
+                    if (!readMemory(segment(3), r_[kSI], a)) {
+                        return false;
+                    }
+                    setRegister(0, a);
+                    r_[kSI] = static_cast<uint16_t>(r_[kSI] + stringStep());
+                    return true;
+                case 0xae: // SCAS
+                case 0xaf:
+                    if (!readMemory(0, r_[kDI], b)) {
+                        return false;
+                    }
+                    alu(7, registerValue(0), b);
+                    r_[kDI] = static_cast<uint16_t>(r_[kDI] + stringStep());
+                    return true;
+                case 0xe0: // LOOPNE
+                case 0xe1: // LOOPE
+                case 0xe2: { // LOOP
+                    r_[kCX] = static_cast<uint16_t>(r_[kCX] - 1);
+                    const bool zero = (r_[kFlags] & kZF) != 0;
+                    return jumpShort(r_[kCX] != 0 && (op == 0xe2 || zero == (op == 0xe1)));
+                }
+                case 0xe3: // JCXZ
+                    return jumpShort(r_[kCX] == 0);
+                case 0xe4: // IN AL/AX, imm
+                case 0xe5: {
+                    uint8_t port = 0;
+                    if (!fetch(port) || !readPort(port, a)) {
+                        return false;
+                    }
+                    setRegister(0, a);
+                    return true;
+                }
+                case 0xe9: { // JMP rel16
+                    uint16_t displacement = 0;
+                    if (!fetchWord(displacement)) {
+                        return false;
+                    }
+                    ip_ = static_cast<uint16_t>(ip_ + displacement);
+                    return true;
+                }
+                case 0xeb: // JMP rel8
+                    return jumpShort(true);
+                case 0xec: // IN AL/AX, DX
+                case 0xed:
+                    if (!readPort(r_[kDX], a)) {
+                        return false;
+                    }
+                    setRegister(0, a);
+                    return true;
+                case 0xf6: // TEST r/m, imm
+                case 0xf7:
+                    if (!modRM(e, reg) || reg != 0 || !load(e, a) || !fetchImmediate(b)) {
+                        return false;
+                    }
+                    alu(4, a, b);
+                    return true;
+                case 0xfe: // INC/DEC r/m, with a register operand
+                case 0xff:
+                    if (!modRM(e, reg) || e.memory || reg > 1) {
+                        return false;
+                    }
+                    setRegister(e.reg, incDec(registerValue(e.reg), reg == 1));
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+    private:
+        // The ALU instructions 00-3D: op is the operation (ADD, OR, ADC, SBB, AND, SUB, XOR, CMP) and form the low
+        // three opcode bits. Only CMP may have a memory destination.
+        bool arithmetic(const int op, const int form) {
+            uint16_t a = 0;
+            uint16_t b = 0;
+            if (form >= 4) {
+                if (!fetchImmediate(b)) {
+                    return false;
+                }
+                const uint16_t result = alu(op, registerValue(0), b);
+                if (op != 7) {
+                    setRegister(0, result);
+                }
+                return true;
+            }
+            Operand e{};
+            int reg = 0;
+            if (!modRM(e, reg) || !load(e, form < 2 ? a : b)) {
+                return false;
+            }
+            if (form < 2) {
+                if (e.memory && op != 7) {
+                    return false;
+                }
+                const uint16_t result = alu(op, a, registerValue(reg));
+                if (op != 7) {
+                    setRegister(e.reg, result);
+                }
+            }
+            else {
+                const uint16_t result = alu(op, registerValue(reg), b);
+                if (op != 7) {
+                    setRegister(reg, result);
+                }
+            }
+            return true;
+        }
+
+        uint16_t alu(const int op, const uint32_t a, const uint32_t b) {
+            const uint32_t carryOut = word_ ? 0x10000 : 0x100;
+            const bool carry = (r_[kFlags] & kCF) != 0;
+            uint32_t r = 0;
+            switch (op) {
+                case 0: // ADD
+                case 2: // ADC
+                    r = a + b + (op == 2 && carry ? 1 : 0);
+                    setFlags(r, ((r ^ a ^ b) & carryOut) != 0, topBit((r ^ a) & (r ^ b)), ((a ^ b ^ r) & 0x10) != 0);
+                    break;
+                case 3: // SBB
+                case 5: // SUB
+                case 7: // CMP
+                    r = a - (b + (op == 3 && carry ? 1 : 0));
+                    setFlags(r, ((r ^ a ^ b) & carryOut) != 0, topBit((a ^ b) & (r ^ a)), ((a ^ b ^ r) & 0x10) != 0);
+                    break;
+                case 1: // OR
+                    r = a | b;
+                    setFlags(r, false, false, false);
+                    break;
+                case 4: // AND
+                    r = a & b;
+                    setFlags(r, false, false, false);
+                    break;
+                default: // XOR
+                    r = a ^ b;
+                    setFlags(r, false, false, false);
+                    break;
+            }
+            return static_cast<uint16_t>(r & mask());
+        }
+
+        // INC and DEC leave the carry alone.
+        uint16_t incDec(const uint32_t a, const bool decrement) {
+            const uint32_t v = decrement ? a - 1 : a + 1;
+            const bool overflow = decrement ? topBit((a ^ 1) & (v ^ a)) : topBit((v ^ a) & (v ^ 1));
+            setFlags(v, (r_[kFlags] & kCF) != 0, overflow, ((v ^ a ^ 1) & 0x10) != 0);
+            return static_cast<uint16_t>(v & mask());
+        }
+
+        void setFlags(const uint32_t r, const bool carry, const bool overflow, const bool auxiliary) {
+            uint32_t parity = r & 0xff;
+            parity ^= parity >> 4;
+            parity ^= parity >> 2;
+            parity ^= parity >> 1;
+            r_[kFlags] = static_cast<uint16_t>((r_[kFlags] & 0xf702) |
+                (overflow ? kOF : 0) |
+                (topBit(r) ? kSF : 0) |
+                ((r & mask()) == 0 ? kZF : 0) |
+                (auxiliary ? kAF : 0) |
+                ((parity & 1) == 0 ? kPF : 0) |
+                (carry ? kCF : 0));
+        }
+
+        // The condition of Jcc with the low opcode nibble c.
+        bool condition(const int c) const {
+            const uint16_t f = r_[kFlags];
+            const bool sf = (f & kSF) != 0;
+            const bool of = (f & kOF) != 0;
+            bool v = false;
+            switch (c >> 1) {
+                case 0: // JO
+                    v = of;
+                    break;
+                case 1: // JC
+                    v = (f & kCF) != 0;
+                    break;
+                case 2: // JZ
+                    v = (f & kZF) != 0;
+                    break;
+                case 3: // JBE
+                    v = (f & (kCF | kZF)) != 0;
+                    break;
+                case 4: // JS
+                    v = sf;
+                    break;
+                case 5: // JP
+                    v = (f & kPF) != 0;
+                    break;
+                case 6: // JL
+                    v = sf != of;
+                    break;
+                default: // JLE
+                    v = (f & kZF) != 0 || sf != of;
+                    break;
+            }
+            return (c & 1) != 0 ? !v : v;
+        }
+
+        bool jumpShort(const bool taken) {
+            uint8_t displacement = 0;
+            if (!fetch(displacement)) {
+                return false;
+            }
+            if (taken) {
+                ip_ = static_cast<uint16_t>(ip_ + static_cast<int8_t>(displacement));
+            }
+            return true;
+        }
+
+        bool modRM(Operand& operand, int& reg) {
+            uint8_t m = 0;
+            if (!fetch(m)) {
+                return false;
+            }
+            reg = (m >> 3) & 7;
+            const int mod = m >> 6;
+            const int rm = m & 7;
+            operand.memory = mod != 3;
+            operand.reg = rm;
+            if (mod == 3) {
+                return true;
+            }
+            int base = 3;
+            uint16_t offset = 0;
+            switch (rm) {
+                case 0:
+                    offset = static_cast<uint16_t>(r_[kBX] + r_[kSI]);
+                    break;
+                case 1:
+                    offset = static_cast<uint16_t>(r_[kBX] + r_[kDI]);
+                    break;
+                case 2:
+                    offset = static_cast<uint16_t>(r_[kBP] + r_[kSI]);
+                    base = 2;
+                    break;
+                case 3:
+                    offset = static_cast<uint16_t>(r_[kBP] + r_[kDI]);
+                    base = 2;
+                    break;
+                case 4:
+                    offset = r_[kSI];
+                    break;
+                case 5:
+                    offset = r_[kDI];
+                    break;
+                case 6:
+                    if (mod == 0) {
+                        if (!fetchWord(offset)) {
+                            return false;
+                        }
+                    }
+                    else {
+                        offset = r_[kBP];
+                        base = 2;
+                    }
+                    break;
+                default:
+                    offset = r_[kBX];
+                    break;
+            }
+            uint8_t low = 0;
+            if (mod == 1) {
+                if (!fetch(low)) {
+                    return false;
+                }
+                offset = static_cast<uint16_t>(offset + static_cast<int8_t>(low));
+            }
+            else if (mod == 2) {
+                uint16_t displacement = 0;
+                if (!fetchWord(displacement)) {
+                    return false;
+                }
+                offset = static_cast<uint16_t>(offset + displacement);
+            }
+            operand.segment = segment(base);
+            operand.offset = offset;
+            return true;
+        }
+
+        bool load(const Operand& operand, uint16_t& value) {
+            if (operand.memory) {
+                return readMemory(operand.segment, operand.offset, value);
+            }
+            value = registerValue(operand.reg);
+            return true;
+        }
+
+        // Register n of the operand size, numbered as in ModR/M.
+        uint16_t registerValue(const int n) const {
+            if (word_) {
+                return r_[kAX + n];
+            }
+            return n < 4 ? static_cast<uint16_t>(r_[kAX + n] & 0xff) : static_cast<uint16_t>(r_[kAX + n - 4] >> 8);
+        }
+
+        void setRegister(const int n, const uint16_t value) {
+            if (word_) {
+                r_[kAX + n] = value;
+            }
+            else if (n < 4) {
+                r_[kAX + n] = static_cast<uint16_t>((r_[kAX + n] & 0xff00) | (value & 0xff));
+            }
+            else {
+                r_[kAX + n - 4] = static_cast<uint16_t>((r_[kAX + n - 4] & 0x00ff) | ((value & 0xff) << 8));
+            }
+        }
+
+        int segment(const int base) const { return segment_ >= 0 ? segment_ : base; }
+
+        uint32_t physicalAddress(const int segment, const uint16_t offset) const {
+            return ((static_cast<uint32_t>(r_[segment]) << 4) + offset) & 0xFFFFF;
+        }
+
+        // A word is read a byte at a time, the second byte from the next offset.
+        bool readMemory(const int segment, const uint16_t offset, uint16_t& value) {
+            uint8_t low = 0;
+            uint8_t high = 0;
+            if (!readByte(physicalAddress(segment, offset), 5, low) ||
+                (word_ && !readByte(physicalAddress(segment, static_cast<uint16_t>(offset + 1)), 5, high))) {
+                return false;
+            }
+            value = static_cast<uint16_t>(low | (high << 8));
+            return true;
+        }
+
+        bool readPort(const uint16_t port, uint16_t& value) {
+            uint8_t low = 0;
+            uint8_t high = 0;
+            if (!readByte(port, 1, low) || (word_ && !readByte(static_cast<uint16_t>(port + 1), 1, high))) {
+                return false;
+            }
+            value = static_cast<uint16_t>(low | (high << 8));
+            return true;
+        }
+
+        bool readByte(const uint32_t address, const uint8_t type, uint8_t& value) {
+            if (!source_.read(address, type, value)) {
+                return false;
+            }
+            const Read read = {address, type, value};
+            reads_.push_back(read);
+            return true;
+        }
+
+        bool fetch(uint8_t& value) {
+            if (!source_.code(physicalAddress(1, ip_), value)) {
+                return false;
+            }
+            ++ip_;
+            return true;
+        }
+
+        bool fetchWord(uint16_t& value) {
+            uint8_t low = 0;
+            uint8_t high = 0;
+            if (!fetch(low) || !fetch(high)) {
+                return false;
+            }
+            value = static_cast<uint16_t>(low | (high << 8));
+            return true;
+        }
+
+        bool fetchImmediate(uint16_t& value) {
+            if (word_) {
+                return fetchWord(value);
+            }
+            uint8_t low = 0;
+            if (!fetch(low)) {
+                return false;
+            }
+            value = low;
+            return true;
+        }
+
+        int stringStep() const {
+            const int size = word_ ? 2 : 1;
+            return (r_[kFlags] & kDF) != 0 ? -size : size;
+        }
+
+        uint32_t mask() const { return word_ ? 0xffff : 0xff; }
+        bool topBit(const uint32_t v) const { return (v & (word_ ? 0x8000u : 0x80u)) != 0; }
+
+        Registers& r_;
+        Source& source_;
+        std::vector<Read>& reads_;
+        uint16_t ip_;
+        int segment_{-1};
+        bool word_{false};
+    };
+};
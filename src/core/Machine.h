@@ -1,15 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <climits>
+#include <span>
 #include <string>
+#include <vector>
 #include "Cpu.h"
+#include "InputJournal.h"
+#include "SaveState.h"
+#include "SnapshotRing.h"
 
 enum class MachineState { Running, Stopped, BreakpointHit };
 
-class Machine
+// A complete machine of the configuration Config (see MachineConfig.h).
+template <typename Config>
+class BasicMachine
 {
 
 public:
-    Machine() {
+    using BusType = BasicBus<Config>;
+    using CpuType = Cpu<BusType>;
+
+    // CPU cycles in one 60 Hz frame, the usual history interval.
+    static constexpr uint64_t kFrameCycles = 79545;
+
+    BasicMachine() {
         //_cpu.setConsoleLogging();
         cpu_.reset();
         cpu_.getBus()->reset();
@@ -27,11 +42,13 @@ public:
 
     void run_for(const uint64_t ticks) {
         // The CPU core's run_for takes a number of CPU cycles (ticks/3 -> CPU cycles)
-        switch (cpu_.run_for(static_cast<int>(ticks / 3))) {
-            case Cpu<Bus>::RunResult::BreakpointHit:
+        const auto result = runCycles(ticks / 3);
+        recordHistory();
+        switch (result) {
+            case CpuType::RunResult::BreakpointHit:
                 state_ = MachineState::BreakpointHit;
                 break;
-            case Cpu<Bus>::RunResult::OffRails:
+            case CpuType::RunResult::OffRails:
                 state_ = MachineState::BreakpointHit;
                 break;
             default:
@@ -40,13 +57,21 @@ public:
     }
 
     void resetCpu() {
+        if (journal_ != nullptr) {
+            journal_->addResetCpu(cpu_.cycle());
+        }
         cpu_.reset();
+        history_.clear();
     }
 
     void resetMachine() {
+        if (journal_ != nullptr) {
+            journal_->addReset(cpu_.cycle());
+        }
         last_pit_ticks_ = 0;
         cpu_.reset();
         cpu_.getBus()->reset();
+        history_.clear();
     }
 
     uint64_t getElapsedPitTicks(const bool new_frame) {
@@ -74,6 +99,14 @@ public:
         }
     }
 
+    // The CPU runs with FastPolicy unless a debugger feature needs the instrumented cycle loop. Both policies drive
+    // the same Cpu object, so switching takes effect on the next run_for() without losing any state.
+    void setDebugPolicy(const bool state) { debug_policy_ = state; }
+    [[nodiscard]] bool isDebugPolicy() const { return debug_policy_; }
+    [[nodiscard]] bool usingDebugPolicy() const {
+        return debug_policy_ || cpu_.hasBreakpoint() || cpu_.isCycleLogging() || cpu_.isLogInstructions();
+    }
+
     [[nodiscard]] bool isRunning() const { return state_ == MachineState::Running; }
     void stop() { state_ = MachineState::Stopped; }
     void run() { state_ = MachineState::Running; }
@@ -81,8 +114,8 @@ public:
     uint8_t* ram() { return cpu_.getBus()->ram(); }
     [[nodiscard]] size_t ramSize() { return cpu_.getBus()->ramSize(); }
     // Expose the underlying bus for tools needing direct access (e.g., CGA/VRAM)
-    Bus* getBus() { return cpu_.getBus(); }
-    Cpu<Bus>* getCpu() { return &cpu_; }
+    BusType* getBus() { return cpu_.getBus(); }
+    CpuType* getCpu() { return &cpu_; }
     uint8_t getALU() { return cpu_.getALU(); }
     // Read a byte from physical address space (RAM or ROM). Does not modify bus state.
     uint8_t peekPhysical(uint32_t address) { return cpu_.getBus()->peek(address); }
@@ -118,14 +151,239 @@ public:
 
     // Step the CPU to the next instruction boundary. Returns the number of CPU cycles executed.
     uint64_t stepInstruction() {
-        const auto cycles = static_cast<uint64_t>(cpu_.stepToNextInstruction());
+        applyReplayInputs();
+        uint64_t from = cpu_.cycle();
+        if (replay_ != nullptr) {
+            saveState(replay_state_);
+        }
+        uint64_t ran = 0;
+        auto cycles = static_cast<uint64_t>(stepCpu());
+        // A replayed input that fell due within the instruction has to take effect on its own cycle, and a replay
+        // has to end on its last cycle, so go back, run to it and step again from there.
+        for (uint64_t next = nextReplayCycle(); next < cpu_.cycle(); next = nextReplayCycle()) {
+            loadScratchState(replay_state_);
+            ran += next - from;
+            runCycles(next - from);
+            from = cpu_.cycle();
+            saveState(replay_state_);
+            cycles = ran + static_cast<uint64_t>(stepCpu());
+        }
+        applyReplayInputs();
+        recordHistory();
         if (state_ == MachineState::Running) {
             state_ = MachineState::Stopped;
         }
         return cycles;
     }
 
-    void sendScanCode(uint8_t scancode) {
+    // Reverse execution.
+    //
+    // While history is on, the machine snapshots itself every interval CPU cycles into a SnapshotRing. Going back
+    // restores the newest snapshot before the target and runs forward to it again; emulation is deterministic, so
+    // this arrives at exactly the state the machine was in. Input changes the course of emulation, so sendScanCode()
+    // and anything else that changes the machine from outside should be followed by recordSnapshot(). After going
+    // back, the snapshots of the abandoned future are dropped.
+    //
+    // An interval of 0 turns history off.
+    void setHistoryInterval(const uint64_t cycles) {
+        history_interval_ = cycles;
+        history_.clear();
+        recordHistory();
+    }
+    [[nodiscard]] uint64_t historyInterval() const { return history_interval_; }
+    [[nodiscard]] const SnapshotRing& history() const { return history_; }
+    void setHistoryLimits(const size_t capacity, const size_t byte_budget) {
+        history_.setLimits(capacity, byte_budget);
+    }
+
+    // Snapshot the machine now, if history is on.
+    void recordSnapshot() {
+        if (history_interval_ != 0) {
+            saveState(history_state_);
+            history_.record(cpu_.cycle(), history_state_);
+        }
+    }
+
+    // Go back one CPU cycle. Returns false if the history doesn't reach back that far.
+    bool stepBackCycle() {
+        const uint64_t now = cpu_.cycle();
+        if (now == 0 || history_.countAtOrBefore(now - 1) == 0) {
+            return false;
+        }
+        recordSnapshot();
+        rewindTo(now - 1);
+        finishRewind(MachineState::Stopped);
+        return true;
+    }
+
+    // Go back to the previous instruction boundary, where Step would bring the machine back here. Returns false if
+    // the history doesn't reach back that far.
+    bool stepBackInstruction() {
+        const uint64_t now = cpu_.cycle();
+        if (now == 0 || history_.countAtOrBefore(now - 1) == 0) {
+            return false;
+        }
+        recordSnapshot();
+        // Step forward from each snapshot in turn, newest first, until one reaches an instruction boundary before
+        // now, then restore it again and run to the last such boundary.
+        for (size_t index = history_.countAtOrBefore(now - 1); index-- > 0;) {
+            restoreSnapshot(index);
+            uint64_t boundary = 0;
+            while (cpu_.cycle() < now) {
+                const uint64_t before = cpu_.cycle();
+                stepCpu();
+                if (cpu_.cycle() == before) {
+                    // Halted: Step stands still, so wait for the interrupt a cycle at a time.
+                    runCpu(1);
+                }
+                else if (cpu_.cycle() < now) {
+                    boundary = cpu_.cycle();
+                }
+            }
+            if (boundary != 0) {
+                restoreSnapshot(index);
+                rewindFrom(boundary);
+                finishRewind(MachineState::Stopped);
+                return true;
+            }
+        }
+        rewindTo(now);
+        return false;
+    }
+
+    // Go back to the last time the breakpoint was hit. Returns false if there is no breakpoint, or it wasn't hit
+    // within the history.
+    bool runBackToBreakpoint() {
+        const uint64_t now = cpu_.cycle();
+        if (!cpu_.hasBreakpoint() || now == 0 || history_.countAtOrBefore(now - 1) == 0) {
+            return false;
+        }
+        recordSnapshot();
+        // Search the spans between snapshots, newest first, for the last hit.
+        uint64_t end = now;
+        for (size_t index = history_.countAtOrBefore(now - 1); index-- > 0;) {
+            restoreSnapshot(index);
+            uint64_t hit = 0;
+            bool found = false;
+            while (cpu_.cycle() < end) {
+                const uint64_t before = cpu_.cycle();
+                const auto result = cpu_.template run_for<DebugPolicy>(cpuCycles(end - before));
+                if (result == CpuType::RunResult::BreakpointHit && cpu_.cycle() < now) {
+                    hit = cpu_.cycle();
+                    found = true;
+                }
+                if (cpu_.cycle() == before) {
+                    break;
+                }
+            }
+            if (found) {
+                restoreSnapshot(index);
+                rewindFrom(hit);
+                finishRewind(MachineState::BreakpointHit);
+                return true;
+            }
+            end = history_.cycle(index);
+        }
+        rewindTo(now);
+        return false;
+    }
+
+    // Input recording and replay (see InputJournal.h).
+    //
+    // While recording, sendScanCode(), insertDisk(), ejectDisk() and the resets are stamped with the cycle they
+    // happen on and added to the journal, which must outlive the recording. Going back in time (see above) drops the
+    // inputs of the abandoned future.
+    void startRecording(InputJournal& journal) {
+        stopReplay();
+        stopRecording();
+        saveState(replay_state_);
+        journal.begin(replay_state_);
+        journal_ = &journal;
+    }
+
+    // Stamp the journal with the cycle and state recording ended on.
+    void stopRecording() {
+        if (journal_ != nullptr) {
+            saveState(replay_state_);
+            journal_->end(cpu_.cycle(), InputJournal::stateHash(replay_state_));
+            journal_ = nullptr;
+        }
+    }
+
+    [[nodiscard]] bool isRecording() const { return journal_ != nullptr; }
+
+    // Load the journal's start state and apply its inputs as run_for() and stepInstruction() reach their cycles,
+    // until the cycle recording ended on. The journal must outlive the replay. Returns false, with the machine reset,
+    // if the start state doesn't load.
+    bool startReplay(const InputJournal& journal) {
+        stopRecording();
+        if (!loadState(journal.startState())) {
+            return false;
+        }
+        replay_ = &journal;
+        replay_next_ = 0;
+        replay_matched_ = false;
+        applyReplayInputs();
+        return true;
+    }
+
+    void stopReplay() { replay_ = nullptr; }
+    [[nodiscard]] bool isReplaying() const { return replay_ != nullptr; }
+    // Whether the last replay to finish ended in the state the recording did.
+    [[nodiscard]] bool replayMatched() const { return replay_matched_; }
+
+    // Save the complete emulation state into out, replacing its contents. See SaveState.h for the format.
+    void saveState(std::vector<uint8_t>& out) {
+        StateWriter writer(out);
+        cpu_.serialize(writer);
+    }
+
+    // Resume from a state saved by a machine of the same configuration. On failure the machine is reset and false is
+    // returned.
+    bool loadState(const std::span<const uint8_t> data) {
+        stopRecording();
+        stopReplay();
+        history_.clear();
+        StateReader reader(data);
+        if (reader.ok()) {
+            cpu_.serialize(reader);
+        }
+        if (!reader.ok()) {
+            resetMachine();
+            return false;
+        }
+        // The PIT may have gone backwards; audio sync restarts from here.
+        last_pit_ticks_ = cpu_.getBus()->pit()->getTicks();
+        recordHistory();
+        return true;
+    }
+
+    void sendScanCode(const uint8_t scancode) {
+        if (journal_ != nullptr) {
+            journal_->addScanCode(cpu_.cycle(), scancode);
+        }
+        applyScanCode(scancode);
+    }
+
+    // Insert a disk image into a floppy drive, replacing any disk there.
+    void insertDisk(const uint8_t drive, const std::vector<uint8_t>& image, const bool write_protected) {
+        if (journal_ != nullptr) {
+            journal_->addInsertDisk(cpu_.cycle(), drive, image, write_protected);
+        }
+        cpu_.getBus()->fdc()->loadDisk(drive, image, write_protected);
+        recordSnapshot();
+    }
+
+    void ejectDisk(const uint8_t drive) {
+        if (journal_ != nullptr) {
+            journal_->addEjectDisk(cpu_.cycle(), drive);
+        }
+        cpu_.getBus()->fdc()->loadDisk(drive, {});
+        recordSnapshot();
+    }
+
+private:
+    void applyScanCode(const uint8_t scancode) {
         const auto ppi = cpu_.getBus()->ppi();
 
         // PB6 LOW output disables the clock line to the keyboard, so only read in a keyboard byte if it is high.
@@ -140,10 +398,176 @@ public:
 
         // Request a keyboard interrupt.
         cpu_.getBus()->pic()->setIRQLine(1, true);
+        recordSnapshot();
+    }
+
+    // Cycle counts for the CPU core, which takes an int.
+    [[nodiscard]] static int cpuCycles(const uint64_t cycles) {
+        return static_cast<int>(std::min<uint64_t>(cycles, INT_MAX));
+    }
+
+    typename CpuType::RunResult runCpu(const int cycles) {
+        return usingDebugPolicy()
+            ? cpu_.template run_for<DebugPolicy>(cycles)
+            : cpu_.template run_for<FastPolicy>(cycles);
+    }
+
+    int stepCpu() {
+        return usingDebugPolicy()
+            ? cpu_.template stepToNextInstruction<DebugPolicy>()
+            : cpu_.template stepToNextInstruction<FastPolicy>();
+    }
+
+    // Run the CPU for cycles, stopping on the way to apply each replayed input on its cycle.
+    typename CpuType::RunResult runCycles(uint64_t cycles) {
+        applyReplayInputs();
+        while (replay_ != nullptr) {
+            const uint64_t now = cpu_.cycle();
+            const uint64_t until = std::max(nextReplayCycle(), now);
+            if (until - now > cycles) {
+                break;
+            }
+            const auto result = runCpu(cpuCycles(until - now));
+            cycles -= cpu_.cycle() - now;
+            if (cpu_.cycle() != until) {
+                // Stopped early, at a breakpoint or off the rails.
+                return result;
+            }
+            applyReplayInputs();
+            if (cycles == 0) {
+                return result;
+            }
+        }
+        return runCpu(cpuCycles(cycles));
+    }
+
+    [[nodiscard]] const InputEvent* nextReplayInput() const {
+        if (replay_ == nullptr || replay_next_ == replay_->events().size()) {
+            return nullptr;
+        }
+        return &replay_->events()[replay_next_];
+    }
+
+    // The cycle of the next replayed input, or of the end of the replay.
+    [[nodiscard]] uint64_t nextReplayCycle() const {
+        if (replay_ == nullptr) {
+            return UINT64_MAX;
+        }
+        const InputEvent* next = nextReplayInput();
+        return next != nullptr ? next->cycle : replay_->endCycle();
+    }
+
+    // Apply the replayed inputs due by now, and finish the replay once they are all applied and its end is reached.
+    void applyReplayInputs() {
+        while (const InputEvent* e = nextReplayInput()) {
+            if (e->cycle > cpu_.cycle()) {
+                return;
+            }
+            ++replay_next_;
+            switch (e->kind) {
+                case InputKind::ScanCode:
+                    applyScanCode(e->value);
+                    break;
+                case InputKind::InsertDisk:
+                    cpu_.getBus()->fdc()->loadDisk(e->value, replay_->disk(e->disk), e->write_protected);
+                    recordSnapshot();
+                    break;
+                case InputKind::EjectDisk:
+                    cpu_.getBus()->fdc()->loadDisk(e->value, {});
+                    recordSnapshot();
+                    break;
+                case InputKind::Reset:
+                    resetMachine();
+                    break;
+                case InputKind::ResetCpu:
+                    resetCpu();
+                    break;
+            }
+        }
+        if (replay_ != nullptr && cpu_.cycle() >= replay_->endCycle()) {
+            saveState(replay_state_);
+            replay_matched_ = cpu_.cycle() == replay_->endCycle() &&
+                InputJournal::stateHash(replay_state_) == replay_->endHash();
+            replay_ = nullptr;
+        }
+    }
+
+    void loadScratchState(const std::vector<uint8_t>& state) {
+        StateReader reader(state);
+        cpu_.serialize(reader);
+        last_pit_ticks_ = cpu_.getBus()->pit()->getTicks();
+    }
+
+    // Snapshot the machine if an interval has passed since the last snapshot.
+    void recordHistory() {
+        if (history_interval_ != 0 &&
+            (history_.empty() || cpu_.cycle() >= history_.cycle(history_.size() - 1) + history_interval_)) {
+            recordSnapshot();
+        }
+    }
+
+    void restoreSnapshot(const size_t index) {
+        history_.restore(index, history_state_);
+        // Audio sync restarts from here, as after loadState().
+        loadScratchState(history_state_);
+    }
+
+    // Run forward from the current state to cycle, stopping at breakpoints on the way only to carry on.
+    void rewindFrom(const uint64_t cycle) {
+        while (cpu_.cycle() < cycle) {
+            const uint64_t before = cpu_.cycle();
+            runCpu(cpuCycles(cycle - before));
+            if (cpu_.cycle() == before) {
+                break;
+            }
+        }
+    }
+
+    // Restore the state at cycle from the newest snapshot at or before it.
+    void rewindTo(const uint64_t cycle) {
+        restoreSnapshot(history_.countAtOrBefore(cycle) - 1);
+        rewindFrom(cycle);
+    }
+
+    void finishRewind(const MachineState state) {
+        const uint64_t now = cpu_.cycle();
+        if (const size_t count = history_.countAtOrBefore(now); count != 0) {
+            history_.discardAfter(count - 1);
+        }
+        if (journal_ != nullptr) {
+            journal_->discardAfter(now);
+        }
+        if (replay_ != nullptr) {
+            // Inputs after now are due again. History doesn't reach back past a reset, which starts the count again.
+            const auto& events = replay_->events();
+            while (replay_next_ != 0 && events[replay_next_ - 1].cycle > now &&
+                   events[replay_next_ - 1].kind != InputKind::Reset &&
+                   events[replay_next_ - 1].kind != InputKind::ResetCpu) {
+                --replay_next_;
+            }
+        }
+        last_pit_ticks_ = cpu_.getBus()->pit()->getTicks();
+        if (state != MachineState::BreakpointHit) {
+            cpu_.clearBreakpointHit();
+        }
+        state_ = state;
     }
 
-private:
     MachineState state_{MachineState::Stopped};
     uint64_t last_pit_ticks_ = 0;
-    Cpu<Bus> cpu_{};
+    bool debug_policy_ = false;
+    CpuType cpu_{};
+    uint64_t history_interval_{0};
+    SnapshotRing history_;
+    std::vector<uint8_t> history_state_; // Scratch save state for taking and restoring snapshots
+    InputJournal* journal_{nullptr}; // Journal being recorded into
+    const InputJournal* replay_{nullptr}; // Journal being replayed
+    size_t replay_next_{0}; // Next input of replay_ to apply
+    bool replay_matched_{false};
+    std::vector<uint8_t> replay_state_; // Scratch save state for recording and replay
+};
+
+// The default machine, which the GUI runs.
+class Machine : public BasicMachine<Ibm5160>
+{
 };
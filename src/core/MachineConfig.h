@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+
+// Compile-time machine configurations.
+//
+// Bus and Machine are instantiated once per configuration, so every option is a constant in the emulation code:
+// a device that isn't fitted is never mapped, scheduled or ticked, and the branches that would serve it are compiled
+// out. A configuration is a type with these members:
+//
+//   kName        Name used on the command line and in reports.
+//   kDmacFix     The DMA wait state fix: U90 on second revision 5160 boards, U101 on 5150s. With it, I/O writes to
+//                the DMAC don't update the non-DMA ready latch.
+//   kDipSwitch1  Switch block 1, read through PPI port C. It describes the memory and devices fitted, so a
+//                configuration that changes kRamSize, kHasCga or kHasFdc defines it again (see dipSwitch1()).
+//   kRamSize     Conventional RAM in bytes, a whole number of MemoryMap pages.
+//   kHasCga, kHasFdc, kHasKeyboard
+//                Which devices are fitted.
+
+// Switch block 1 of a 5160, with switches that are off reading as 1:
+//   bit 0     Off for normal operation; on loops the POST
+//   bit 1     Off when an 8087 is fitted
+//   bits 2-3  Memory banks on the motherboard, less one, in 64 KiB banks up to 256 KiB. The BIOS finds memory on
+//             expansion cards by testing it.
+//   bits 4-5  Display at power on: 00 none (or one with its own BIOS), 01 CGA 40x25, 10 CGA 80x25, 11 MDA
+//   bits 6-7  Floppy drives, less one. The switches can't say there are none; the BIOS finds that out from the
+//             controller.
+constexpr uint8_t dipSwitch1(const uint32_t ram_size, const bool has_cga, const unsigned floppy_drives) {
+    const uint32_t banks = ram_size >= 0x40000 ? 4 : (ram_size + 0xFFFF) / 0x10000;
+    return static_cast<uint8_t>(0x01 |
+        ((banks - 1) & 0x03) << 2 |
+        (has_cga ? 0b10 : 0b00) << 4 |
+        ((floppy_drives - 1) & 0x03) << 6);
+}
+
+// A second revision IBM 5160 with a CGA, a floppy controller and a keyboard.
+struct Ibm5160
+{
+    static constexpr const char* kName = "5160";
+    static constexpr bool kDmacFix = true;
+    static constexpr uint32_t kRamSize = 0xB8000;
+    static constexpr bool kHasCga = true;
+    static constexpr bool kHasFdc = true;
+    static constexpr bool kHasKeyboard = true;
+    static constexpr uint8_t kDipSwitch1 = dipSwitch1(kRamSize, kHasCga, 2);
+};
+
+// A first revision 5160 board, without the U90 fix.
+struct Ibm5160Early : Ibm5160
+{
+    static constexpr const char* kName = "5160-early";
+    static constexpr bool kDmacFix = false;
+};
+
+// A 5160 with 640 KiB of RAM.
+struct Ibm5160With640K : Ibm5160
+{
+    static constexpr const char* kName = "5160-640k";
+    static constexpr uint32_t kRamSize = 0xA0000;
+    static constexpr uint8_t kDipSwitch1 = dipSwitch1(kRamSize, kHasCga, 2);
+};
+
+// The motherboard alone: CPU, memory, DMAC, PIC, PIT and PPI. Useful for measuring the core without video or I/O.
+struct Ibm5160Bare : Ibm5160
+{
+    static constexpr const char* kName = "5160-bare";
+    static constexpr bool kHasCga = false;
+    static constexpr bool kHasFdc = false;
+    static constexpr bool kHasKeyboard = false;
+    static constexpr uint8_t kDipSwitch1 = dipSwitch1(kRamSize, kHasCga, 1);
+};
+
+using MachineConfigs = std::tuple<Ibm5160, Ibm5160Early, Ibm5160With640K, Ibm5160Bare>;
+
+// Call f.template operator()<Config>() for each configuration in MachineConfigs.
+template <typename F>
+void forEachMachineConfig(F&& f) {
+    [&]<typename... Configs>(std::tuple<Configs...>*) {
+        (f.template operator()<Configs>(), ...);
+    }(static_cast<MachineConfigs*>(nullptr));
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Memory that isn't plain storage, such as video RAM. The offset passed in is relative to the start of the mapped
+// range. Reads must not have side effects, since peek() and the CPU's fast paths use them to look at memory.
+struct MemoryHandler
+{
+    void* context{nullptr};
+    uint8_t (*read)(void* context, uint32_t offset){nullptr};
+    void (*write)(void* context, uint32_t offset, uint8_t data){nullptr};
+};
+
+// The 20-bit physical address space, split into fixed-size pages.
+//
+// A page either points straight at host memory, so a RAM or ROM access is a single indexed load or store, or refers
+// to a MemoryHandler. Pages mapped read-only (ROM) ignore writes. Unmapped pages read as open bus.
+class MemoryMap
+{
+public:
+    static constexpr uint32_t kAddressMask = 0xFFFFF;
+    static constexpr int kPageBits = 12;
+    static constexpr uint32_t kPageSize = 1u << kPageBits;
+    static constexpr uint32_t kPageMask = kPageSize - 1;
+    static constexpr std::size_t kPageCount = (kAddressMask + 1) >> kPageBits;
+
+    MemoryMap() {
+        clear();
+    }
+
+    void clear() {
+        read_.fill(nullptr);
+        write_.fill(nullptr);
+        devices_.fill({});
+    }
+
+    // Ranges must start and end on a page boundary and lie within the address space.
+    [[nodiscard]] static bool isValidRange(const uint32_t address, const uint32_t size) {
+        return (address & kPageMask) == 0 && (size & kPageMask) == 0 && size != 0 && address <= kAddressMask &&
+            size <= kAddressMask + 1 - address;
+    }
+
+    // Map host memory holding size bytes at address. Writes are dropped unless writable is set.
+    bool mapMemory(const uint32_t address, const uint32_t size, uint8_t* data, const bool writable) {
+        if (!isValidRange(address, size)) {
+            return false;
+        }
+        for (uint32_t offset = 0; offset < size; offset += kPageSize) {
+            const std::size_t page = (address + offset) >> kPageBits;
+            read_[page] = data + offset;
+            write_[page] = writable ? data + offset : nullptr;
+            devices_[page] = {};
+        }
+        return true;
+    }
+
+    bool mapDevice(const uint32_t address, const uint32_t size, const MemoryHandler& handler) {
+        if (!isValidRange(address, size)) {
+            return false;
+        }
+        for (uint32_t offset = 0; offset < size; offset += kPageSize) {
+            const std::size_t page = (address + offset) >> kPageBits;
+            read_[page] = nullptr;
+            write_[page] = nullptr;
+            devices_[page] = {handler, address};
+        }
+        return true;
+    }
+
+    bool unmap(const uint32_t address, const uint32_t size) {
+        if (!isValidRange(address, size)) {
+            return false;
+        }
+        for (uint32_t offset = 0; offset < size; offset += kPageSize) {
+            const std::size_t page = (address + offset) >> kPageBits;
+            read_[page] = nullptr;
+            write_[page] = nullptr;
+            devices_[page] = {};
+        }
+        return true;
+    }
+
+    // True if the address is RAM or ROM in host memory, which doesn't care when it is accessed, rather than a device.
+    [[nodiscard]] bool isHostMemory(const uint32_t address) const {
+        return read_[(address & kAddressMask) >> kPageBits] != nullptr;
+    }
+
+    [[nodiscard]] uint8_t read(uint32_t address) const {
+        address &= kAddressMask;
+        const uint8_t* data = read_[address >> kPageBits];
+        if (data != nullptr) {
+            return data[address & kPageMask];
+        }
+        const DevicePage& device = devices_[address >> kPageBits];
+        if (device.handler.read != nullptr) {
+            return device.handler.read(device.handler.context, address - device.base);
+        }
+        return 0xFF;
+    }
+
+    void write(uint32_t address, const uint8_t data) {
+        address &= kAddressMask;
+        uint8_t* page = write_[address >> kPageBits];
+        if (page != nullptr) {
+            page[address & kPageMask] = data;
+            return;
+        }
+        const DevicePage& device = devices_[address >> kPageBits];
+        if (device.handler.write != nullptr) {
+            device.handler.write(device.handler.context, address - device.base, data);
+        }
+    }
+
+private:
+    struct DevicePage
+    {
+        MemoryHandler handler;
+        uint32_t base{0}; // Start of the range the handler was mapped at
+    };
+
+    std::array<const uint8_t*, kPageCount> read_;
+    std::array<uint8_t*, kPageCount> write_;
+    std::array<DevicePage, kPageCount> devices_;
+};
@@ -0,0 +1,55 @@
+#ifndef MICROCODE_TABLES_H
+#define MICROCODE_TABLES_H
+
+#include <cstdint>
+
+// Decoded microcode, decoder PLA, translation PLA and group decode PLA tables.
+//
+// The tables of both CPUs are decoded from the ASCII ROM dumps in microcode/ by src/tools/MicrocodeTableGen.cpp,
+// which writes them out as constant data in MicrocodeTablesData.h. They live in read-only data shared by every Cpu
+// instantiation regardless of bus type or queue length, and nothing is decoded at run time.
+
+enum GroupDecodeFlags
+{
+    // The original 15 outputs of the Group decode PLA
+    groupMemory = 1, // This signal controls the M/IO (S2) status line
+    groupInitialEARead = 2, // This signal indicates that the effective address is read by the instruction.
+    groupMicrocodePointerFromOpcode = 4, // Group 3/4/5 opcode - microcode address will be determined by ModR/M.
+    groupNonPrefix = 8, // This line controls whether the instruction is a prefix or not.
+    groupEffectiveAddress = 0x10, // This signal indicates whether the instruction has a ModR/M byte.
+    groupAddSubBooleanRotate = 0x20, // This signal specifies the top bit for an ALU operation.
+    groupNonFlagSet = 0x40, // This signal determines whether the instruction directly updates flags (not CMC).
+    groupMNotAccumulator = 0x80, // This signal controls whether the instruction uses the AL or AX register for M.
+    groupNonSegregEA = 0x100, // This signal controls whether an instruction indexes a segment register.
+    groupNoDirectionBit = 0x200, // This signal controls whether an opcode encodes a direction bit.
+    groupMicrocoded = 0x400, // This signal indicates whether the instruction is microcoded or not.
+    groupNoWidthInOpcodeBit0 = 0x800, // This signal indicates whether the opcode encodes width in bit 0
+    groupByteOrWordAccess = 0x1000, // This signal indicates whether the instruction accesses byte or word data.
+    groupF1ZZFromPrefix = 0x2000,
+    groupIncDec = 0x4000, // This signal indicates whether carry is allowed to be updated.
+
+    // Direct column outputs
+    groupLoadRegisterImmediate = 0x10000,
+    groupWidthInOpcodeBit3 = 0x20000,
+    groupCMC = 0x40000,
+    groupHLT = 0x80000,
+    groupREP = 0x100000,
+    groupSegmentOverride = 0x200000,
+    groupLOCK = 0x400000,
+    groupCLI = 0x800000,
+
+    // This is not part of the PLA outputs, but we derive it here for convenience
+    groupLoadSegmentRegister = 0x1000000,
+};
+
+struct MicrocodeTables
+{
+    // Four bytes for each of the 512 decoded words - Destination, Source, (F + type), Operands
+    uint8_t microcode[4 * 512];
+    // Expanded 11-bit decoder PLA lookup. Sparse; unmapped entries are left at 0.
+    uint8_t microcodeIndex[2048];
+    uint16_t translation[256];
+    uint32_t groups[257];
+};
+
+#endif // MICROCODE_TABLES_H
@@ -0,0 +1,691 @@
+// Generated by src/tools/MicrocodeTableGen.cpp from the ROM dumps in microcode/. Do not edit; rebuild
+// the microcode_tables target instead.
+
+#ifndef MICROCODE_TABLES_DATA_H
+#define MICROCODE_TABLES_DATA_H
+
+#include "MicrocodeTables.h"
+
+// The decoded tables of each CPU. A class template, so that the tables can be defined in a header and still
+// exist once in the program.
+template <typename Unused = void>
+struct MicrocodeTableData
+{
+    static constexpr MicrocodeTables k8088 = {
+        // microcode
+        {
+            0x0D, 0x13, 0x04, 0x79, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x0C, 0x1E, 0x05, 0x83,
+            0x13, 0x05, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x12, 0x01, 0x88, 0x0D, 0x13, 0x04, 0x79, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x89, 0x12, 0x14, 0x0C, 0x78,
+            0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x89, 0x12, 0x14, 0x0C, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x12, 0x0D, 0x04, 0x78, 0x0C, 0x1F, 0x05, 0x83,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x0C, 0x1D, 0x05, 0x83,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x13, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x0F, 0x06, 0x5B,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x12, 0x06, 0x04, 0x78, 0x0C, 0x1B, 0x05, 0x83,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x13, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x0F, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x05, 0x04, 0x7F, 0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7F, 0x05, 0x0C, 0x04, 0x79,
+            0x12, 0x06, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x18, 0x04, 0x7D, 0x18, 0x0D, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x18, 0x01, 0x52, 0x0D, 0x14, 0x01, 0x5A, 0x07, 0x15, 0x00, 0x75, 0x1A, 0x17, 0x04, 0x7D,
+            0x0D, 0x14, 0x04, 0x78, 0x1A, 0x15, 0x04, 0x7D, 0x0D, 0x14, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x05, 0x0D, 0x06, 0x0F, 0x12, 0x06, 0x04, 0x78,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x05, 0x0D, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5F,
+            0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x0C, 0x06, 0x01, 0xEC, 0x0E, 0x1C, 0x04, 0x7B,
+            0x05, 0x14, 0x04, 0x7A, 0x06, 0x01, 0x06, 0x4A, 0x01, 0x0C, 0x01, 0x84, 0x06, 0x04, 0x05, 0x81,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x14, 0x07, 0x01, 0xEC, 0x16, 0x07, 0x05, 0x80,
+            0x0D, 0x12, 0x04, 0x7B, 0x05, 0x1C, 0x04, 0x7A, 0x06, 0x04, 0x01, 0xEC, 0x04, 0x0D, 0x04, 0x0F,
+            0x0E, 0x05, 0x04, 0x7F, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x06, 0x5B, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x01, 0xEC, 0x0E, 0x1C, 0x04, 0x7B, 0x05, 0x14, 0x04, 0x7A,
+            0x0C, 0x04, 0x01, 0x00, 0x04, 0x14, 0x04, 0x0F, 0x1C, 0x05, 0x00, 0x87, 0x06, 0x0C, 0x06, 0x5B,
+            0x0D, 0x12, 0x04, 0x7F, 0x12, 0x18, 0x04, 0x7D, 0x18, 0x0D, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x17, 0x04, 0x7F, 0x14, 0x19, 0x01, 0x80, 0x0D, 0x12, 0x00, 0x84, 0x0D, 0x14, 0x09, 0xC8,
+            0x0C, 0x14, 0x01, 0x8A, 0x07, 0x15, 0x00, 0xA3, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x0C, 0x12, 0x01, 0x20, 0x0D, 0x13, 0x04, 0x7D, 0x07, 0x14, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x21, 0x07, 0x14, 0x0C, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x18, 0x01, 0x21, 0x07, 0x14, 0x0C, 0x78,
+            0x07, 0x15, 0x00, 0x72, 0x08, 0x17, 0x04, 0x78, 0x08, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x13, 0x04, 0x7F, 0x0D, 0x12, 0x04, 0x7F, 0x13, 0x0D, 0x04, 0x79, 0x12, 0x0C, 0x04, 0x78,
+            0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x17, 0x01, 0x82, 0x05, 0x14, 0x06, 0x07, 0x12, 0x06, 0x04, 0x78,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x17, 0x01, 0x82, 0x05, 0x14, 0x04, 0x7F, 0x06, 0x18, 0x06, 0x57,
+            0x05, 0x1A, 0x06, 0x07, 0x12, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1A, 0x04, 0x7F, 0x06, 0x18, 0x06, 0x57, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1C, 0x06, 0x08, 0x07, 0x15, 0x04, 0x7B, 0x04, 0x06, 0x04, 0x0F, 0x1C, 0x05, 0x04, 0x78,
+            0x07, 0x15, 0x07, 0x80, 0x1C, 0x05, 0x04, 0x78, 0x05, 0x1C, 0x06, 0x08, 0x07, 0x15, 0x04, 0x7B,
+            0x04, 0x06, 0x00, 0xB6, 0x07, 0x15, 0x04, 0x0C, 0x07, 0x15, 0x06, 0x08, 0x01, 0x06, 0x04, 0x0C,
+            0x07, 0x15, 0x07, 0x80, 0x07, 0x15, 0x06, 0x08, 0x0F, 0x06, 0x04, 0x7F, 0x1C, 0x05, 0x04, 0x78,
+            0x14, 0x07, 0x01, 0x00, 0x16, 0x07, 0x07, 0x80, 0x0D, 0x05, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x07, 0x15, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A,
+            0x0C, 0x04, 0x01, 0x00, 0x04, 0x14, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x7B, 0x04, 0x12, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x04, 0x7B, 0x04, 0x0D, 0x06, 0x0F, 0x01, 0x06, 0x04, 0x08,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x14, 0x07, 0x04, 0x7F, 0x16, 0x07, 0x04, 0x7F,
+            0x07, 0x15, 0x04, 0x7B, 0x04, 0x0D, 0x04, 0x7F, 0x01, 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x07, 0x15, 0x05, 0xF2, 0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x12, 0x13, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x13, 0x06, 0x04, 0x7F, 0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x00, 0x06, 0x04, 0x78,
+            0x13, 0x06, 0x04, 0x7F, 0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x03, 0x06, 0x04, 0x78,
+            0x07, 0x15, 0x00, 0x53, 0x07, 0x15, 0x04, 0x47, 0x07, 0x15, 0x04, 0x78, 0x07, 0x15, 0x00, 0xE5,
+            0x07, 0x15, 0x00, 0x80, 0x07, 0x15, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A, 0x0E, 0x04, 0x01, 0xCC,
+            0x07, 0x15, 0x04, 0x7F, 0x0C, 0x0F, 0x04, 0x7F, 0x14, 0x10, 0x04, 0x7D, 0x0F, 0x0C, 0x04, 0x78,
+            0x07, 0x15, 0x04, 0x7D, 0x10, 0x0F, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x17, 0x04, 0x7F, 0x14, 0x18, 0x04, 0x7F, 0x0D, 0x1B, 0x01, 0x00, 0x05, 0x14, 0x06, 0x0F,
+            0x08, 0x06, 0x04, 0x78, 0x07, 0x15, 0x04, 0x7F, 0x0E, 0x19, 0x01, 0x84, 0x07, 0x14, 0x01, 0xCC,
+            0x07, 0x15, 0x00, 0xAA, 0x07, 0x15, 0x04, 0x78, 0x07, 0x15, 0x04, 0x7C, 0x07, 0x15, 0x04, 0x7F,
+            0x19, 0x0E, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A, 0x0D, 0x04, 0x01, 0xEA, 0x04, 0x14, 0x04, 0x08,
+            0x05, 0x1F, 0x07, 0xD1, 0x06, 0x12, 0x06, 0x41, 0x1F, 0x05, 0x00, 0x95, 0x0E, 0x14, 0x05, 0xE8,
+            0x07, 0x15, 0x07, 0xD1, 0x0C, 0x12, 0x00, 0xB5, 0x05, 0x1E, 0x06, 0x0D, 0x1E, 0x05, 0x04, 0x7F,
+            0x0C, 0x06, 0x04, 0x7F, 0x05, 0x1F, 0x06, 0x01, 0x0D, 0x06, 0x01, 0x28, 0x07, 0x14, 0x09, 0xCC,
+            0x1F, 0x05, 0x00, 0x9C, 0x19, 0x14, 0x00, 0x0C, 0x0E, 0x14, 0x05, 0xE8, 0x07, 0x15, 0x00, 0xA1,
+            0x07, 0x15, 0x07, 0xD1, 0x05, 0x1E, 0x06, 0x0D, 0x1E, 0x05, 0x00, 0xB8, 0x05, 0x1F, 0x06, 0x41,
+            0x1F, 0x05, 0x00, 0x97, 0x0E, 0x14, 0x05, 0xE8, 0x19, 0x0E, 0x00, 0xA1, 0x07, 0x15, 0x04, 0x78,
+            0x0E, 0x19, 0x01, 0x84, 0x07, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x00, 0xA4, 0x07, 0x15, 0x05, 0x82,
+            0x0E, 0x19, 0x01, 0xCC, 0x19, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x00, 0x04, 0x07, 0x15, 0x05, 0xA2,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0E, 0x19, 0x01, 0xCC, 0x19, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x05, 0xA2, 0x07, 0x15, 0x04, 0x78,
+            0x14, 0x08, 0x01, 0x88, 0x0D, 0x15, 0x04, 0x7F, 0x08, 0x14, 0x09, 0x01, 0x07, 0x15, 0x04, 0x78,
+            0x14, 0x08, 0x01, 0x88, 0x0D, 0x15, 0x04, 0x7F, 0x08, 0x14, 0x09, 0xCA, 0x07, 0x15, 0x00, 0xB5,
+            0x07, 0x15, 0x01, 0xC2, 0x0D, 0x10, 0x00, 0xC7, 0x10, 0x14, 0x04, 0x78, 0x07, 0x15, 0x04, 0x78,
+            0x0E, 0x08, 0x01, 0x54, 0x0D, 0x12, 0x07, 0xB4, 0x07, 0x15, 0x07, 0x82, 0x07, 0x15, 0x07, 0xD5,
+            0x07, 0x15, 0x07, 0xB6, 0x08, 0x0E, 0x00, 0xB7, 0x07, 0x15, 0x07, 0x87, 0x10, 0x0C, 0x04, 0x78,
+            0x0E, 0x18, 0x01, 0x54, 0x0D, 0x12, 0x07, 0xB4, 0x07, 0x15, 0x07, 0x82, 0x07, 0x15, 0x07, 0xD5,
+            0x07, 0x15, 0x07, 0xB6, 0x18, 0x0E, 0x00, 0xB7, 0x07, 0x15, 0x07, 0x87, 0x1A, 0x0C, 0x04, 0x78,
+            0x0C, 0x10, 0x04, 0x7F, 0x0E, 0x08, 0x01, 0x50, 0x0D, 0x12, 0x07, 0xB8, 0x07, 0x15, 0x07, 0x83,
+            0x07, 0x15, 0x01, 0xD4, 0x0D, 0x10, 0x07, 0xB9, 0x08, 0x14, 0x04, 0x7D, 0x10, 0x0C, 0x04, 0x78,
+            0x0C, 0x1A, 0x04, 0x7F, 0x0E, 0x18, 0x01, 0x50, 0x0D, 0x12, 0x07, 0xB8, 0x07, 0x15, 0x07, 0x83,
+            0x07, 0x15, 0x01, 0xD4, 0x0D, 0x1A, 0x07, 0xB9, 0x18, 0x14, 0x04, 0x7D, 0x1A, 0x0C, 0x04, 0x78,
+            0x0E, 0x07, 0x04, 0x7F, 0x0D, 0x10, 0x07, 0x82, 0x0D, 0x08, 0x01, 0x04, 0x10, 0x17, 0x05, 0x89,
+            0x0D, 0x07, 0x04, 0x7F, 0x0C, 0x17, 0x04, 0x7F, 0x0E, 0x08, 0x07, 0x83, 0x07, 0x15, 0x01, 0xD4,
+            0x10, 0x14, 0x01, 0x81, 0x08, 0x14, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x04, 0x7F, 0x0C, 0x17, 0x01, 0x5C,
+            0x0E, 0x14, 0x04, 0x07, 0x07, 0x15, 0x00, 0xC8, 0x07, 0x15, 0x01, 0x00, 0x0C, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x01, 0x58, 0x0C, 0x14, 0x01, 0x5C, 0x0E, 0x14, 0x00, 0x45, 0x07, 0x15, 0x04, 0x7C,
+            0x07, 0x15, 0x01, 0x28, 0x07, 0x14, 0x0C, 0x07, 0x07, 0x15, 0x05, 0xC7, 0x07, 0x15, 0x01, 0x54,
+            0x0E, 0x14, 0x01, 0x50, 0x0C, 0x14, 0x01, 0x28, 0x07, 0x15, 0x00, 0x7D, 0x07, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x00, 0xCE, 0x07, 0x15, 0x00, 0x43, 0x07, 0x15, 0x01, 0x54, 0x0E, 0x14, 0x04, 0x7F,
+            0x07, 0x14, 0x04, 0x7C, 0x07, 0x15, 0x04, 0x27, 0x0C, 0x14, 0x00, 0x43, 0x07, 0x15, 0x00, 0x8A,
+            0x15, 0x16, 0x00, 0x86, 0x15, 0x16, 0x00, 0x86, 0x0E, 0x18, 0x06, 0x27, 0x18, 0x06, 0x04, 0x7B,
+            0x15, 0x10, 0x04, 0x7F, 0x18, 0x0E, 0x04, 0x7F, 0x17, 0x17, 0x01, 0x02, 0x0D, 0x14, 0x04, 0x7F,
+            0x05, 0x14, 0x06, 0x04, 0x0D, 0x06, 0x01, 0xEC, 0x0E, 0x1C, 0x06, 0x07, 0x0C, 0x06, 0x04, 0x7B,
+            0x06, 0x0F, 0x04, 0x1F, 0x05, 0x14, 0x06, 0x4B, 0x0E, 0x05, 0x05, 0x85, 0x15, 0x16, 0x00, 0x86,
+            0x15, 0x07, 0x05, 0x86, 0x06, 0x0D, 0x05, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x7F, 0x07, 0x15, 0x00, 0x63, 0x07, 0x15, 0x04, 0x78, 0x15, 0x16, 0x05, 0x86,
+            0x07, 0x15, 0x00, 0x82, 0x07, 0x15, 0x04, 0x7F, 0x15, 0x16, 0x05, 0x86, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x14, 0x04, 0x7F, 0x07, 0x15, 0x00, 0xC7, 0x07, 0x15, 0x01, 0xDC, 0x0E, 0x14, 0x09, 0xD0,
+            0x07, 0x15, 0x00, 0x76, 0x07, 0x15, 0x01, 0xD8, 0x0C, 0x14, 0x04, 0x17, 0x07, 0x15, 0x01, 0x52,
+            0x07, 0x14, 0x01, 0xDA, 0x07, 0x15, 0x00, 0xCB, 0x0D, 0x14, 0x04, 0x14, 0x07, 0x15, 0x04, 0x7C,
+            0x07, 0x14, 0x01, 0xDC, 0x07, 0x15, 0x00, 0xC7, 0x0E, 0x14, 0x04, 0x17, 0x07, 0x15, 0x00, 0x87,
+            0x07, 0x15, 0x05, 0xC7, 0x07, 0x15, 0x01, 0x52, 0x07, 0x14, 0x01, 0xD8, 0x07, 0x15, 0x00, 0xC5,
+            0x0C, 0x14, 0x04, 0x7F, 0x07, 0x15, 0x01, 0xC4, 0x07, 0x15, 0x00, 0xD8, 0x07, 0x15, 0x01, 0xD4,
+            0x07, 0x15, 0x04, 0x34, 0x0D, 0x17, 0x01, 0x54, 0x07, 0x14, 0x01, 0x10, 0x07, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x00, 0x38, 0x07, 0x15, 0x04, 0x3C, 0x07, 0x15, 0x01, 0x80, 0x07, 0x14, 0x08, 0x8C,
+            0x0C, 0x1B, 0x04, 0x7F, 0x0D, 0x1E, 0x04, 0x7F, 0x0C, 0x14, 0x05, 0x83, 0x0C, 0x1D, 0x04, 0x7F,
+            0x0D, 0x1F, 0x04, 0x7F, 0x0C, 0x14, 0x05, 0x83, 0x0C, 0x1B, 0x00, 0x84, 0x0C, 0x1D, 0x00, 0x81,
+            0x14, 0x07, 0x04, 0x7F, 0x16, 0x07, 0x05, 0x84, 0x15, 0x07, 0x00, 0x1C, 0x17, 0x07, 0x04, 0x7F,
+            0x0C, 0x14, 0x05, 0x84, 0x05, 0x0C, 0x06, 0x0F, 0x0D, 0x06, 0x04, 0x7C, 0x05, 0x0C, 0x04, 0x7C,
+            0x03, 0x17, 0x04, 0x7B, 0x01, 0x15, 0x04, 0x7F, 0x04, 0x17, 0x04, 0x0F, 0x0F, 0x17, 0x04, 0x7F,
+            0x00, 0x17, 0x04, 0x7F, 0x02, 0x17, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x04, 0x14, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x19, 0x0E, 0x00, 0xA1, 0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x12, 0x06, 0x00, 0xD5, 0x07, 0x15, 0x04, 0x78, 0x14, 0x05, 0x09, 0x54, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x08, 0x05, 0xE5, 0x0A, 0x11, 0x0D, 0x86,
+        },
+        // microcodeIndex
+        {
+            0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x53, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x53, 0x00, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+            0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+            0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+            0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00,
+            0x25, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x29, 0x2A, 0x00, 0x00, 0x29, 0x2A, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x3B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x00, 0x00, 0x10, 0x11, 0x00, 0x00,
+            0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+            0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+            0x15, 0x00, 0x00, 0x00, 0x16, 0x17, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x3E, 0x3F, 0x7B, 0x00,
+            0x0C, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00,
+            0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+            0x4B, 0x4C, 0x7E, 0x00, 0x4B, 0x4C, 0x7E, 0x00, 0x48, 0x49, 0x4A, 0x7D, 0x48, 0x49, 0x4A, 0x7D,
+            0x27, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x47, 0x7C, 0x00, 0x00, 0x47, 0x7C, 0x00, 0x00,
+            0x4B, 0x4C, 0x7E, 0x00, 0x4B, 0x4C, 0x7E, 0x00, 0x48, 0x49, 0x4A, 0x7D, 0x48, 0x49, 0x4A, 0x7D,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x33, 0x00, 0x00, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x2F, 0x00, 0x00, 0x00,
+            0x3C, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+            0x33, 0x00, 0x00, 0x00, 0x30, 0x31, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x30, 0x31, 0x00, 0x00,
+            0x6C, 0x00, 0x00, 0x00, 0x6A, 0x00, 0x00, 0x00, 0x6B, 0x00, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00,
+            0x22, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x23, 0x24, 0x00, 0x00, 0x23, 0x24, 0x00, 0x00,
+            0x5D, 0x5E, 0x00, 0x00, 0x5C, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x43, 0x44, 0x45, 0x46,
+            0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+            0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+            0x4E, 0x4F, 0x00, 0x00, 0x4E, 0x4F, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x4D, 0x7F, 0x00, 0x00,
+            0x2B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+            0x1F, 0x20, 0x00, 0x00, 0x34, 0x35, 0x00, 0x00, 0x38, 0x39, 0x00, 0x00, 0x34, 0x35, 0x00, 0x00,
+            0x2D, 0x00, 0x00, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00,
+            0x26, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+            0x54, 0x55, 0x00, 0x00, 0x54, 0x55, 0x00, 0x00, 0x58, 0x59, 0x00, 0x00, 0x58, 0x59, 0x00, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1D, 0x1E, 0x00, 0x00, 0x1A, 0x1B, 0x00, 0x00,
+            0x36, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+            0x66, 0x67, 0x68, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x63, 0x64, 0x65, 0x6D, 0x6E, 0x6F, 0x70,
+            0x71, 0x72, 0x73, 0x74, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x75, 0x76, 0x77, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x79, 0x7A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x26, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+            0x56, 0x57, 0x00, 0x00, 0x56, 0x57, 0x00, 0x00, 0x5A, 0x5B, 0x00, 0x00, 0x5A, 0x5B, 0x00, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1D, 0x1E, 0x00, 0x00, 0x1A, 0x1B, 0x00, 0x00,
+            0x36, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+        },
+        // translation
+        {
+            0x3F67, 0x3F67, 0x2800, 0x2800, 0x3F67, 0x3F67, 0x2800, 0x2800,
+            0x3F47, 0x3F47, 0x280C, 0x280C, 0x3F47, 0x3F47, 0x280C, 0x280C,
+            0x1D65, 0x1D65, 0x280F, 0x280F, 0x1D65, 0x1D65, 0x280F, 0x280F,
+            0x2815, 0x281B, 0x2807, 0x2807, 0x2815, 0x281F, 0x2807, 0x2807,
+            0x281B, 0x281B, 0x1166, 0x1166, 0x281F, 0x281F, 0x1166, 0x1166,
+            0x3F69, 0x3F69, 0x17E6, 0x17E6, 0x3F69, 0x3F69, 0x17E6, 0x17E6,
+            0x200D, 0x200D, 0x2810, 0x2810, 0x200D, 0x200D, 0x2810, 0x2810,
+            0x201F, 0x201F, 0x0BE6, 0x0BE6, 0x201F, 0x201F, 0x0BE6, 0x0BE6,
+            0x1AF9, 0x1AF9, 0x2800, 0x2800, 0x1AF9, 0x1AF9, 0x2800, 0x2800,
+            0x1A8B, 0x1A8B, 0x280C, 0x280C, 0x1A8B, 0x1A8B, 0x280C, 0x280C,
+            0x0000, 0x0000, 0x280F, 0x280F, 0x0000, 0x0000, 0x280F, 0x280F,
+            0x0000, 0x0000, 0x2807, 0x2807, 0x0000, 0x0000, 0x2807, 0x2807,
+            0x0000, 0x0000, 0x1166, 0x1166, 0x0000, 0x0000, 0x1166, 0x1166,
+            0x0000, 0x0000, 0x17E6, 0x17E6, 0x0000, 0x0000, 0x17E6, 0x17E6,
+            0x0000, 0x0000, 0x3F27, 0x3F27, 0x0000, 0x0000, 0x3F27, 0x3F27,
+            0x0000, 0x0000, 0x0BE6, 0x0BE6, 0x0000, 0x0000, 0x0BE6, 0x0BE6,
+            0x1965, 0x1965, 0x2800, 0x2800, 0x1965, 0x1965, 0x2800, 0x2800,
+            0x1AED, 0x1AED, 0x280C, 0x280C, 0x1AED, 0x1AED, 0x280C, 0x280C,
+            0x09E7, 0x09E7, 0x280F, 0x280F, 0x09E7, 0x09E7, 0x280F, 0x280F,
+            0x2441, 0x2441, 0x2807, 0x2807, 0x2441, 0x2441, 0x2807, 0x2807,
+            0x2479, 0x2479, 0x1166, 0x1166, 0x2479, 0x2479, 0x1166, 0x1166,
+            0x2465, 0x2465, 0x17E6, 0x17E6, 0x2465, 0x2465, 0x17E6, 0x17E6,
+            0x2493, 0x2493, 0x3F27, 0x3F27, 0x2493, 0x2493, 0x3F27, 0x3F27,
+            0x249D, 0x249D, 0x0BE6, 0x0BE6, 0x249D, 0x249D, 0x0BE6, 0x0BE6,
+            0x2461, 0x2461, 0x2800, 0x2800, 0x2461, 0x2461, 0x2800, 0x2800,
+            0x2481, 0x2481, 0x280C, 0x280C, 0x2481, 0x2481, 0x280C, 0x280C,
+            0x0000, 0x0000, 0x280F, 0x280F, 0x0000, 0x0000, 0x280F, 0x280F,
+            0x0000, 0x0000, 0x2807, 0x2807, 0x0000, 0x0000, 0x2807, 0x2807,
+            0x0000, 0x0000, 0x1166, 0x1166, 0x0000, 0x0000, 0x1166, 0x1166,
+            0x0000, 0x0000, 0x17E6, 0x17E6, 0x0000, 0x0000, 0x17E6, 0x17E6,
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x0000, 0x0000, 0x0BE6, 0x0BE6, 0x0000, 0x0000, 0x0BE6, 0x0BE6,
+        },
+        // groups
+        {
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF,
+            0x00035DD, 0x00035DD, 0x00035DF, 0x00035DF, 0x0003CDD, 0x0003FDD, 0x1003CDF, 0x0003FDD,
+            0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD,
+            0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD,
+            0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D,
+            0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D,
+            0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD,
+            0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD,
+            0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FDF, 0x0003FDF, 0x00037DD, 0x00037DD,
+            0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF,
+            0x00037FF, 0x00037FF, 0x00037FF, 0x00037FF, 0x0002FCF, 0x0002FCF, 0x0002FCF, 0x0002FCF,
+            0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF,
+            0x0001FCF, 0x0001FCF, 0x0001FCF, 0x0001FCF, 0x000374C, 0x000374C, 0x000374C, 0x000374C,
+            0x0001FCF, 0x0001FCF, 0x0001FCF, 0x0001FCF, 0x000374C, 0x000374C, 0x000374C, 0x000374C,
+            0x0403BC5, 0x0403BC5, 0x0103BC5, 0x0103BC5, 0x0083BCD, 0x0043BCD, 0x00037DB, 0x00037DB,
+            0x0003B8D, 0x0003B8D, 0x0803B8D, 0x0003B8D, 0x0003B8D, 0x0003B8D, 0x00077DB, 0x00077DB,
+            0x0003FCF,
+        },
+    };
+    static constexpr MicrocodeTables k8086 = {
+        // microcode
+        {
+            0x0D, 0x13, 0x04, 0x79, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x0C, 0x1E, 0x05, 0x83,
+            0x13, 0x05, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x12, 0x01, 0x88, 0x0D, 0x13, 0x04, 0x79, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x89, 0x12, 0x14, 0x0C, 0x78,
+            0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x89, 0x12, 0x14, 0x0C, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x12, 0x0D, 0x04, 0x78, 0x0C, 0x1F, 0x05, 0x83,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x0C, 0x1D, 0x05, 0x83,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x13, 0x06, 0x5B,
+            0x0C, 0x1C, 0x01, 0xE8, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x7F, 0x06, 0x0F, 0x06, 0x5B,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x12, 0x06, 0x04, 0x78, 0x0C, 0x1B, 0x05, 0x83,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x13, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7D, 0x0F, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x05, 0x04, 0x7F, 0x05, 0x1C, 0x06, 0x08, 0x1C, 0x05, 0x04, 0x7F, 0x05, 0x0C, 0x04, 0x79,
+            0x12, 0x06, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x18, 0x04, 0x7D, 0x18, 0x0D, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x18, 0x01, 0x52, 0x0D, 0x14, 0x01, 0x5A, 0x07, 0x15, 0x00, 0x75, 0x1A, 0x17, 0x04, 0x7D,
+            0x0D, 0x14, 0x04, 0x78, 0x1A, 0x15, 0x04, 0x7D, 0x0D, 0x14, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x05, 0x0D, 0x06, 0x0F, 0x12, 0x06, 0x04, 0x78,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x05, 0x0D, 0x04, 0x7F, 0x06, 0x12, 0x06, 0x5F,
+            0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x0C, 0x06, 0x01, 0xEC, 0x0E, 0x1C, 0x04, 0x7B,
+            0x05, 0x14, 0x04, 0x7A, 0x06, 0x01, 0x06, 0x4A, 0x01, 0x0C, 0x01, 0x84, 0x06, 0x04, 0x05, 0x81,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x14, 0x07, 0x01, 0xEC, 0x16, 0x07, 0x05, 0x80,
+            0x0D, 0x12, 0x04, 0x7B, 0x05, 0x1C, 0x04, 0x7A, 0x06, 0x04, 0x01, 0xEC, 0x04, 0x0D, 0x04, 0x0F,
+            0x0E, 0x05, 0x04, 0x7F, 0x05, 0x14, 0x04, 0x7F, 0x1C, 0x14, 0x06, 0x5B, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x01, 0xEC, 0x0E, 0x1C, 0x04, 0x7B, 0x05, 0x14, 0x04, 0x7A,
+            0x0C, 0x04, 0x01, 0x00, 0x04, 0x14, 0x04, 0x0F, 0x1C, 0x05, 0x00, 0x87, 0x06, 0x0C, 0x06, 0x5B,
+            0x0D, 0x12, 0x04, 0x7F, 0x12, 0x18, 0x04, 0x7D, 0x18, 0x0D, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x17, 0x04, 0x7F, 0x14, 0x19, 0x01, 0x80, 0x0D, 0x12, 0x00, 0x84, 0x0D, 0x14, 0x09, 0xC8,
+            0x0C, 0x14, 0x01, 0x8A, 0x07, 0x15, 0x00, 0xA3, 0x12, 0x0D, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F,
+            0x0C, 0x12, 0x01, 0x20, 0x0D, 0x13, 0x04, 0x7D, 0x07, 0x14, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x12, 0x01, 0x21, 0x07, 0x14, 0x0C, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x0C, 0x18, 0x01, 0x21, 0x07, 0x14, 0x0C, 0x78,
+            0x07, 0x15, 0x00, 0x72, 0x08, 0x17, 0x04, 0x78, 0x08, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x13, 0x04, 0x7F, 0x0D, 0x12, 0x04, 0x7F, 0x13, 0x0D, 0x04, 0x79, 0x12, 0x0C, 0x04, 0x78,
+            0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x17, 0x01, 0x82, 0x05, 0x14, 0x06, 0x07, 0x12, 0x06, 0x04, 0x78,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x17, 0x01, 0x82, 0x05, 0x14, 0x04, 0x7F, 0x06, 0x18, 0x06, 0x57,
+            0x05, 0x1A, 0x06, 0x07, 0x12, 0x06, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1A, 0x04, 0x7F, 0x06, 0x18, 0x06, 0x57, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x1C, 0x06, 0x08, 0x07, 0x15, 0x04, 0x7B, 0x04, 0x06, 0x04, 0x0F, 0x1C, 0x05, 0x04, 0x78,
+            0x07, 0x15, 0x07, 0x80, 0x1C, 0x05, 0x04, 0x78, 0x05, 0x1C, 0x06, 0x08, 0x07, 0x15, 0x04, 0x7B,
+            0x04, 0x06, 0x00, 0xB6, 0x07, 0x15, 0x04, 0x0C, 0x07, 0x15, 0x06, 0x08, 0x01, 0x06, 0x04, 0x0C,
+            0x07, 0x15, 0x07, 0x80, 0x07, 0x15, 0x06, 0x08, 0x0F, 0x06, 0x04, 0x7F, 0x1C, 0x05, 0x04, 0x78,
+            0x14, 0x07, 0x01, 0x00, 0x16, 0x07, 0x07, 0x80, 0x0D, 0x05, 0x04, 0x7F, 0x1C, 0x14, 0x04, 0x78,
+            0x15, 0x07, 0x00, 0x22, 0x17, 0x07, 0x04, 0x7F, 0x07, 0x15, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A,
+            0x0C, 0x04, 0x01, 0x00, 0x04, 0x14, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x7B, 0x04, 0x12, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x04, 0x7B, 0x04, 0x0D, 0x06, 0x0F, 0x01, 0x06, 0x04, 0x08,
+            0x15, 0x07, 0x04, 0x7F, 0x17, 0x07, 0x04, 0x7F, 0x14, 0x07, 0x04, 0x7F, 0x16, 0x07, 0x04, 0x7F,
+            0x07, 0x15, 0x04, 0x7B, 0x04, 0x0D, 0x04, 0x7F, 0x01, 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00,
+            0x15, 0x07, 0x04, 0x7F, 0x07, 0x15, 0x05, 0xF2, 0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00,
+            0x12, 0x13, 0x04, 0x78, 0x07, 0x15, 0x06, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x13, 0x06, 0x04, 0x7F, 0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x00, 0x06, 0x04, 0x78,
+            0x13, 0x06, 0x04, 0x7F, 0x0E, 0x05, 0x01, 0xE4, 0x05, 0x14, 0x06, 0x0F, 0x03, 0x06, 0x04, 0x78,
+            0x07, 0x15, 0x00, 0x53, 0x07, 0x15, 0x04, 0x47, 0x07, 0x15, 0x04, 0x78, 0x07, 0x15, 0x00, 0xE5,
+            0x07, 0x15, 0x00, 0x80, 0x07, 0x15, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A, 0x0E, 0x04, 0x01, 0xCC,
+            0x07, 0x15, 0x04, 0x7F, 0x0C, 0x0F, 0x04, 0x7F, 0x14, 0x10, 0x04, 0x7D, 0x0F, 0x0C, 0x04, 0x78,
+            0x07, 0x15, 0x04, 0x7D, 0x10, 0x0F, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0C, 0x17, 0x04, 0x7F, 0x14, 0x18, 0x04, 0x7F, 0x0D, 0x1B, 0x01, 0x00, 0x05, 0x14, 0x06, 0x0F,
+            0x08, 0x06, 0x04, 0x78, 0x07, 0x15, 0x04, 0x7F, 0x0E, 0x19, 0x01, 0x84, 0x07, 0x14, 0x01, 0xCC,
+            0x07, 0x15, 0x00, 0xAA, 0x07, 0x15, 0x04, 0x78, 0x07, 0x15, 0x04, 0x7C, 0x07, 0x15, 0x04, 0x7F,
+            0x19, 0x0E, 0x04, 0x7B, 0x07, 0x15, 0x04, 0x7A, 0x0D, 0x04, 0x01, 0xEA, 0x04, 0x14, 0x04, 0x08,
+            0x05, 0x1F, 0x07, 0xD1, 0x06, 0x12, 0x06, 0x41, 0x1F, 0x05, 0x00, 0x95, 0x0E, 0x14, 0x05, 0xE8,
+            0x07, 0x15, 0x07, 0xD1, 0x0C, 0x12, 0x00, 0xB5, 0x05, 0x1E, 0x06, 0x0D, 0x1E, 0x05, 0x04, 0x7F,
+            0x0C, 0x06, 0x04, 0x7F, 0x05, 0x1F, 0x06, 0x01, 0x0D, 0x06, 0x01, 0x28, 0x07, 0x14, 0x09, 0xCC,
+            0x1F, 0x05, 0x00, 0x9C, 0x19, 0x14, 0x00, 0x0C, 0x0E, 0x14, 0x05, 0xE8, 0x07, 0x15, 0x00, 0xA1,
+            0x07, 0x15, 0x07, 0xD1, 0x05, 0x1E, 0x06, 0x0D, 0x1E, 0x05, 0x00, 0xB8, 0x05, 0x1F, 0x06, 0x41,
+            0x1F, 0x05, 0x00, 0x97, 0x0E, 0x14, 0x05, 0xE8, 0x19, 0x0E, 0x00, 0xA1, 0x07, 0x15, 0x04, 0x78,
+            0x0E, 0x19, 0x01, 0x84, 0x07, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x00, 0xA4, 0x07, 0x15, 0x05, 0x82,
+            0x0E, 0x19, 0x01, 0xCC, 0x19, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x00, 0x04, 0x07, 0x15, 0x05, 0xA2,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0E, 0x19, 0x01, 0xCC, 0x19, 0x14, 0x04, 0x7F, 0x15, 0x07, 0x05, 0xA2, 0x07, 0x15, 0x04, 0x78,
+            0x14, 0x08, 0x01, 0x88, 0x0D, 0x15, 0x04, 0x7F, 0x08, 0x14, 0x09, 0x01, 0x07, 0x15, 0x04, 0x78,
+            0x14, 0x08, 0x01, 0x88, 0x0D, 0x15, 0x04, 0x7F, 0x08, 0x14, 0x09, 0xCA, 0x07, 0x15, 0x00, 0xB5,
+            0x07, 0x15, 0x01, 0xC2, 0x0D, 0x10, 0x00, 0xC7, 0x10, 0x14, 0x04, 0x78, 0x07, 0x15, 0x04, 0x78,
+            0x0E, 0x08, 0x01, 0x54, 0x0D, 0x12, 0x07, 0xB4, 0x07, 0x15, 0x07, 0x82, 0x07, 0x15, 0x07, 0xD5,
+            0x07, 0x15, 0x07, 0xB6, 0x08, 0x0E, 0x00, 0xB7, 0x07, 0x15, 0x07, 0x87, 0x10, 0x0C, 0x04, 0x78,
+            0x0E, 0x18, 0x01, 0x54, 0x0D, 0x12, 0x07, 0xB4, 0x07, 0x15, 0x07, 0x82, 0x07, 0x15, 0x07, 0xD5,
+            0x07, 0x15, 0x07, 0xB6, 0x18, 0x0E, 0x00, 0xB7, 0x07, 0x15, 0x07, 0x87, 0x1A, 0x0C, 0x04, 0x78,
+            0x0C, 0x10, 0x04, 0x7F, 0x0E, 0x08, 0x01, 0x50, 0x0D, 0x12, 0x07, 0xB8, 0x07, 0x15, 0x07, 0x83,
+            0x07, 0x15, 0x01, 0xD4, 0x0D, 0x10, 0x07, 0xB9, 0x08, 0x14, 0x04, 0x7D, 0x10, 0x0C, 0x04, 0x78,
+            0x0C, 0x1A, 0x04, 0x7F, 0x0E, 0x18, 0x01, 0x50, 0x0D, 0x12, 0x07, 0xB8, 0x07, 0x15, 0x07, 0x83,
+            0x07, 0x15, 0x01, 0xD4, 0x0D, 0x1A, 0x07, 0xB9, 0x18, 0x14, 0x04, 0x7D, 0x1A, 0x0C, 0x04, 0x78,
+            0x0E, 0x07, 0x04, 0x7F, 0x0D, 0x10, 0x07, 0x82, 0x0D, 0x08, 0x01, 0x04, 0x10, 0x17, 0x05, 0x89,
+            0x0D, 0x07, 0x04, 0x7F, 0x0C, 0x17, 0x04, 0x7F, 0x0E, 0x08, 0x07, 0x83, 0x07, 0x15, 0x01, 0xD4,
+            0x10, 0x14, 0x01, 0x81, 0x08, 0x14, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0D, 0x12, 0x01, 0x8B, 0x12, 0x14, 0x0C, 0x78, 0x07, 0x15, 0x04, 0x7F, 0x0C, 0x17, 0x01, 0x5C,
+            0x0E, 0x14, 0x04, 0x07, 0x07, 0x15, 0x00, 0xC8, 0x07, 0x15, 0x01, 0x00, 0x0C, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x01, 0x58, 0x0C, 0x14, 0x01, 0x5C, 0x0E, 0x14, 0x00, 0x45, 0x07, 0x15, 0x04, 0x7C,
+            0x07, 0x15, 0x01, 0x28, 0x07, 0x14, 0x0C, 0x07, 0x07, 0x15, 0x05, 0xC7, 0x07, 0x15, 0x01, 0x54,
+            0x0E, 0x14, 0x01, 0x50, 0x0C, 0x14, 0x01, 0x28, 0x07, 0x15, 0x00, 0x7D, 0x07, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x00, 0xCE, 0x07, 0x15, 0x00, 0x43, 0x07, 0x15, 0x01, 0x54, 0x0E, 0x14, 0x04, 0x7F,
+            0x07, 0x14, 0x04, 0x7C, 0x07, 0x15, 0x04, 0x27, 0x0C, 0x14, 0x00, 0x43, 0x07, 0x15, 0x00, 0x8A,
+            0x06, 0x16, 0x00, 0x85, 0x06, 0x16, 0x00, 0x85, 0x05, 0x17, 0x06, 0x27, 0x07, 0x15, 0x04, 0x7B,
+            0x07, 0x15, 0x06, 0x27, 0x15, 0x06, 0x04, 0x7B, 0x17, 0x17, 0x01, 0x02, 0x0D, 0x14, 0x04, 0x7F,
+            0x05, 0x14, 0x06, 0x04, 0x0D, 0x06, 0x01, 0xEC, 0x0E, 0x1C, 0x06, 0x07, 0x0C, 0x06, 0x04, 0x7F,
+            0x06, 0x0F, 0x04, 0x1F, 0x05, 0x14, 0x06, 0x4B, 0x0E, 0x05, 0x05, 0x85, 0x06, 0x16, 0x00, 0x85,
+            0x0D, 0x07, 0x04, 0x7F, 0x06, 0x0D, 0x05, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x7F, 0x07, 0x15, 0x00, 0x63, 0x07, 0x15, 0x04, 0x78, 0x06, 0x16, 0x05, 0x86,
+            0x07, 0x15, 0x00, 0x82, 0x07, 0x15, 0x04, 0x7F, 0x06, 0x16, 0x05, 0x86, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x14, 0x04, 0x7F, 0x07, 0x15, 0x00, 0xC7, 0x07, 0x15, 0x01, 0xDC, 0x0E, 0x14, 0x09, 0xD0,
+            0x07, 0x15, 0x00, 0x76, 0x07, 0x15, 0x01, 0xD8, 0x0C, 0x14, 0x04, 0x17, 0x07, 0x15, 0x01, 0x52,
+            0x07, 0x14, 0x01, 0xDA, 0x07, 0x15, 0x00, 0xCB, 0x0D, 0x14, 0x04, 0x14, 0x07, 0x15, 0x04, 0x7C,
+            0x07, 0x14, 0x01, 0xDC, 0x07, 0x15, 0x00, 0xC7, 0x0E, 0x14, 0x04, 0x17, 0x07, 0x15, 0x00, 0x87,
+            0x07, 0x15, 0x05, 0xC7, 0x07, 0x15, 0x01, 0x52, 0x07, 0x14, 0x01, 0xD8, 0x07, 0x15, 0x00, 0xC5,
+            0x0C, 0x14, 0x04, 0x7F, 0x07, 0x15, 0x01, 0xC4, 0x07, 0x15, 0x00, 0xD8, 0x07, 0x15, 0x01, 0xD4,
+            0x07, 0x15, 0x04, 0x34, 0x0D, 0x17, 0x01, 0x54, 0x07, 0x14, 0x01, 0x10, 0x07, 0x14, 0x0C, 0x7F,
+            0x07, 0x15, 0x00, 0x38, 0x07, 0x15, 0x04, 0x3C, 0x07, 0x15, 0x01, 0x80, 0x07, 0x14, 0x08, 0x8C,
+            0x0C, 0x1B, 0x04, 0x7F, 0x0D, 0x1E, 0x04, 0x7F, 0x0C, 0x14, 0x05, 0x83, 0x0C, 0x1D, 0x04, 0x7F,
+            0x0D, 0x1F, 0x04, 0x7F, 0x0C, 0x14, 0x05, 0x83, 0x0C, 0x1B, 0x00, 0x84, 0x0C, 0x1D, 0x00, 0x81,
+            0x14, 0x07, 0x04, 0x7F, 0x16, 0x07, 0x05, 0x84, 0x15, 0x07, 0x00, 0x1C, 0x17, 0x07, 0x04, 0x7F,
+            0x0C, 0x14, 0x05, 0x84, 0x05, 0x0C, 0x06, 0x0F, 0x0D, 0x06, 0x04, 0x7C, 0x05, 0x0C, 0x04, 0x7C,
+            0x03, 0x17, 0x04, 0x7B, 0x01, 0x15, 0x04, 0x7F, 0x04, 0x17, 0x04, 0x0F, 0x0F, 0x17, 0x04, 0x7F,
+            0x00, 0x17, 0x04, 0x7F, 0x02, 0x17, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x04, 0x14, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x19, 0x0E, 0x00, 0xA1, 0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x12, 0x06, 0x00, 0xD5, 0x07, 0x15, 0x04, 0x78, 0x14, 0x05, 0x09, 0x54, 0x00, 0x00, 0x00, 0x00,
+            0x07, 0x15, 0x04, 0x78, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x08, 0x05, 0xE5, 0x0A, 0x11, 0x0D, 0x86,
+        },
+        // microcodeIndex
+        {
+            0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x53, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x53, 0x00, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00, 0x5F, 0x60, 0x61, 0x00,
+            0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+            0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+            0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+            0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00,
+            0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00,
+            0x25, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x29, 0x2A, 0x00, 0x00, 0x29, 0x2A, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x3B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x00, 0x00, 0x10, 0x11, 0x00, 0x00,
+            0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+            0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+            0x15, 0x00, 0x00, 0x00, 0x16, 0x17, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x3E, 0x3F, 0x7B, 0x00,
+            0x0C, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00,
+            0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+            0x4B, 0x4C, 0x7E, 0x00, 0x4B, 0x4C, 0x7E, 0x00, 0x48, 0x49, 0x4A, 0x7D, 0x48, 0x49, 0x4A, 0x7D,
+            0x27, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x47, 0x7C, 0x00, 0x00, 0x47, 0x7C, 0x00, 0x00,
+            0x4B, 0x4C, 0x7E, 0x00, 0x4B, 0x4C, 0x7E, 0x00, 0x48, 0x49, 0x4A, 0x7D, 0x48, 0x49, 0x4A, 0x7D,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+            0x33, 0x00, 0x00, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x2F, 0x00, 0x00, 0x00,
+            0x3C, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+            0x33, 0x00, 0x00, 0x00, 0x30, 0x31, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x30, 0x31, 0x00, 0x00,
+            0x6C, 0x00, 0x00, 0x00, 0x6A, 0x00, 0x00, 0x00, 0x6B, 0x00, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00,
+            0x22, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x23, 0x24, 0x00, 0x00, 0x23, 0x24, 0x00, 0x00,
+            0x5D, 0x5E, 0x00, 0x00, 0x5C, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x43, 0x44, 0x45, 0x46,
+            0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+            0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+            0x4E, 0x4F, 0x00, 0x00, 0x4E, 0x4F, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x4D, 0x7F, 0x00, 0x00,
+            0x2B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+            0x1F, 0x20, 0x00, 0x00, 0x34, 0x35, 0x00, 0x00, 0x38, 0x39, 0x00, 0x00, 0x34, 0x35, 0x00, 0x00,
+            0x2D, 0x00, 0x00, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00,
+            0x26, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+            0x54, 0x55, 0x00, 0x00, 0x54, 0x55, 0x00, 0x00, 0x58, 0x59, 0x00, 0x00, 0x58, 0x59, 0x00, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1D, 0x1E, 0x00, 0x00, 0x1A, 0x1B, 0x00, 0x00,
+            0x36, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+            0x66, 0x67, 0x68, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x63, 0x64, 0x65, 0x6D, 0x6E, 0x6F, 0x70,
+            0x71, 0x72, 0x73, 0x74, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x75, 0x76, 0x77, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x79, 0x7A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x26, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+            0x56, 0x57, 0x00, 0x00, 0x56, 0x57, 0x00, 0x00, 0x5A, 0x5B, 0x00, 0x00, 0x5A, 0x5B, 0x00, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1D, 0x1E, 0x00, 0x00, 0x1A, 0x1B, 0x00, 0x00,
+            0x36, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+        },
+        // translation
+        {
+            0x3F67, 0x3F67, 0x2800, 0x2800, 0x3F67, 0x3F67, 0x2800, 0x2800,
+            0x3F47, 0x3F47, 0x280C, 0x280C, 0x3F47, 0x3F47, 0x280C, 0x280C,
+            0x1D65, 0x1D65, 0x280F, 0x280F, 0x1D65, 0x1D65, 0x280F, 0x280F,
+            0x2815, 0x281B, 0x2807, 0x2807, 0x2815, 0x281F, 0x2807, 0x2807,
+            0x281B, 0x281B, 0x1166, 0x1166, 0x281F, 0x281F, 0x1166, 0x1166,
+            0x3F69, 0x3F69, 0x17E6, 0x17E6, 0x3F69, 0x3F69, 0x17E6, 0x17E6,
+            0x200B, 0x200B, 0x2810, 0x2810, 0x200B, 0x200B, 0x2810, 0x2810,
+            0x201F, 0x201F, 0x0BE6, 0x0BE6, 0x201F, 0x201F, 0x0BE6, 0x0BE6,
+            0x1AF9, 0x1AF9, 0x2800, 0x2800, 0x1AF9, 0x1AF9, 0x2800, 0x2800,
+            0x1A8B, 0x1A8B, 0x280C, 0x280C, 0x1A8B, 0x1A8B, 0x280C, 0x280C,
+            0x0000, 0x0000, 0x280F, 0x280F, 0x0000, 0x0000, 0x280F, 0x280F,
+            0x0000, 0x0000, 0x2807, 0x2807, 0x0000, 0x0000, 0x2807, 0x2807,
+            0x0000, 0x0000, 0x1166, 0x1166, 0x0000, 0x0000, 0x1166, 0x1166,
+            0x0000, 0x0000, 0x17E6, 0x17E6, 0x0000, 0x0000, 0x17E6, 0x17E6,
+            0x0000, 0x0000, 0x3F27, 0x3F27, 0x0000, 0x0000, 0x3F27, 0x3F27,
+            0x0000, 0x0000, 0x0BE6, 0x0BE6, 0x0000, 0x0000, 0x0BE6, 0x0BE6,
+            0x1965, 0x1965, 0x2800, 0x2800, 0x1965, 0x1965, 0x2800, 0x2800,
+            0x1AED, 0x1AED, 0x280C, 0x280C, 0x1AED, 0x1AED, 0x280C, 0x280C,
+            0x09E7, 0x09E7, 0x280F, 0x280F, 0x09E7, 0x09E7, 0x280F, 0x280F,
+            0x2441, 0x2441, 0x2807, 0x2807, 0x2441, 0x2441, 0x2807, 0x2807,
+            0x2479, 0x2479, 0x1166, 0x1166, 0x2479, 0x2479, 0x1166, 0x1166,
+            0x2465, 0x2465, 0x17E6, 0x17E6, 0x2465, 0x2465, 0x17E6, 0x17E6,
+            0x2493, 0x2493, 0x3F27, 0x3F27, 0x2493, 0x2493, 0x3F27, 0x3F27,
+            0x249D, 0x249D, 0x0BE6, 0x0BE6, 0x249D, 0x249D, 0x0BE6, 0x0BE6,
+            0x2461, 0x2461, 0x2800, 0x2800, 0x2461, 0x2461, 0x2800, 0x2800,
+            0x2481, 0x2481, 0x280C, 0x280C, 0x2481, 0x2481, 0x280C, 0x280C,
+            0x0000, 0x0000, 0x280F, 0x280F, 0x0000, 0x0000, 0x280F, 0x280F,
+            0x0000, 0x0000, 0x2807, 0x2807, 0x0000, 0x0000, 0x2807, 0x2807,
+            0x0000, 0x0000, 0x1166, 0x1166, 0x0000, 0x0000, 0x1166, 0x1166,
+            0x0000, 0x0000, 0x17E6, 0x17E6, 0x0000, 0x0000, 0x17E6, 0x17E6,
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x0000, 0x0000, 0x0BE6, 0x0BE6, 0x0000, 0x0000, 0x0BE6, 0x0BE6,
+        },
+        // groups
+        {
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0003FCD, 0x1003FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x00235FF, 0x00235FF, 0x00235FF, 0x00235FF, 0x000376D, 0x000376D, 0x0203BC5, 0x0002FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD, 0x0007FCD,
+            0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF, 0x00017FF,
+            0x00035DD, 0x00035DD, 0x00035DF, 0x00035DF, 0x0003CDD, 0x0003FDD, 0x1003CDF, 0x0003FDD,
+            0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD,
+            0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD, 0x0003FCD,
+            0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D,
+            0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D, 0x000374D,
+            0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD,
+            0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD, 0x0013FCD,
+            0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FDF, 0x0003FDF, 0x00037DD, 0x00037DD,
+            0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF, 0x0003FCF,
+            0x00037FF, 0x00037FF, 0x00037FF, 0x00037FF, 0x0002FCF, 0x0002FCF, 0x0002FCF, 0x0002FCF,
+            0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF, 0x0003FDF,
+            0x0001FCF, 0x0001FCF, 0x0001FCF, 0x0001FCF, 0x000374C, 0x000374C, 0x000374C, 0x000374C,
+            0x0001FCF, 0x0001FCF, 0x0001FCF, 0x0001FCF, 0x000374C, 0x000374C, 0x000374C, 0x000374C,
+            0x0403BC5, 0x0403BC5, 0x0103BC5, 0x0103BC5, 0x0083BCD, 0x0043BCD, 0x00037DB, 0x00037DB,
+            0x0003B8D, 0x0003B8D, 0x0803B8D, 0x0003B8D, 0x0003B8D, 0x0003B8D, 0x00077DB, 0x00077DB,
+            0x0003FCF,
+        },
+    };
+};
+
+template <typename Unused>
+constexpr MicrocodeTables MicrocodeTableData<Unused>::k8088;
+template <typename Unused>
+constexpr MicrocodeTables MicrocodeTableData<Unused>::k8086;
+
+#endif // MICROCODE_TABLES_DATA_H
@@ -33,6 +33,8 @@ public:
         _priority = 0;
         _rotateInAutomaticEOIMode = false;
         _initializationState = initializationStateNone;
+        _intr = false;
+        _intrDirty = true;
     }
 
     void stubInit() {
@@ -40,9 +42,12 @@ public:
         _icw2 = 0x08;
         _icw4 = 0x0f;
         _imr = 0xbc;
+        _intrDirty = true;
     }
 
     void write(const uint32_t address, const uint8_t data) {
+        // Any command or mask write can change the priority scan.
+        _intrDirty = true;
         if (address == 0) {
             if ((data & 0x10) != 0) {
                 _icw1 = data;
@@ -196,6 +201,7 @@ public:
 
     void setIRQLine(const int line, const bool state) {
         const uint8_t b = 1 << line;
+        const uint8_t irr = _irr;
         if (state) {
             if (levelTriggered() || (_lines & b) == 0) {
                 _irr |= b;
@@ -206,21 +212,48 @@ public:
             _irr &= ~b;
             _lines &= ~b;
         }
+        if (_irr != irr) {
+            _intrDirty = true;
+        }
     }
 
+    // The INTR output. It is polled every cycle but only changes when a line, a command or an acknowledge changes what
+    // the priority scan sees, so the scan is rerun only after one of those. The scan also moves _interrupt, but
+    // repeating it on an unchanged state leaves _interrupt where the previous scan put it, so skipping the repeats
+    // doesn't change anything.
     [[nodiscard]] bool interruptPending() {
-        auto i = findBestInterrupt();
-        if (i != -1) {
-            if (i != 0) {
-                //std::cout << "PIC interrupt pending on line " << i << "\n";
-            }
-            return true;
+        if (_intrDirty) {
+            _intr = findBestInterrupt() != -1;
+            _intrDirty = false;
         }
-        return false;
+        return _intr;
     }
 
     [[nodiscard]] uint8_t getIRQLines() const { return _lines; }
 
+    // Save or load the controller's state (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar(_interruptPending);
+        ar(_interrupt);
+        ar(_irr);
+        ar(_imr);
+        ar(_isr);
+        ar(_icw1);
+        ar(_icw2);
+        ar(_icw3);
+        ar(_icw4);
+        ar(_ocw3);
+        ar(_lines);
+        ar(_acknowledgedBytes);
+        ar(_priority);
+        ar(_specialMaskMode);
+        ar(_rotateInAutomaticEOIMode);
+        ar(_initializationState);
+        ar(_intr);
+        ar(_intrDirty);
+    }
+
     // Return a snapshot of internal PIC state for debugging UI
     [[nodiscard]] PicDebugState getDebugState() const {
         const PicDebugState s{
@@ -263,6 +296,7 @@ private:
     }
 
     void acknowledge() {
+        _intrDirty = true;
         const int i = findBestInterrupt();
         if (i == -1) {
             _interrupt = 7;
@@ -276,6 +310,7 @@ private:
     }
 
     void nonSpecificEOI(bool rotatePriority = false) {
+        _intrDirty = true;
         int n = _priority;
         for (int i = 0; i < 8; ++i) {
             const uint8_t b = 1 << n;
@@ -323,6 +358,8 @@ private:
     bool _specialMaskMode;
     bool _rotateInAutomaticEOIMode;
     InitializationState _initializationState;
+    bool _intr; // Cached result of the last priority scan
+    bool _intrDirty; // Something the scan reads has changed since
 };
 
 #endif //PIC_H
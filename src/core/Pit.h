@@ -1,7 +1,10 @@
 #ifndef PIT_H
 #define PIT_H
+#include <algorithm>
 #include <cstdint>
 
+#include "StateBuffer.h"
+
 class PIT
 {
 public:
@@ -45,6 +48,21 @@ public:
         }
     }
 
+    // Run n ticks at once. n must be less than ticksUntilOutputChange().
+    void advance(const uint64_t n) {
+        ticks_ += n;
+        for (int i = 0; i < 3; ++i) {
+            counters_[i].advance(n);
+        }
+    }
+
+    // Return the number of ticks until the first tick on which any counter's output might change (the next tick is 1),
+    // or UINT32_MAX if none can change until the next read, write or gate change.
+    [[nodiscard]] uint32_t ticksUntilOutputChange() const {
+        return std::min({counters_[0].ticksUntilOutputChange(), counters_[1].ticksUntilOutputChange(),
+            counters_[2].ticksUntilOutputChange()});
+    }
+
     // Return the number of PIT ticks since reset.
     [[nodiscard]]
     uint64_t getTicks() const {
@@ -60,6 +78,55 @@ public:
         return counters_[counter].output;
     }
 
+    // Return a number of ticks during which the counter's output is certain not to change.
+    [[nodiscard]]
+    uint32_t getStableTicks(const int counter) const {
+        return counters_[counter].stableTicks();
+    }
+
+    // Return a number of ticks during which the counter's output is certain not to rise.
+    [[nodiscard]]
+    uint32_t getTicksWithoutRisingEdge(const int counter) const {
+        return counters_[counter].ticksWithoutRisingEdge();
+    }
+
+    // Append everything that decides how a counter goes on from here, without the PIT's tick count.
+    void appendCounterState(const int counter, StateBuffer& out) const {
+        const Counter& c = counters_[counter];
+        out.put(c.count);
+        out.put(c.value);
+        out.put(c.latch);
+        out.put(c.control_byte);
+        out.put(c.low_byte);
+        out.put(c.gate);
+        out.put(c.output);
+        out.put(c.first_byte);
+        out.put(c.latched);
+        out.put(c.state);
+        out.put(c.write_byte);
+        out.put(c.have_write_byte);
+    }
+
+    // Save or load the counters (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar(ticks_);
+        for (Counter& c : counters_) {
+            ar(c.count);
+            ar(c.value);
+            ar(c.latch);
+            ar(c.control_byte);
+            ar(c.low_byte);
+            ar(c.gate);
+            ar(c.output);
+            ar(c.first_byte);
+            ar(c.latched);
+            ar(c.state);
+            ar(c.write_byte);
+            ar(c.have_write_byte);
+        }
+    }
+
     //int getMode(int counter) { return _counters[counter]._control; }
 private:
     enum State
@@ -271,6 +338,107 @@ private:
             }
         }
 
+        [[nodiscard]] uint32_t stableTicks() const {
+            return ticksUntilOutputChange() - 1;
+        }
+
+        // Return the number of ticks until the first tick that might change the output or do more than count down, or
+        // UINT32_MAX if no tick will until the counter is written to or its gate changes. The ticks before it only
+        // lower a binary count, so advance() can run them in one step. Anything else (a pending write, a load delay,
+        // a gate edge, a strobe pulse or a BCD count) is left to tick().
+        [[nodiscard]] uint32_t ticksUntilOutputChange() const {
+            if (have_write_byte || (control_byte & 1) != 0 || state == stateLoadDelay || state == stateGateRose ||
+                state == statePulsing) {
+                return 1;
+            }
+            const uint32_t v = value == 0 ? 0x10000 : value;
+            const bool counting = gate && state == stateCounting;
+            switch (control_byte & 0x0e) {
+                case 0x00: // Interrupt on Terminal Count: the output only rises on the tick that reaches zero
+                    return counting && !output ? v : UINT32_MAX;
+                case 0x02: // Programmable One-Shot: counts on every tick and only raises the output on reaching zero
+                    return v;
+                case 0x04:
+                case 0x0c: // Rate Generator: the output falls on reaching 1 and rises again on the next tick
+                    if (!counting) {
+                        return UINT32_MAX;
+                    }
+                    return v == 1 ? 1 : v - 1;
+                case 0x06:
+                case 0x0e: // Square Wave Rate Generator: the output toggles on reaching zero
+                    if (!counting) {
+                        return UINT32_MAX;
+                    }
+                    if ((v & 1) == 0) {
+                        return v / 2;
+                    }
+                    // An odd count first drops by 1 while the output is high, or by 3 while it is low.
+                    if (output) {
+                        return 1 + (v - 1) / 2;
+                    }
+                    return v < 3 ? 1 : 1 + (v - 3) / 2;
+                case 0x08: // Software Triggered Strobe: the output pulses on reaching zero
+                    return counting ? v : UINT32_MAX;
+                case 0x0a: // Hardware Triggered Strobe: counts without the gate once triggered
+                    if (state != stateCounting) {
+                        return UINT32_MAX;
+                    }
+                    return v == 1 ? 1 : v - 1;
+                default:
+                    return 1;
+            }
+        }
+
+        // Run n ticks in one step. n must be less than ticksUntilOutputChange(), so the count neither reaches the
+        // value that changes the output nor reloads.
+        void advance(const uint64_t n) {
+            if (n == 0) {
+                return;
+            }
+            const bool counting = gate && state == stateCounting;
+            switch (control_byte & 0x0e) {
+                case 0x00:
+                case 0x04:
+                case 0x0c:
+                case 0x08:
+                    if (counting) {
+                        value = static_cast<uint16_t>(value - n);
+                    }
+                    break;
+                case 0x02:
+                    value = static_cast<uint16_t>(value - n);
+                    break;
+                case 0x06:
+                case 0x0e:
+                    if (counting) {
+                        uint64_t d = 2 * n;
+                        if ((value & 1) != 0) {
+                            d = (output ? 1 : 3) + 2 * (n - 1);
+                        }
+                        value = static_cast<uint16_t>(value - d);
+                    }
+                    break;
+                case 0x0a:
+                    if (state == stateCounting) {
+                        value = static_cast<uint16_t>(value - n);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // A binary count in mode 2 only raises the output on the tick that counts down to zero. Other modes fall back
+        // to stableTicks().
+        [[nodiscard]] uint32_t ticksWithoutRisingEdge() const {
+            const uint8_t mode = control_byte & 0x0e;
+            if ((mode != 0x04 && mode != 0x0c) || have_write_byte || !gate || state != stateCounting ||
+                (control_byte & 1) != 0) {
+                return stableTicks();
+            }
+            return (value == 0 ? 0x10000 : value) - 1;
+        }
+
         void countDown() {
             if ((control_byte & 1) == 0) {
                 --value;
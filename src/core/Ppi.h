@@ -106,6 +106,18 @@ public:
         return mode_;
     }
 
+    // Save or load the port latches and lines (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        ar(a_);
+        ar(b_);
+        ar(c_);
+        ar(a_lines_);
+        ar(b_lines_);
+        ar(c_lines_);
+        ar(mode_);
+    }
+
     void setA(const int line, const bool state) {
         if (aStrobedInput() && aStrobe()) {
             b_ = b_lines_;
@@ -0,0 +1,440 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "StateBuffer.h"
+
+// How the CPU treats REP MOVS/STOS/LODS.
+enum class RepFastPathMode
+{
+    Off,
+    On, // Run batches of iterations against the bus without executing their microcode
+    Verify, // Find batches and keep stepping them, checking each batch against what stepping actually did
+};
+
+struct RepFastPathStats
+{
+    uint64_t batches{0}; // Batches run (On) or checked (Verify)
+    uint64_t iterations{0};
+    uint64_t cycles{0};
+    uint64_t mismatches{0}; // Verify only: batches that would not have matched stepping
+};
+
+// Iteration tracker for the REP string loop.
+//
+// The CPU reports every pass through the head of the RPTS microcode loop, serializing its state with the registers
+// and the fields that carry each iteration's data left out. Between heads the tracker records the CPU's bus
+// operations. An iteration can only repeat exactly if DMA leaves the CPU's bus cycles alone and INTR stays the same, so
+// the CPU also reports how many ticks that is certain for. Two consecutive undisturbed iterations that start and end in
+// the same state, move every register by the same amount and issue the same memory accesses at the same cycles with
+// the same address steps form the reference.
+//
+// From then on, every head whose state matches the reference and whose registers are where the reference predicts is
+// the start of a batch: the iterations that fit in the undisturbed window and stop short of the count reaching zero
+// repeat the reference exactly, with each access address and register moved on by one step per iteration. Only the
+// bytes moved differ, and the CPU takes those from the bus as it replays the accesses.
+class RepFastPath
+{
+public:
+    enum class OpKind : uint8_t
+    {
+        Access, // Bus::startAccess()
+        PassiveOrHalt, // Bus::setPassiveOrHalt()
+        Read, // Bus::read()
+        Write, // Bus::write()
+    };
+
+    struct BusOp
+    {
+        uint64_t cycle; // CPU cycle the operation was issued in; for the reference, cycles into the iteration
+        OpKind kind;
+        uint8_t type; // IOType, for Access
+        uint8_t segment; // Segment register index, for Access
+        uint8_t value; // The passive/halt flag, or the byte read or written
+        uint16_t index; // Offset into the segment, for Access
+    };
+
+    // What an iteration of the current instruction does with data, set by the CPU from the opcode.
+    struct Semantics
+    {
+        uint32_t dataRegisters; // Registers that hold the data moved rather than stepping (bit n for register n)
+        uint8_t reads; // Bytes read and written per iteration
+        uint8_t writes;
+        bool copiesReads; // Each byte written is the byte read in the same position of the iteration (MOVS)
+    };
+
+    static constexpr size_t kRegisters = 32;
+    static constexpr int kCountRegister = 25; // CX
+    static constexpr size_t kMaxOps = 64; // Per iteration; longer ones aren't the loop
+
+    typedef std::array<uint16_t, kRegisters> Registers;
+
+    // The steady iteration every batch repeats.
+    struct Reference
+    {
+        uint32_t length{0};
+        std::vector<BusOp> ops; // cycle is relative to the start of the iteration
+        std::vector<uint16_t> indexSteps; // Per op, how far each iteration moves an Access's index
+        Registers registers{}; // At the head the reference iteration starts from
+        Registers registerSteps{};
+        uint16_t ioIndex{0};
+        uint16_t ioIndexStep{0};
+        Semantics semantics{};
+        StateBuffer state;
+    };
+
+    void setMode(const RepFastPathMode mode) {
+        mode_ = mode;
+        reset();
+    }
+
+    RepFastPathMode mode() const { return mode_; }
+    const RepFastPathStats& stats() const { return stats_; }
+
+    // Forget everything, including the reference. Called whenever the machine may have changed behind the CPU's back.
+    void reset() {
+        recording_ = false;
+        verifying_ = false;
+        have_reference_ = false;
+        head_count_ = 0;
+        ops_.clear();
+    }
+
+    bool isRecording() const { return recording_; }
+    bool isVerifying() const { return verifying_; }
+    uint64_t verifyEnd() const { return verify_end_; }
+
+    const Reference& reference() const { return reference_; }
+
+    // Reference iterations between the one the reference was taken from and the one the batch starts with.
+    uint16_t batchSteps() const { return steps_; }
+
+    // Scratch buffer for the state at the current head.
+    StateBuffer& state() { return state_; }
+
+    // The iteration starting at this head may see DMA or an INTR change: it can neither be batched nor become the
+    // reference.
+    void disturbed() {
+        head_count_ = 0;
+        ops_.clear();
+    }
+
+    // Record a head with the state just written into state(). window is the number of ticks ready() and INTR are known
+    // to stay the same for, and maxCycles the most a batch may take. Returns the number of iterations to batch from
+    // here, or 0 to keep stepping.
+    uint32_t visit(const uint64_t cycle, const Registers& registers, const uint16_t ioIndex, const uint32_t window,
+        const uint32_t maxCycles, const Semantics& semantics) {
+        recording_ = true;
+        if (head_count_ == 0) {
+            ops_.clear();
+        }
+        if (head_count_ == heads_.size()) {
+            // Drop the oldest head and its iteration.
+            const size_t dropped = heads_[1].op_index;
+            ops_.erase(ops_.begin(), ops_.begin() + static_cast<std::ptrdiff_t>(dropped));
+            std::swap(heads_[0], heads_[1]);
+            std::swap(heads_[1], heads_[2]);
+            heads_[0].op_index -= dropped;
+            heads_[1].op_index -= dropped;
+            --head_count_;
+        }
+        Head& head = heads_[head_count_++];
+        head.cycle = cycle;
+        head.registers = registers;
+        head.ioIndex = ioIndex;
+        head.window = window;
+        head.op_index = ops_.size();
+        std::swap(head.state, state_);
+        if (head_count_ == heads_.size()) {
+            takeReference(semantics);
+        }
+
+        if (!have_reference_ || head.state != reference_.state ||
+            semantics.dataRegisters != reference_.semantics.dataRegisters) {
+            return 0;
+        }
+        const Registers& base = reference_.registers;
+        steps_ = static_cast<uint16_t>(base[kCountRegister] - registers[kCountRegister]);
+        for (size_t r = 0; r < kRegisters; ++r) {
+            if ((semantics.dataRegisters & (1u << r)) == 0 &&
+                registers[r] != static_cast<uint16_t>(base[r] + steps_ * reference_.registerSteps[r])) {
+                // Another run of the same instruction.
+                have_reference_ = false;
+                return 0;
+            }
+        }
+        if (ioIndex != static_cast<uint16_t>(reference_.ioIndex + steps_ * reference_.ioIndexStep)) {
+            have_reference_ = false;
+            return 0;
+        }
+
+        // Stop before the iteration that takes the count to zero, which leaves the loop.
+        const uint32_t count = registers[kCountRegister];
+        const uint32_t iterations = std::min(count == 0 ? 0 : count - 1,
+            std::min(window, maxCycles) / reference_.length);
+        if (iterations == 0) {
+            return 0;
+        }
+        head_count_ = 0;
+        ops_.clear();
+        return iterations;
+    }
+
+    // Called after the CPU ran a batch returned by visit().
+    void batched(const uint32_t iterations) {
+        ++stats_.batches;
+        stats_.iterations += iterations;
+        stats_.cycles += static_cast<uint64_t>(iterations) * reference_.length;
+    }
+
+    // Verify mode: instead of running the batch, step it normally and compare the result at the end. startValue is
+    // the data value the batch would have started from.
+    void beginVerification(const uint64_t cycle, const uint32_t iterations, const uint16_t startValue) {
+        verifying_ = true;
+        verify_start_ = cycle;
+        verify_end_ = cycle + static_cast<uint64_t>(iterations) * reference_.length;
+        verify_iterations_ = iterations;
+        verify_steps_ = steps_;
+        verify_start_value_ = startValue;
+    }
+
+    // What the CPU needs to predict its state at the end of the batch being verified: the reference steps it ends at
+    // and the data values read (or, for STOS, written) by its last two iterations.
+    void verifiedBatch(uint16_t& steps, uint16_t& last, uint16_t& previous) const {
+        steps = static_cast<uint16_t>(verify_steps_ + verify_iterations_);
+        last = iterationValue(verify_iterations_ - 1);
+        previous = verify_iterations_ > 1 ? iterationValue(verify_iterations_ - 2) : verify_start_value_;
+    }
+
+    // Compare the bus operations stepped since beginVerification() with what the batch would have issued. stateMatches
+    // is the CPU's comparison of its state with the state the batch would have left. Returns false on a mismatch.
+    bool finishVerification(const uint64_t cycle, const bool stateMatches) {
+        verifying_ = false;
+        const size_t perIteration = reference_.ops.size();
+        bool match = stateMatches && cycle == verify_end_ && ops_.size() == verify_iterations_ * perIteration;
+        for (size_t i = 0; match && i < ops_.size(); ++i) {
+            const size_t iteration = i / perIteration;
+            const BusOp expected = expectedOp(i % perIteration, static_cast<uint16_t>(verify_steps_ + iteration),
+                verify_start_ + iteration * reference_.length);
+            const BusOp& actual = ops_[i];
+            match = actual.cycle == expected.cycle && actual.kind == expected.kind;
+            switch (actual.kind) {
+                case OpKind::Access:
+                    match = match && actual.type == expected.type && actual.segment == expected.segment &&
+                        actual.index == expected.index;
+                    break;
+                case OpKind::PassiveOrHalt:
+                    match = match && actual.value == expected.value;
+                    break;
+                case OpKind::Read:
+                    break;
+                case OpKind::Write:
+                    match = match && actual.value == (reference_.semantics.copiesReads ?
+                        readInIteration(iteration, writeNumber(i % perIteration)) : expected.value);
+                    break;
+            }
+        }
+        ++stats_.batches;
+        stats_.iterations += verify_iterations_;
+        stats_.cycles += verify_end_ - verify_start_;
+        if (!match) {
+            reportMismatch(cycle);
+        }
+        head_count_ = 0;
+        ops_.clear();
+        return match;
+    }
+
+    void recordAccess(const uint64_t cycle, const uint8_t type, const uint8_t segment, const uint16_t index) {
+        // Only memory reads and writes (IOType 5 and 6) can be part of the loop.
+        if ((type != 5 && type != 6) || (!verifying_ && ops_.size() >= kMaxOps * heads_.size())) {
+            abort(cycle);
+            return;
+        }
+        ops_.push_back({cycle, OpKind::Access, type, segment, 0, index});
+    }
+
+    void recordPassiveOrHalt(const uint64_t cycle, const bool passiveOrHalt) {
+        ops_.push_back({cycle, OpKind::PassiveOrHalt, 0, 0, static_cast<uint8_t>(passiveOrHalt), 0});
+    }
+
+    void recordRead(const uint64_t cycle, const uint8_t value) {
+        ops_.push_back({cycle, OpKind::Read, 0, 0, value, 0});
+    }
+
+    void recordWrite(const uint64_t cycle, const uint8_t value) {
+        ops_.push_back({cycle, OpKind::Write, 0, 0, value, 0});
+    }
+
+    // The CPU left the loop or did something no iteration does. Stop recording until the next head.
+    void abort(const uint64_t cycle) {
+        if (!recording_) {
+            return;
+        }
+        if (verifying_) {
+            verifying_ = false;
+            ++stats_.batches;
+            reportMismatch(cycle);
+        }
+        recording_ = false;
+        head_count_ = 0;
+        ops_.clear();
+    }
+
+    // The operation the reference predicts for op n of an iteration steps iterations past the reference one, which
+    // starts at the given cycle.
+    BusOp expectedOp(const size_t n, const uint16_t steps, const uint64_t start) const {
+        BusOp op = reference_.ops[n];
+        op.cycle += start;
+        op.index = static_cast<uint16_t>(op.index + steps * reference_.indexSteps[n]);
+        return op;
+    }
+
+private:
+    struct Head
+    {
+        uint64_t cycle{0};
+        Registers registers{};
+        uint16_t ioIndex{0};
+        uint32_t window{0};
+        size_t op_index{0}; // Where the iteration starting at this head begins in ops_
+        StateBuffer state;
+    };
+
+    // Make the iteration between the last two heads the reference if it and the one before it repeat each other.
+    void takeReference(const Semantics& semantics) {
+        const Head& h0 = heads_[0];
+        const Head& h1 = heads_[1];
+        const Head& h2 = heads_[2];
+        const uint64_t length = h1.cycle - h0.cycle;
+        if (h2.cycle - h1.cycle != length || h0.window < length || h1.window < length ||
+            h0.state != h1.state || h1.state != h2.state) {
+            return;
+        }
+        if (static_cast<uint16_t>(h1.registers[kCountRegister] - h0.registers[kCountRegister]) != 0xFFFF) {
+            return;
+        }
+        Registers steps{};
+        for (size_t r = 0; r < kRegisters; ++r) {
+            steps[r] = static_cast<uint16_t>(h2.registers[r] - h1.registers[r]);
+            if ((semantics.dataRegisters & (1u << r)) == 0 &&
+                steps[r] != static_cast<uint16_t>(h1.registers[r] - h0.registers[r])) {
+                return;
+            }
+        }
+        const uint16_t ioIndexStep = static_cast<uint16_t>(h2.ioIndex - h1.ioIndex);
+        if (ioIndexStep != static_cast<uint16_t>(h1.ioIndex - h0.ioIndex)) {
+            return;
+        }
+
+        const size_t count = h1.op_index - h0.op_index;
+        if (ops_.size() - h1.op_index != count) {
+            return;
+        }
+        std::vector<BusOp> ops;
+        std::vector<uint16_t> indexSteps;
+        int reads = 0;
+        int writes = 0;
+        for (size_t n = 0; n < count; ++n) {
+            const BusOp& a = ops_[h0.op_index + n];
+            BusOp b = ops_[h1.op_index + n];
+            if (a.cycle - h0.cycle != b.cycle - h1.cycle || a.kind != b.kind || a.type != b.type ||
+                a.segment != b.segment) {
+                return;
+            }
+            if (b.kind == OpKind::PassiveOrHalt && a.value != b.value) {
+                return;
+            }
+            if (b.kind == OpKind::Write && !semantics.copiesReads && a.value != b.value) {
+                return;
+            }
+            reads += b.kind == OpKind::Read ? 1 : 0;
+            writes += b.kind == OpKind::Write ? 1 : 0;
+            indexSteps.push_back(static_cast<uint16_t>(b.index - a.index));
+            b.cycle -= h1.cycle;
+            ops.push_back(b);
+        }
+        if (reads != semantics.reads || writes != semantics.writes) {
+            return;
+        }
+
+        reference_.length = static_cast<uint32_t>(length);
+        reference_.ops = std::move(ops);
+        reference_.indexSteps = std::move(indexSteps);
+        reference_.registers = h1.registers;
+        reference_.registerSteps = steps;
+        reference_.ioIndex = h1.ioIndex;
+        reference_.ioIndexStep = ioIndexStep;
+        reference_.semantics = semantics;
+        reference_.state = h2.state;
+        have_reference_ = true;
+    }
+
+    // The ordinal of reference op n among the iteration's writes.
+    uint8_t writeNumber(const size_t n) const {
+        uint8_t number = 0;
+        for (size_t i = 0; i < n; ++i) {
+            number += reference_.ops[i].kind == OpKind::Write ? 1 : 0;
+        }
+        return number;
+    }
+
+    // The byte the given read of a stepped iteration returned.
+    uint8_t readInIteration(const size_t iteration, const uint8_t number) const {
+        const size_t perIteration = reference_.ops.size();
+        uint8_t seen = 0;
+        for (size_t i = iteration * perIteration; i < (iteration + 1) * perIteration; ++i) {
+            if (ops_[i].kind == OpKind::Read && seen++ == number) {
+                return ops_[i].value;
+            }
+        }
+        return 0;
+    }
+
+    // The bytes a stepped iteration read, or wrote if it read none, as a little-endian value.
+    uint16_t iterationValue(const size_t iteration) const {
+        const size_t perIteration = reference_.ops.size();
+        const OpKind kind = reference_.semantics.reads != 0 ? OpKind::Read : OpKind::Write;
+        uint16_t value = 0;
+        int shift = 0;
+        for (size_t i = iteration * perIteration; i < (iteration + 1) * perIteration && i < ops_.size(); ++i) {
+            if (ops_[i].kind == kind) {
+                value |= static_cast<uint16_t>(ops_[i].value << shift);
+                shift += 8;
+            }
+        }
+        return value;
+    }
+
+    void reportMismatch(const uint64_t cycle) {
+        ++stats_.mismatches;
+        std::cout << std::format("REP fast path verification failed for the batch at cycle {} (cycle {})\n",
+            verify_start_, cycle);
+    }
+
+    RepFastPathMode mode_{RepFastPathMode::On};
+    RepFastPathStats stats_{};
+
+    bool recording_{false};
+    std::array<Head, 3> heads_{};
+    size_t head_count_{0};
+    std::vector<BusOp> ops_;
+    StateBuffer state_;
+
+    bool have_reference_{false};
+    Reference reference_;
+    uint16_t steps_{0};
+
+    bool verifying_{false};
+    uint64_t verify_start_{0};
+    uint64_t verify_end_{0};
+    uint32_t verify_iterations_{0};
+    uint16_t verify_steps_{0};
+    uint16_t verify_start_value_{0};
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Machine save states.
+//
+// A save state is a header followed by sections:
+//
+//   header   "XTCESAVE", then the format version (uint32)
+//   section  tag (uint32, four characters), payload size (uint32), payload
+//
+// Each component writes its state into its own section through a serialize(Archive&) member template that is used
+// both to save (with StateWriter) and to load (with StateReader), so the two directions can't drift apart. Those
+// templates only call the archive, so component headers don't need to include this one. Values are
+// stored as their in-memory representation in host byte order; save states are meant to be resumed by the same build
+// on the same kind of host, not exchanged.
+//
+// The loader finds sections by tag, so sections may be added, and a section must be consumed exactly, so a layout
+// change that wasn't given a new version is caught rather than misread. kSaveStateVersion changes whenever a section's
+// layout does, and StateReader only accepts states of the current version: older save states are rejected, not
+// converted.
+
+inline constexpr char kSaveStateMagic[8] = {'X', 'T', 'C', 'E', 'S', 'A', 'V', 'E'};
+inline constexpr uint32_t kSaveStateVersion = 4;
+
+// The tag of a section named by four characters, e.g. "CPU ".
+constexpr uint32_t stateTag(const char (&name)[5]) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(name[0])) |
+        static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8 |
+        static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16 |
+        static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24;
+}
+
+// Writes a save state into a byte vector. The vector is cleared first but keeps its capacity, so saving into the
+// same vector repeatedly doesn't allocate.
+class StateWriter
+{
+public:
+    static constexpr bool kLoading = false;
+
+    explicit StateWriter(std::vector<uint8_t>& out) :
+        out_(out) {
+        out_.clear();
+        append(kSaveStateMagic, sizeof(kSaveStateMagic));
+        uint32_t version = kSaveStateVersion;
+        (*this)(version);
+    }
+
+    [[nodiscard]] static uint32_t version() { return kSaveStateVersion; }
+    [[nodiscard]] static bool ok() { return true; }
+
+    // Write the values f() serializes as one section.
+    template <typename F>
+    void section(const char (&name)[5], F&& f) {
+        uint32_t t = stateTag(name);
+        uint32_t size = 0;
+        (*this)(t);
+        const size_t size_offset = out_.size();
+        (*this)(size);
+        f();
+        size = static_cast<uint32_t>(out_.size() - size_offset - sizeof(size));
+        std::memcpy(&out_[size_offset], &size, sizeof(size));
+    }
+
+    template <typename T>
+    void operator()(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be saved directly");
+        append(&value, sizeof(T));
+    }
+
+    // A block whose size is fixed by the machine configuration, such as RAM. Loading fails if the sizes differ.
+    void bytes(void* data, const size_t size) {
+        uint32_t n = static_cast<uint32_t>(size);
+        (*this)(n);
+        append(data, size);
+    }
+
+    // A block whose size is part of the state, such as a disk image.
+    void vector(std::vector<uint8_t>& v) {
+        bytes(v.data(), v.size());
+    }
+
+    void deque(std::deque<uint8_t>& d) {
+        uint32_t n = static_cast<uint32_t>(d.size());
+        (*this)(n);
+        for (uint8_t b : d) {
+            (*this)(b);
+        }
+    }
+
+private:
+    void append(const void* data, const size_t size) {
+        const size_t offset = out_.size();
+        out_.resize(offset + size);
+        std::memcpy(&out_[offset], data, size);
+    }
+
+    std::vector<uint8_t>& out_;
+};
+
+// Reads a save state written by StateWriter. Any error (a bad header, a missing or malformed section, a size that
+// doesn't match the machine) makes ok() false; the values read after that are unspecified, so a caller that gets a
+// failure must not resume from the partly loaded state.
+class StateReader
+{
+public:
+    static constexpr bool kLoading = true;
+
+    explicit StateReader(const std::span<const uint8_t> data) :
+        data_(data) {
+        char magic[sizeof(kSaveStateMagic)];
+        end_ = data_.size();
+        read(magic, sizeof(magic));
+        (*this)(version_);
+        if (!ok_ || !std::equal(std::begin(magic), std::end(magic), std::begin(kSaveStateMagic)) ||
+            version_ != kSaveStateVersion) {
+            ok_ = false;
+            return;
+        }
+        // Index the sections.
+        while (ok_ && cursor_ < data_.size()) {
+            Section s{};
+            (*this)(s.tag);
+            uint32_t size = 0;
+            (*this)(size);
+            s.offset = cursor_;
+            s.end = cursor_ + size;
+            if (!ok_ || size > data_.size() - cursor_) {
+                ok_ = false;
+                break;
+            }
+            sections_.push_back(s);
+            cursor_ = s.end;
+        }
+        cursor_ = end_ = 0;
+    }
+
+    [[nodiscard]] uint32_t version() const { return version_; }
+    [[nodiscard]] bool ok() const { return ok_; }
+
+    // Read the section with this tag through f(). The section must exist and f() must consume all of it.
+    template <typename F>
+    void section(const char (&name)[5], F&& f) {
+        const auto it = std::ranges::find(sections_, stateTag(name), &Section::tag);
+        if (!ok_ || it == sections_.end()) {
+            ok_ = false;
+            return;
+        }
+        cursor_ = it->offset;
+        end_ = it->end;
+        f();
+        if (cursor_ != end_) {
+            ok_ = false;
+        }
+        cursor_ = end_ = 0;
+    }
+
+    template <typename T>
+    void operator()(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be saved directly");
+        read(&value, sizeof(T));
+    }
+
+    void bytes(void* data, const size_t size) {
+        uint32_t n = 0;
+        (*this)(n);
+        if (n != size) {
+            ok_ = false;
+            return;
+        }
+        read(data, size);
+    }
+
+    void vector(std::vector<uint8_t>& v) {
+        uint32_t n = 0;
+        (*this)(n);
+        if (!ok_ || n > end_ - cursor_) {
+            ok_ = false;
+            return;
+        }
+        v.resize(n);
+        read(v.data(), n);
+    }
+
+    void deque(std::deque<uint8_t>& d) {
+        uint32_t n = 0;
+        (*this)(n);
+        if (!ok_ || n > end_ - cursor_) {
+            ok_ = false;
+            return;
+        }
+        d.assign(data_.begin() + static_cast<std::ptrdiff_t>(cursor_),
+                 data_.begin() + static_cast<std::ptrdiff_t>(cursor_ + n));
+        cursor_ += n;
+    }
+
+private:
+    struct Section
+    {
+        uint32_t tag;
+        size_t offset;
+        size_t end;
+    };
+
+    void read(void* data, const size_t size) {
+        if (!ok_ || size > end_ - cursor_) {
+            ok_ = false;
+            return;
+        }
+        std::memcpy(data, data_.data() + cursor_, size);
+        cursor_ += size;
+    }
+
+    std::span<const uint8_t> data_;
+    std::vector<Section> sections_;
+    size_t cursor_{0};
+    size_t end_{0}; // End of the section being read
+    uint32_t version_{0};
+    bool ok_{true};
+};
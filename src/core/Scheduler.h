@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Next-event times for the devices driven by the bus, counted in bus ticks.
+//
+// Every event source owns one slot holding the tick it next needs attention on, so the bus only has to compare its
+// tick count against the earliest slot on each tick. There are only a handful of sources, each with at most one
+// pending event, so a fixed array is simpler and faster than a heap. Running the due slots in index order keeps the
+// order the devices are ticked in within a single tick.
+template <typename Event, std::size_t N>
+class Scheduler
+{
+public:
+    static constexpr uint64_t kNever = UINT64_MAX;
+
+    Scheduler() {
+        clear();
+    }
+
+    void clear() {
+        slots_.fill(kNever);
+        next_ = kNever;
+    }
+
+    void schedule(const Event event, const uint64_t tick) {
+        slots_[static_cast<std::size_t>(event)] = tick;
+        next_ = *std::ranges::min_element(slots_);
+    }
+
+    void cancel(const Event event) {
+        schedule(event, kNever);
+    }
+
+    [[nodiscard]] uint64_t at(const Event event) const {
+        return slots_[static_cast<std::size_t>(event)];
+    }
+
+    // The earliest tick any event is due on.
+    [[nodiscard]] uint64_t next() const { return next_; }
+
+    // Save or load the event times (see SaveState.h).
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        for (uint64_t& slot : slots_) {
+            ar(slot);
+        }
+        next_ = *std::ranges::min_element(slots_);
+    }
+
+private:
+    std::array<uint64_t, N> slots_;
+    uint64_t next_;
+};
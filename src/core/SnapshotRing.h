@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <vector>
+
+// A bounded history of save states (see SaveState.h), for running the machine backwards.
+//
+// Consecutive save states are mostly the same bytes: between two frames a program changes a few pages of RAM and
+// video memory, and disk images rarely change at all. Only the newest state is kept whole. Each older snapshot holds
+// just the pages of its state that differ from the next snapshot's, so a snapshot costs about as much memory as the
+// machine changed since the one before, and dropping the oldest to stay within the limits touches nothing else. A
+// snapshot whose state is a different size from the next one's (a disk was inserted) is kept whole.
+class SnapshotRing
+{
+public:
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kDefaultCapacity = 600;
+    static constexpr size_t kDefaultByteBudget = size_t{256} << 20;
+
+    // Keep at most capacity snapshots and about byteBudget bytes, dropping the oldest snapshots first.
+    void setLimits(const size_t capacity, const size_t byte_budget) {
+        capacity_ = std::max<size_t>(capacity, 1);
+        byte_budget_ = byte_budget;
+        evict();
+    }
+
+    void clear() {
+        snapshots_.clear();
+        newest_.clear();
+        bytes_ = 0;
+    }
+
+    [[nodiscard]] bool empty() const { return snapshots_.empty(); }
+    [[nodiscard]] size_t size() const { return snapshots_.size(); }
+    [[nodiscard]] uint64_t cycle(const size_t index) const { return snapshots_[index].cycle; }
+    // Memory held by the history, the newest state included.
+    [[nodiscard]] size_t bytes() const { return bytes_ + newest_.size(); }
+
+    // The number of snapshots taken at or before cycle. The newest of them is at index countAtOrBefore(cycle) - 1.
+    [[nodiscard]] size_t countAtOrBefore(const uint64_t cycle) const {
+        const auto it = std::upper_bound(snapshots_.begin(), snapshots_.end(), cycle,
+                                         [](const uint64_t c, const Snapshot& s) { return c < s.cycle; });
+        return static_cast<size_t>(it - snapshots_.begin());
+    }
+
+    // Add the state of the machine at cycle. Snapshots at or after cycle belong to a future that is being replaced,
+    // so they are dropped first.
+    void record(const uint64_t cycle, const std::span<const uint8_t> state) {
+        const size_t keep = cycle != 0 ? countAtOrBefore(cycle - 1) : 0;
+        if (keep == 0) {
+            clear();
+        }
+        else {
+            discardAfter(keep - 1);
+        }
+
+        if (!snapshots_.empty()) {
+            Snapshot& previous = snapshots_.back();
+            if (state.size() == newest_.size()) {
+                // Store the pages that are about to change, then bring the newest state up to date.
+                for (size_t page = 0; page * kPageSize < state.size(); ++page) {
+                    const size_t offset = page * kPageSize;
+                    if (std::memcmp(&newest_[offset], &state[offset], pageBytes(page, state.size())) != 0) {
+                        previous.pages.push_back(static_cast<uint32_t>(page));
+                    }
+                }
+                previous.data.resize(previous.pages.size() * kPageSize);
+                for (size_t i = 0; i < previous.pages.size(); ++i) {
+                    const size_t offset = previous.pages[i] * size_t{kPageSize};
+                    const size_t n = pageBytes(previous.pages[i], state.size());
+                    std::memcpy(&previous.data[i * kPageSize], &newest_[offset], n);
+                    std::memcpy(&newest_[offset], &state[offset], n);
+                }
+            }
+            else {
+                previous.whole = true;
+                previous.data = std::move(newest_);
+                newest_.assign(state.begin(), state.end());
+            }
+            bytes_ += cost(previous);
+        }
+        else {
+            newest_.assign(state.begin(), state.end());
+        }
+        snapshots_.push_back({cycle, state.size(), false, {}, {}});
+        evict();
+    }
+
+    // Rebuild the state of the snapshot at index into out.
+    void restore(const size_t index, std::vector<uint8_t>& out) const {
+        const size_t size = snapshots_[index].size;
+        const size_t page_count = (size + kPageSize - 1) / kPageSize;
+        out.resize(size);
+        // Each page comes from the first snapshot from index on that stored it; pages no snapshot stored are
+        // unchanged since, and come from the newest state.
+        std::vector<bool> filled(page_count, false);
+        size_t remaining = page_count;
+        for (size_t i = index; i + 1 < snapshots_.size() && remaining != 0; ++i) {
+            const Snapshot& s = snapshots_[i];
+            if (s.whole) {
+                fillRemaining(filled, remaining, s.data, out);
+                return;
+            }
+            for (size_t k = 0; k < s.pages.size(); ++k) {
+                const uint32_t page = s.pages[k];
+                if (!filled[page]) {
+                    filled[page] = true;
+                    --remaining;
+                    std::memcpy(&out[page * size_t{kPageSize}], &s.data[k * kPageSize], pageBytes(page, size));
+                }
+            }
+        }
+        if (remaining != 0) {
+            fillRemaining(filled, remaining, newest_, out);
+        }
+    }
+
+    // Drop every snapshot after index, making the one at index the newest.
+    void discardAfter(const size_t index) {
+        if (index + 1 >= snapshots_.size()) {
+            return;
+        }
+        std::vector<uint8_t> state;
+        restore(index, state);
+        newest_ = std::move(state);
+        while (snapshots_.size() > index + 1) {
+            bytes_ -= cost(snapshots_.back());
+            snapshots_.pop_back();
+        }
+        Snapshot& s = snapshots_.back();
+        bytes_ -= cost(s);
+        s.whole = false;
+        s.pages = {};
+        s.data = {};
+    }
+
+private:
+    struct Snapshot
+    {
+        uint64_t cycle;
+        size_t size; // Size of the save state
+        bool whole; // data is the whole state rather than the pages listed in pages
+        std::vector<uint32_t> pages; // Pages that differ from the next snapshot, in ascending order
+        std::vector<uint8_t> data; // Their contents, kPageSize bytes apart
+    };
+
+    [[nodiscard]] static size_t pageBytes(const size_t page, const size_t size) {
+        return std::min(kPageSize, size - page * kPageSize);
+    }
+
+    [[nodiscard]] static size_t cost(const Snapshot& s) {
+        return s.data.size() + s.pages.size() * sizeof(uint32_t);
+    }
+
+    static void fillRemaining(std::vector<bool>& filled, size_t& remaining, const std::vector<uint8_t>& source,
+                              std::vector<uint8_t>& out) {
+        for (size_t page = 0; page < filled.size() && remaining != 0; ++page) {
+            if (!filled[page]) {
+                filled[page] = true;
+                --remaining;
+                const size_t offset = page * kPageSize;
+                std::memcpy(&out[offset], &source[offset], pageBytes(page, out.size()));
+            }
+        }
+    }
+
+    void evict() {
+        while (snapshots_.size() > capacity_ || (snapshots_.size() > 1 && bytes() > byte_budget_)) {
+            bytes_ -= cost(snapshots_.front());
+            snapshots_.pop_front();
+        }
+    }
+
+    std::deque<Snapshot> snapshots_;
+    std::vector<uint8_t> newest_; // State of the newest snapshot
+    size_t bytes_{0}; // Memory held by the older snapshots
+    size_t capacity_{kDefaultCapacity};
+    size_t byte_budget_{kDefaultByteBudget};
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// A flat byte buffer that components serialize their state into. Two buffers filled the same way compare equal exactly
+// when the state written to them is equal, which lets the REP fast path check a batch against stepping.
+class StateBuffer
+{
+public:
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateBuffer can only hold trivially copyable values");
+        const size_t offset = bytes_.size();
+        bytes_.resize(offset + sizeof(T));
+        std::memcpy(&bytes_[offset], &value, sizeof(T));
+    }
+
+    void clear() {
+        bytes_.clear();
+    }
+
+    const uint8_t* data() const { return bytes_.data(); }
+    size_t size() const { return bytes_.size(); }
+
+    // FNV-1a hash of the contents, used to reject most mismatches without a full compare.
+    uint64_t hash() const {
+        uint64_t h = 1469598103934665603ull;
+        for (const uint8_t b : bytes_) {
+            h ^= b;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    bool operator==(const StateBuffer& other) const {
+        return bytes_ == other.bytes_;
+    }
+
+    bool operator!=(const StateBuffer& other) const {
+        return bytes_ != other.bytes_;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
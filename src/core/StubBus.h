@@ -5,6 +5,8 @@
 #include <string>
 #include <algorithm>
 
+#include "StateBuffer.h"
+
 // Simple stub bus used for testing the Cpu core.
 // - 1 MiB of addressable RAM
 // - Memory reads/writes access the internal buffer
@@ -28,6 +30,9 @@ struct StubBus
         type_ = type;
     }
 
+    // All of the stub's memory is plain RAM.
+    bool isHostMemory(uint32_t /*address*/) const { return true; }
+
     // Returns whether the bus is ready. Always ready for stub
     bool ready() const { return true; }
 
@@ -62,6 +67,29 @@ struct StubBus
     void tick() {
     }
 
+    void tickFor(uint32_t /*n*/) {
+    }
+
+    // The stub has no interrupt sources.
+    uint32_t ticksUntilNextEvent() const { return UINT32_MAX; }
+
+    // The stub has no DMA.
+    uint32_t ticksUntilDMARequest() const { return UINT32_MAX; }
+
+    // Nothing on the stub's side of the bus moves on its own.
+    void appendTimingState(StateBuffer& /*out*/) const {
+    }
+
+    // Memory reads come from RAM, which only the CPU writes; ports read as open bus, but aren't promised to.
+    bool stableRead(uint32_t address, int type, uint8_t& value, uint32_t& stableTicks) const {
+        if (type != 4 && type != 5) {
+            return false;
+        }
+        value = ram_[address & 0xFFFFF];
+        stableTicks = UINT32_MAX;
+        return true;
+    }
+
     // DMA/interrupt/CGA helpers -- return safe defaults
     bool getAEN() const { return false; }
     bool getDMA() const { return false; }
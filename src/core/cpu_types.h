@@ -50,5 +50,40 @@ enum class QueueReadState
 };
 
 
+// A compile-time list of indices, like C++14's std::index_sequence, for expanding a table of template instances.
+template <std::size_t... Indices>
+struct IndexList
+{
+};
+
+template <typename First, typename Second>
+struct JoinIndexLists;
+
+template <std::size_t... First, std::size_t... Second>
+struct JoinIndexLists<IndexList<First...>, IndexList<Second...>>
+{
+    using Type = IndexList<First..., (sizeof...(First) + Second)...>;
+};
+
+// IndexList<0, 1, ..., N - 1>. Built by halving, so templates nest only log2(N) deep.
+template <std::size_t N>
+struct MakeIndexList
+{
+    using Type = typename JoinIndexLists<typename MakeIndexList<N / 2>::Type,
+                                         typename MakeIndexList<N - N / 2>::Type>::Type;
+};
+
+template <>
+struct MakeIndexList<0>
+{
+    using Type = IndexList<>;
+};
+
+template <>
+struct MakeIndexList<1>
+{
+    using Type = IndexList<0>;
+};
+
 #endif //XTCE_BLUE_CPU_TYPES_H
 
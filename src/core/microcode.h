@@ -1,626 +0,0 @@
-#ifndef EMBEDDED_FILES_H
-#define EMBEDDED_FILES_H
-
-#include <string_view>
-
-inline constexpr std::string_view mc_1t_txt = R"(0001111111100000
-1110000000011100
-0000000000011100
-0110011001111100
-1010101010111101
-1111111111111111
-1111111111100011
-0000000000011100
-1110000111100011
-1111111000010111
-1111111000011011
-)";
-
-inline constexpr std::string_view mc_l = R"(0010110000010010000000010101001000101111000101100000000100110000
-1110100000001011110011001000101101010110010000110010111011000001
-1111010000010101011100111010000100101100110010011100010101111111
-1110010001000000101111001000100110110110111101010111111111111011
-0010110000001000110000010001101000000111111111111111111011111110
-1111011000011011011111111011001100011100000101100100010011110001
-1111110010000100001100111101001101111110111010110011110100110011
-0110010000111000100101001010001100111111110001111100111111001001
-0001000000000000000000000000000001100000000000000000000100000001
-1111000000001000100011001000000100000000010000010000111000000001
-0110000000000000001100111000000100110100010100010010010101001101
-1110000000000000001111001000000101111101011101010000111110000011
-1111101111111101001111111010110111110011111010001011010111001111
-1111100111110100100000001111111110111111111010111111001100111111
-0111101101101010100011101100010111111101111101000111011101001101
-0110101110110111010101111111011101111101011111011111111110110111
-1111011111110111111111101111111110011101110101110110101011110000
-1111011111110111011101111111110011111101100101000110000100110001
-1111011111110111110111011001011111111111111011101111111110000011
-1111011111001111110000111111111111111101010011111111111111111101
-0000100000010000010000010001000001001111001010001001000100001111
-1110100000001000000011001000000101010010010010001011010011001111
-1110100000010000010000001111100100111110110100010111010111001101
-0110100000000000001111001000000111111101111101010110111110000001
-1111101111101111111111101011011111111111001111111111101100001111
-1111101111110111110100111100110011101111111111001011101111111111
-0111111111111111101111111111110111100111111001100100111111110011
-1111101111111111110000111101111111111111111011111011111110110111
-0010000011001110100000010001000001000101110001010110111111110000
-1110010000011011101111101110101000001100010100010100001000110001
-1110011110000101011100111001000101110100111011101110110111110011
-0110001001111010001111001001101111111111011111111011111110010011
-0000010000001000100000010100000000100000010101010100011000000000
-1110000000000000001100101000101000000000000101110010000000000001
-1110000000000000010000001000001100100100010010100000010100000011
-1110000000000000000000001000000100110100010001010001111111110001
-1110001111101111001111111110010110011100100000000010110011110001
-1111000111110111100100111100011011111101100000110110111111110001
-1110011111110111111111111010110111111111011111011111111100111101
-1110011111001111011111111101111110110110110111111110111110000111
-1111111111111111111111111111111111111111111111111111111111111111
-1111111111111111011111111111111111111111111111111111111111111111
-1111111111111111111111101111111111111111111110111111111111111111
-0111110110111101111111111110111111111111111101011111111111111101
-0000000010000011101100110100010010001111000011000000001000111110
-1110001111100011000011101000000001000000001000101000000000000001
-0110101101001111000000011111101100100100010010100110010100000011
-0110000101010100110000001001000110110100010001110000111110000001
-1111111101111100010000001001011111110001001110111111110100001111
-1111110011101100110011111100011110011101110111010101111011111111
-1111110010110111101100101110110110110110110101111001110111111101
-1111111110111111001111111100110101111111111111011110111111001011
-1111111001111111010000001001001101110110111111111111110111001111
-1111011100111111110000011111111110111101110111010111111111111111
-0111101010101111101100111001011111111111111111011001111111111101
-0111111010001011101111111010011101111111111111011101111110110111
-0010001000010000100011010100010010000111110011000000001011001110
-1110100000000110001111001011000000000111001000100000000000000001
-0111111010011000010011011111101101111101111010100010010100000011
-1110000000110100000000001100001100111101010001010110111111001001
-0010000110010011101100110110100010000110110000000000001011000000
-1110101111010001000000101011100000100111001000100010000100000001
-0111111111011101010011011000101101111101111000100010011100000011
-1110000101110100110000001111001110111101010001110111111111111101
-0010000100000000100000110100010010001110110011000000001011111110
-1110100011110110000000101011100001000111001000101010000000000001
-1111010000011101010011011101001101111101111010100110010100000011
-1110000100110100000000001111101110111101010001110110111111001001
-0000001100000010001111100110100010001111010011000000000000001110
-1110101101100100000011101001100001000010001000100000000000000001
-1110011010011101010011011100101100100100011010100010010100000001
-1110000101110000010000001110000100110100010001010010111111001001
-1111000010000011100000111010110010110110100011000110101111111111
-1110000110110010101100001001110110001110111000100110011000000001
-0110011100101100010000111011001110110101010111011000110111001111
-0110000001000100001111111110100101111110111111111010111111111011
-1110001000000111001100011110100110101110100001000000110111110001
-1110101000000011101100001011110101000111010001111000111011000001
-1110101111110011001100111111111100110101010111110110110111001111
-0110000111000001111111111011100111111111111111110010111110000011
-1110001010000111001111111100010010101111100011000010100111111111
-1110101100000011100000001000010101000111011000101110011000000001
-0110101111101000000000101111011110110101010001110110110111001101
-1110000011110101111111111101100111111111111111111000111110000011
-)";
-
-inline constexpr std::string_view mc_r = R"(1011001000000001111111111000010000000000000001011010001101100010
-0010100000100000101100000101001101001001101100110000011010010101
-1110100110111000100000100010011100011000101111011110001101101110
-1110100001111101110000000001101001111010111100111111111011111101
-0111101000111000101100100000110000110100110011110101111111111011
-0001100000011000110011111011001100001001001100011010101111100110
-1111100011100000111100111101101101011001111110011111001101101100
-1111100001111001110000000000101001101010101100101000011110010101
-1110000000000000100000000000110001000000000000000000001000000000
-0010000000000000100000011010001000000000001100100000011000010101
-0110000000100000100000100100001000001000101101000000001010000110
-1110000001101000110000000000001001101000101100101001111010001100
-1010010111111110100000100001001111111111111110000101001010001100
-1111011111101111000000000000111010111110111011111111011101111101
-1110011001100111100011011001001111111101111001100101111010010111
-1111011111100010111111111110111011111101111111111101011111101110
-0011111111010111011111011001011110001011101101111010111111110111
-1111111111110111111111100101111111101010101101011010101101100110
-0111111110111111111111100011111011101111111110100011111000011101
-1111111111110111101111111110111111101101111111111010011111110111
-1100000000100000010001100110110001110100010010011111001100001000
-0001000000110000000100000000001101010101001010000101001010001101
-1111000000100000110000011100101000011010101001010111001110000100
-1111000001111000100000000001001101111010101100111101011111000100
-1011011111111111110100000111011111111111011111111111011100011111
-1110111111011111110011111111111011111111011111111111111011111110
-1111011111100111101111111010101111111110111110111110111111111111
-1110011111111111111111111111111011111111101111101101111010101110
-1101001100011001101111100000110001000000100001110000111011110010
-0001100000011010111111011111001000001000101000111010111101110100
-0111000111111000111100100111101101001011111010001010001011101110
-1111010001111101100000000000111101101000111110111011011110101101
-0000000000000000001111111000000000000000100000100000111000010011
-0000000000000000011111000001001000001000101000000000001000000110
-0110100000101000111100000000011100001000101010000000001000001100
-1110000001100000100000000000001000101000111100101000011010100100
-0001011111010111100111111111001110001011001101011010101111100100
-1101111111100111111100111110111011100011101001111010111111110101
-1110011110111111110011100010111111101101111101111001111101110111
-1111111111100111101111111111111110101111111111111010011110011110
-1111111111111111111111111111111111111111111111111111111111111111
-1111111111111101011111111111111111111111111111011111101111101111
-0111111111111111111111011111111111111111111111111111111111111101
-1111101111111110111111111111111111111111111101111111111111110111
-1100010111001110100011111110000010000100000111110010111001111010
-0000001110011101001100000011001001000000011001000000101000000100
-1110111000100101110000101100111000001000101010010110101000001100
-1110111111100010100000100010011010101000101100101000011010000100
-1111111011101101011100000110111111111100110110001101001100001001
-1110110101101111100000111111111110111101001111111101011011111111
-0111101111100010100000011110001110111110111101010000101111100110
-1111110101111101110000111111101111111111101110101111111110011101
-0010111010010011011111000000111111111100111110011101101110001101
-1111010001000110101100111010111110011111101110111111111111111111
-1111000110111101110000001001001111111111111111101001111111110111
-1111000011111111100000010101101101111111111111111011111111101110
-0101010001111011100000100110000000000111000011110000011010011010
-0001110000101010010011000011001000001010011001010010001100000100
-0110110111111001111111011101011001001001101010010001001000001100
-1110110101100000111100101010101000101000101100101100011010010101
-1001000101111101100011111111000010000011001001110000111010010110
-0001101110101111011100000010001010001010111000010010101100000100
-1110111111110111110011101001011001001001101000111001011000011101
-1110111111100010111111000000111000101000111101111100011011110111
-0101000001111111100000111000000000000111000011110010011011111010
-0001101100111111010000000110001011001010011001010010001100000100
-0110110001111011110011111111111001001001101010010111001000001100
-1110110101100000111100001010111010101000101100101100011010010101
-1101000011111001100011000101000010000111000110010010101000001000
-0000101100101110011111000001001011100000111001000000001000000100
-1110110111111111110011011100011000001000101010010000101000000100
-1110101111100010101111101010001010101000111100101100011010010101
-0100010001000010100000100001111010001111000111110000111011111011
-1110100010000101111100000100101000101011011101100000111100010111
-0110011000100001101111110110101010101101101111001000001010001110
-1110100011111000111100011110101101101111101110111111011111111101
-1101010100010010100011111011011000000011000000010010001011100011
-1110011010010001101111000111001001001011001100100000011110010111
-1111111000100101111100001111011110101001101111000110101010001110
-1111111001100010110011110110111111101010101110101101111110001100
-0001010111111110000011111010011000000111000111010010101011101010
-1110011010111001111111000110101001101011011100100000111100010101
-1111111001100101111111111010111010101001101101000110001010000110
-1111011011100010100000011100111101101110101110101101011010001100
-)";
-
-inline constexpr std::string_view mc_1b_txt = R"(1110000000011111
-0001111111100011
-1111111111100011
-1001100110000011
-0101010101000010
-0000000000000000
-0000000000011100
-1111111111100011
-0001111000011100
-0000000111101000
-0000000111100100
-)";
-
-inline constexpr std::string_view mc_l1a_txt = R"(1111101111101111111111101011011111111111001111111111101100001111
-1111101111111111110100111100110011101111111111001011101111111111
-0111111111111111101111111111110111100111111001100100111111110011
-1111101111111111110000111101111111111111111011111011111110110111
-0010000011000110100000010001000001000101110001010110111111110000
-1110010000011011101111101110101000001100010100010100001000110001
-1110011110000101011100111001000101110100111011101110110111110011
-0110001001111010001111001001101111111111011111111011111110010011
-0000010000000000100000010100000000100000010101010100011000000000
-1110000000000000001100101000101000000000000101110010000000000001
-1110000000000000010000001000001100100100010010100000010100000011
-1110000000000000000000001000000100110100010001010001111111110001
-1110001111101111001111111110010110011100100000000010110011110001
-1111000111110111100100111100011011111101100000110110111111110001
-1110011111110111111111111010110111111111011111011111111100111101
-1110011111001111011111111101111110110110110111111110111110000111
-1111111111111111111111111111111111111111111111111111111111111111
-1111111111111111011111111111111111111111111111111111111111111111
-1111111111111111111111101111111111111111111110111111111111111111
-0111110110111101111111111110111111111111111101011111111111111101
-0000000010000011101100110100010010001111000011000000001000111110
-1110001111100011000011101000000001000000001000101000000000000001
-0110101101001111000000011111101100100100010010100110010100000011
-0110000101010100110000001001000110110100010001110000111110000001
-)";
-
-inline constexpr std::string_view mc_l0a_txt = R"(0010110000010010000000010101001000101111000101100000000100110000
-1110100000000011110011001000101101010110010000110010111011000001
-1111010000010101011100111010000100101100110010011100010101111111
-1110010001110000101111001000100110110110111101010111111111111011
-0010110000000000110000010001101000000111111111111111111011111110
-1111011000011011011111111011001100011100000101100100010011110001
-1111110010000100001100111101001101111110111010110011110100110011
-0110010000001000100101001010001100111111110001111100111111001001
-0001000000000000000000000000000001100000000000000000000100000001
-1111000000000000100011001000000100000000010000010000111000000001
-0110000000000000001100111000000100110100010100010010010101001101
-1110000000000000001111001000000101111101011101010000111110000011
-1111101111111101001111111010110111110011111010001011010111001111
-1111100111111100100000001111111110111111111010111111001100111111
-0111101101101010100011101100010111111101111101000111011101001101
-0110101110110111010101111111011101111101011111011111111110110111
-1111011111111111111111101111111110011101110101110110101011110000
-1111011111110111011101111111110011111101100101000110000100110001
-1111011111110111110111011001011111111111111011101111111110000011
-1111011111111111110000111111111111111101010011111111111111111101
-0000100000010000010000010001000001001111001010001001000100001111
-1110100000001000000011001000000101010010010010001011010011001111
-1110100000010000010000001111100100111110110100010111010111001101
-0110100000000000001111001000000111111101111101010110111110000001
-)";
-
-inline constexpr std::string_view mc_0b_txt = R"(00001111
-01111110
-00000001
-01101001
-10110101
-00001000
-01111000
-00000111
-01100000
-10111000
-11111000
-)";
-
-inline constexpr std::string_view mc_0t_txt = R"(11110000
-10000001
-11111110
-10010110
-01001010
-11110111
-11100111
-11111000
-10011111
-01000111
-01110111
-)";
-
-inline constexpr std::string_view mc_7t_txt = R"(0001110000000011
-0001110000100111
-1111111110010011
-1111111111111111
-0111110111111111
-0000011101001000
-0001110001001100
-1111111111111111
-1111110000100101
-1110010010110101
-0010110000111111
-)";
-
-inline constexpr std::string_view mc_7b_txt = R"(1110011111111100
-1110011111011000
-0000010001101100
-0000010000000000
-1000011000000000
-1111110011111111
-1110011111111011
-0001110000000011
-0000011111111110
-0001111101101110
-1101011111100111
-)";
-
-inline constexpr std::string_view mc_6b_txt = R"(0011111000010000
-1010001000010011
-0000000000000000
-0000000000000000
-0001000101001000
-0101111001111100
-1000000111111100
-0100000001101100
-0010001000000000
-0001101001111110
-1111111000001111
-)";
-
-inline constexpr std::string_view mc_group_txt = R"(11111111111011111111011111111111110000
-01101010000010010000011110110110000000
-11110101111011111111111111111111110000
-11111111111011111111111111111110000000
-11111010000010011000000011110000000000
-00100100000010010000000000000000000000
-11111111111011111100111111111111110000
-11111011111011111011011111111111110000
-11111111111011111111111100111111110000
-00111111111001111111111100111111110000
-11111111111010011100111111111110000000
-00010001111001100011011111111111110000
-11111111111011111111111111110101110000
-11011111111011111111101111111111110000
-00000011000000000000000000000000000000
-???0?????????01?????????11??0???1?1?10
-10??010?0????11?0??1????011?0??0010?00
-001?1???????011*1?0??0????1??01*?*0???
-11?*00*?0????00?0?1*0?*?**010?0?0?1?*0
-00001011000?01111011111?00110111011?00
-11110?0??00??0001100111?1110?100?00?1?
-00001?1?001??1100111110?00001001111?00
-00000101100?10000000000?00001000100?01
-00000000000?00000000000100000000000?00
-)";
-
-inline constexpr std::string_view mc_6t_txt = R"(1100000111101111
-0101110111101100
-1111111111111111
-1111111111111111
-1110111010110111
-1010000110000011
-0111111000000011
-1111111111111111
-1101111111111111
-1110011110000001
-1111111111110011
-)";
-
-inline constexpr std::string_view mc_5b_txt = R"(0000111110000111
-0000000000000110
-0000000000000000
-0000000000000000
-0010001000000100
-1100000000000001
-1111111101100000
-1100000000000000
-1100010001111111
-0011111111010111
-1011011111111110
-)";
-
-inline constexpr std::string_view mc_5t_txt = R"(1111000001111000
-1111111111111001
-1111111111111111
-1111111111111111
-1101110111111011
-0011111111111110
-0000100010011111
-1111111111111111
-0011101110000000
-1111101110101000
-0100100001111111
-)";
-
-inline constexpr std::string_view mc_4t_txt = R"(1000000000000111
-0111110000110111
-1111111111111011
-1001111111111111
-1010111101111101
-1000000000111111
-0111100000110100
-1111111111111111
-1000010011000111
-0000010000111100
-1000010100011111
-)";
-
-inline constexpr std::string_view mc_4b_txt = R"(0111111111111000
-1000001111001000
-0000000000000100
-0110000000000000
-0101000010000010
-0111111111000100
-1000011111001111
-0000000000000000
-0111111100111100
-1111111111001111
-1111111011100100
-)";
-
-inline constexpr std::string_view mc_8t_txt = R"(11000100
-00100000
-10111011
-11111111
-11101111
-01111111
-11111100
-11111111
-10011101
-11011111
-11111101
-)";
-
-inline constexpr std::string_view mc_8b_txt = R"(01111111
-11011111
-01010100
-00000000
-00010000
-11000100
-11000111
-00000000
-11100010
-10111101
-11111111
-)";
-
-inline constexpr std::string_view mc_3b_txt = R"(0000000000000000
-0000111000011111
-0000111000000000
-0000000000000100
-1010100010010010
-1111110000000000
-0000111000011111
-1100000000000000
-1111111000011111
-0000111100100111
-1111111011111111
-)";
-
-inline constexpr std::string_view mc_3t_txt = R"(1111111111111111
-1111000111100000
-1111000111111111
-1111111111111011
-0101011101101101
-0000001111111111
-1111111111111111
-0011111111111111
-0000000111100000
-1111000011011000
-1111000111011111
-)";
-
-inline constexpr std::string_view mc_2t_txt = R"(0011110000001111
-0000001111111111
-0000000001111111
-1100110111111111
-0101011010110101
-1111111110000000
-1111111111111111
-0000001111110011
-1111111110000000
-1100001111110000
-1111111111101111
-)";
-
-inline constexpr std::string_view mc_2b_txt = R"(1100001111110000
-1111110000000000
-1111111110000000
-0011001000000000
-1010100101001010
-0000000001111111
-0000001110000000
-1111110000001100
-0000001111111111
-0011111110001111
-0000001110011111
-)";
-
-inline constexpr std::string_view mc_translation_8086_txt =
-    R"(00000?0? 111111011 0011 1    5 0    ?11111011.0011  0x06b  FARCALL
-00001?0? 111111010 0011 1    5 1    ?11111010.0011  0x077  NEARCALL
-10000?0? 011001011 0010 1    7 0    0110010?1.0010  0x0c2  FARRET
-00010?0? 011101011 0010 1    5 2    0111010?1.0010  0x0d2  RELJMP
-??000?1? 101000000 0000 0      0    101000000.0000  0x1d4  [BX+SI]
-??001?1? 101000000 0110 0      1    101000000.0110  0x1da  [BX+DI]
-
-??010?1? 101000000 0111 1      2    101000000.0111  0x1db  [BP+SI]
-??011?1? 101000000 0011 1      3    101000000.0011  0x1d7  [BP+DI]
-??100?1? 010001011 0011 0      4    0100010??.0011  0x003  [SI]
-??101?1? 010111111 0011 0      5    01011????.0011  0x01f  [DI]
-00110?1? 101000000 1000 0      6    101000000.1000  0x1dc  [iw]
-01110?1? 111111001 0011 1      6    ?1111100?.0011  0x023  [BP]
-10110?1? 111111001 0011 1      6    ?1111100?.0011  0x023  [BP]
-??111?1? 001011111 0011 0      7    001011???.0011  0x037  [BX]
-
-00011?00 101000000 1010 1    5 3    101000000.1010  0x1de  [i]
-00011001 101000000 1101 1    5 3    101000000.1101  0x1e1  EALOAD
-00011101 101000000 1111 1    5 3    101000000.1111  0x1e3  EADONE
-0010000? 101000000 1101 1    5 4    101000000.1101  0x1e1  EALOAD
-0010010? 101000000 1111 1    5 4    101000000.1111  0x1e3  EADONE
-00101?0? 111111011 0100 1    5 5    ?11111011.0100  0x06c  FARCALL2
-
-00110?0? 100000000 0101 1    5 6    100000000.0101  0x19d  INTR
-10001?0? 011010111 0110 1    7 1    011010111.0110  0x112  RPTS
-00111?0? 100000000 1111 1    5 7    100000000.1111  0x1a7  INT0
-10010?0? 001001111 0011 1    7 2    00100????.0011  0x17f  CORX
-10011?0? 100100010 0000 1    7 3    100100010.0000  0x188  CORD
-10100?0? 100100011 1100 1    7 4    100100011.1100  0x1c0  PREIMUL
-10101?0? 100100011 0010 1    7 5    100100011.0010  0x1b6  NEGATE
-10110?0? 100100100 1001 1    7 6    100100100.1001  0x1cd  IMULCOF
-
-10111?0? 100100100 1110 1    7 7    100100100.1110  0x1d2  MULCOF
-11000?0? 100100011 0000 1    7 8    100100011.0000  0x1b4  PREIDIV
-11001?0? 100100100 0000 1    7 9    100100100.0000  0x1c4  POSTIDIV
-01000?0? 011010111 1100 1    5 8    011010111.1100  0x118  RPTI
-01001?0? 011010100 0101 1    5 9    011010100.0101  0x179  AAEND
-??????0? 111111111 1111 1
-??????0? 111111111 1111 1)";
-
-inline constexpr std::string_view mc_translation_8088_txt =
-    R"(00000?0? 111111011 0011 1    5 0    ?11111011.0011  0x06b  FARCALL
-00001?0? 111111010 0011 1    5 1    ?11111010.0011  0x077  NEARCALL
-10000?0? 011001011 0010 1    7 0    0110010?1.0010  0x0c2  FARRET
-00010?0? 011101011 0010 1    5 2    0111010?1.0010  0x0d2  RELJMP
-??000?1? 101000000 0000 0      0    101000000.0000  0x1d4  [BX+SI]
-??001?1? 101000000 0110 0      1    101000000.0110  0x1da  [BX+DI]
-
-??010?1? 101000000 0111 1      2    101000000.0111  0x1db  [BP+SI]
-??011?1? 101000000 0011 1      3    101000000.0011  0x1d7  [BP+DI]
-??100?1? 010001011 0011 0      4    0100010??.0011  0x003  [SI]
-??101?1? 010111111 0011 0      5    01011????.0011  0x01f  [DI]
-00110?1? 101000000 1000 0      6    101000000.1000  0x1dc  [iw]
-01110?1? 111111001 0011 1      6    ?1111100?.0011  0x023  [BP]
-10110?1? 111111001 0011 1      6    ?1111100?.0011  0x023  [BP]
-??111?1? 001011111 0011 0      7    001011???.0011  0x037  [BX]
-
-00011?00 101000000 1010 1    5 3    101000000.1010  0x1de  [i]
-00011001 101000000 1101 1    5 3    101000000.1101  0x1e1  EALOAD
-00011101 101000000 1111 1    5 3    101000000.1111  0x1e3  EADONE
-0010000? 101000000 1101 1    5 4    101000000.1101  0x1e1  EALOAD
-0010010? 101000000 1111 1    5 4    101000000.1111  0x1e3  EADONE
-00101?0? 111111011 0100 1    5 5    ?11111011.0100  0x06c  FARCALL2
-
-00110?0? 100000000 0110 1    5 6    100000000.0101  0x19d  INTR
-10001?0? 011010111 0110 1    7 1    011010111.0110  0x112  RPTS
-00111?0? 100000000 1111 1    5 7    100000000.1111  0x1a7  INT0
-10010?0? 001001111 0011 1    7 2    00100????.0011  0x17f  CORX
-10011?0? 100100010 0000 1    7 3    100100010.0000  0x188  CORD
-10100?0? 100100011 1100 1    7 4    100100011.1100  0x1c0  PREIMUL
-10101?0? 100100011 0010 1    7 5    100100011.0010  0x1b6  NEGATE
-10110?0? 100100100 1001 1    7 6    100100100.1001  0x1cd  IMULCOF
-
-10111?0? 100100100 1110 1    7 7    100100100.1110  0x1d2  MULCOF
-11000?0? 100100011 0000 1    7 8    100100011.0000  0x1b4  PREIDIV
-11001?0? 100100100 0000 1    7 9    100100100.0000  0x1c4  POSTIDIV
-01000?0? 011010111 1100 1    5 8    011010111.1100  0x118  RPTI
-01001?0? 011010100 0101 1    5 9    011010100.0101  0x179  AAEND
-??????0? 111111111 1111 1
-??????0? 111111111 1111 1)";
-
-constexpr std::string_view get_file(const std::string_view name) {
-    if (name == "l")
-        return mc_l;
-    if (name == "r")
-        return mc_r;
-    if (name == "1t.txt")
-        return mc_1t_txt;
-    if (name == "1b.txt")
-        return mc_1b_txt;
-    if (name == "l1a.txt")
-        return mc_l1a_txt;
-    if (name == "l0a.txt")
-        return mc_l0a_txt;
-    if (name == "0b.txt")
-        return mc_0b_txt;
-    if (name == "0t.txt")
-        return mc_0t_txt;
-    if (name == "7t.txt")
-        return mc_7t_txt;
-    if (name == "7b.txt")
-        return mc_7b_txt;
-    if (name == "6b.txt")
-        return mc_6b_txt;
-    if (name == "group.txt")
-        return mc_group_txt;
-    if (name == "6t.txt")
-        return mc_6t_txt;
-    if (name == "5b.txt")
-        return mc_5b_txt;
-    if (name == "5t.txt")
-        return mc_5t_txt;
-    if (name == "4t.txt")
-        return mc_4t_txt;
-    if (name == "4b.txt")
-        return mc_4b_txt;
-    if (name == "8t.txt")
-        return mc_8t_txt;
-    if (name == "8b.txt")
-        return mc_8b_txt;
-    if (name == "3b.txt")
-        return mc_3b_txt;
-    if (name == "3t.txt")
-        return mc_3t_txt;
-    if (name == "2t.txt")
-        return mc_2t_txt;
-    if (name == "2b.txt")
-        return mc_2b_txt;
-    if (name == "translation_8088.txt")
-        return mc_translation_8088_txt;
-    if (name == "translation_8086.txt")
-        return mc_translation_8086_txt;
-    throw std::runtime_error("File not found: " + std::string(name));
-}
-
-#endif // EMBEDDED_FILES_H
@@ -0,0 +1,151 @@
+#include "Benchmark.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "CgaKernels.h"
+#include "Machine.h"
+#include "font.h"
+
+bool Benchmark::run() {
+    if (cga_kernels_) {
+        runCgaKernels();
+        return true;
+    }
+    bool found = false;
+    bool passed = true;
+    forEachMachineConfig([&]<typename Config>() {
+        if (machine_ == "all" || machine_ == Config::kName) {
+            found = true;
+            passed = runMachine<Config>() && passed;
+        }
+    });
+    if (!found) {
+        std::cerr << std::format("Unknown machine configuration: {}\n", machine_);
+    }
+    return found && passed;
+}
+
+template <typename Config>
+bool Benchmark::runMachine() {
+    // Startup: building the machine sets up the CPU and its microcode tables, the bus and the devices, and resets
+    // them. Large, and the bus must not move once built.
+    const auto startup_start = std::chrono::steady_clock::now();
+    const auto machine = std::make_unique<BasicMachine<Config>>();
+    const std::chrono::duration<double, std::micro> startup = std::chrono::steady_clock::now() - startup_start;
+    auto* bus = machine->getBus();
+    bus->setSpeakerCallback([](uint64_t, bool, bool) {
+    });
+    if (!disk_image_.empty()) {
+        bus->fdc()->loadDisk(0, disk_image_, true);
+    }
+    machine->getCpu()->setRepFastPathMode(rep_fast_path_mode_);
+    machine->getCpu()->setLoopSkipMode(loop_skip_mode_);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames_; ++frame) {
+        machine->run_for(kTicksPerFrame);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double cycles = static_cast<double>(machine->cycleCount());
+    const double emulated = static_cast<double>(frames_) / 60.0;
+    std::cout << std::format("{:<12} {:>6} frames {:>12} cycles {:>8.3f}s {:>8.2f} Mcycles/s {:>6.1f}x real time "
+                             "{:>8.0f} us startup\n",
+                             Config::kName, frames_, machine->cycleCount(), elapsed.count(),
+                             cycles / elapsed.count() / 1e6, emulated / elapsed.count(), startup.count());
+    return !check_save_state_ || checkSaveState(*machine);
+}
+
+template <typename Config>
+bool Benchmark::checkSaveState(BasicMachine<Config>& machine) {
+    using Clock = std::chrono::steady_clock;
+    // Time a save into a buffer that has already grown, as repeated saves would use.
+    std::vector<uint8_t> saved;
+    machine.saveState(saved);
+    const auto save_start = Clock::now();
+    machine.saveState(saved);
+    const std::chrono::duration<double, std::micro> save_time = Clock::now() - save_start;
+
+    std::vector<uint8_t> expected;
+    for (int frame = 0; frame < kCheckFrames; ++frame) {
+        machine.run_for(kTicksPerFrame);
+    }
+    machine.saveState(expected);
+    const uint64_t expected_cycles = machine.cycleCount();
+
+    const auto load_start = Clock::now();
+    const bool loaded = machine.loadState(saved);
+    const std::chrono::duration<double, std::micro> load_time = Clock::now() - load_start;
+    if (!loaded) {
+        std::cerr << std::format("{}: save state failed to load\n", Config::kName);
+        return false;
+    }
+
+    // Loading and saving again must reproduce the save exactly.
+    std::vector<uint8_t> resaved;
+    machine.saveState(resaved);
+    if (resaved != saved) {
+        std::cerr << std::format("{}: save state changed when loaded\n", Config::kName);
+        return false;
+    }
+
+    std::vector<uint8_t> actual;
+    for (int frame = 0; frame < kCheckFrames; ++frame) {
+        machine.run_for(kTicksPerFrame);
+    }
+    machine.saveState(actual);
+    if (actual != expected || machine.cycleCount() != expected_cycles) {
+        std::cerr << std::format("{}: run from the save state diverged\n", Config::kName);
+        return false;
+    }
+
+    std::cout << std::format("{:<12} save state {} bytes, saved in {:.0f} us, loaded in {:.0f} us, {} frames "
+                             "match\n", Config::kName, saved.size(), save_time.count(), load_time.count(),
+                             kCheckFrames);
+    return true;
+}
+
+void Benchmark::runCgaKernels() const {
+    // Expand 640 pixel scanlines, as a frame of each mode would, taking successive lines from a block of pseudo
+    // random VRAM so that glyph lookups vary.
+    constexpr size_t kLines = 200;
+    constexpr size_t kLineBytes = 160;
+    constexpr size_t kLinePixels = 640;
+    constexpr int kRepeats = 500;
+    std::vector<uint8_t> vram(kLines * kLineBytes);
+    uint32_t seed = 1;
+    for (uint8_t& b : vram) {
+        seed = seed * 1664525 + 1013904223;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    std::vector<uint8_t> out(kLinePixels);
+    const CgaTextSpan span{&CGA_FONT_ROM[CGA_NORMAL_FONT_OFFSET], true, true, CgaTextSpan::kNoCursor};
+    const uint8_t colors[4] = {1, 3, 5, 7};
+
+    for (const auto level : {CgaKernelLevel::Scalar, CgaKernelLevel::Sse2, CgaKernelLevel::Avx2}) {
+        if (!cgaKernelLevelSupported(level)) {
+            continue;
+        }
+        const CgaKernels& kernels = cgaKernels(level);
+        const auto measure = [&](const char* mode, auto&& draw_line) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int repeat = 0; repeat < kRepeats; ++repeat) {
+                for (size_t line = 0; line < kLines; ++line) {
+                    draw_line(&vram[line * kLineBytes]);
+                }
+            }
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            const double pixels = static_cast<double>(kRepeats) * kLines * kLinePixels;
+            std::cout << std::format("{:<8} {:<16} {:>8.2f} pixels/ns\n", kernels.name, mode,
+                                     pixels / elapsed.count());
+        };
+        measure("text 80 column", [&](const uint8_t* line) { kernels.text_hchar(line, 80, span, out.data()); });
+        measure("text 40 column", [&](const uint8_t* line) { kernels.text_lchar(line, 40, span, out.data()); });
+        measure("graphics 640", [&](const uint8_t* line) { kernels.gfx_1bpp(line, 80, 15, out.data()); });
+        measure("graphics 320", [&](const uint8_t* line) { kernels.gfx_2bpp(line, 80, colors, out.data()); });
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Cpu.h"
+
+template <typename Config>
+class BasicMachine;
+
+// Runs machines headless for a fixed number of frames and reports how long each one took to start and how fast it
+// ran. Every configuration in MachineConfigs can be measured, each as its own instantiation of BasicMachine.
+class Benchmark
+{
+public:
+    // Crystal ticks in one 60 Hz frame.
+    static constexpr uint64_t kTicksPerFrame = 238636;
+
+    void setFrames(const int frames) { frames_ = frames; }
+    // Run only the configuration with this name, or every configuration if "all".
+    void setMachine(std::string name) { machine_ = std::move(name); }
+    // Boot from this floppy image; without one the machines only run the BIOS.
+    void setDiskImage(std::vector<uint8_t> image) { disk_image_ = std::move(image); }
+    void setRepFastPathMode(const RepFastPathMode mode) { rep_fast_path_mode_ = mode; }
+    void setLoopSkipMode(const LoopSkipMode mode) { loop_skip_mode_ = mode; }
+    // After each run, save the machine, run on, restore the save and run the same frames again, and check that both
+    // runs end in the same state.
+    void setCheckSaveState(const bool check) { check_save_state_ = check; }
+    // Measure the CGA span kernels (see CgaKernels.h) at each level the host supports, instead of the machines.
+    void setCgaKernels(const bool cga_kernels) { cga_kernels_ = cga_kernels; }
+
+    // Return false if no configuration matched the machine name or a save state check failed.
+    bool run();
+
+private:
+    // Frames run after saving in the save state check.
+    static constexpr int kCheckFrames = 60;
+
+    template <typename Config>
+    bool runMachine();
+
+    template <typename Config>
+    bool checkSaveState(BasicMachine<Config>& machine);
+
+    void runCgaKernels() const;
+
+    int frames_{600};
+    std::string machine_{"all"};
+    std::vector<uint8_t> disk_image_;
+    RepFastPathMode rep_fast_path_mode_{RepFastPathMode::On};
+    LoopSkipMode loop_skip_mode_{LoopSkipMode::On};
+    bool check_save_state_{false};
+    bool cga_kernels_{false};
+};
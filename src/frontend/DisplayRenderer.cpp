@@ -1,5 +1,6 @@
 #include "DisplayRenderer.h"
 #include <array>
+#include <cstring>
 
 // "IBM 5153" CGA palette (16 colors) in 8-bit per channel RGB
 // See https://int10h.org/blog/2022/06/ibm-5153-color-true-cga-palette/
@@ -25,6 +26,8 @@ static constexpr std::array<std::array<uint8_t, 3>, 16> CGA_PALETTE = {
 DisplayRenderer::DisplayRenderer() {
     pixelBuffer_.resize(WIDTH * HEIGHT * BYTES_PER_PIXEL);
     compositeLine_.resize(WIDTH);
+    indexLine_.resize(WIDTH);
+    lastFront_.resize(WIDTH * HEIGHT);
 }
 
 void DisplayRenderer::render(CGA* cga) {
@@ -33,37 +36,88 @@ void DisplayRenderer::render(CGA* cga) {
     }
     uint8_t* front = cga->getFrontBuffer();
     const size_t front_size = cga->getFrontBufferSize();
-    if (!front || front_size < static_cast<size_t>(WIDTH) * static_cast<size_t>(HEIGHT)) {
+    const bool packed = cga->frameFormat() == CgaFrameFormat::Packed4;
+    const size_t count = static_cast<size_t>(WIDTH) * static_cast<size_t>(HEIGHT);
+    if (!front || front_size < (packed ? count / 2 : count)) {
         return;
     }
 
-    // The CGA front buffer is WIDTH*HEIGHT bytes where each byte is 0..15
-    const size_t count = static_cast<size_t>(WIDTH) * static_cast<size_t>(HEIGHT);
+    // The CGA front buffer is WIDTH*HEIGHT palette indices 0..15, one per byte, or two per byte with the left pixel
+    // in the low nibble when packed. Packed lines are unpacked one at a time.
+    auto line = [&](const int y) -> uint8_t* {
+        if (!packed) {
+            return front + (y * WIDTH);
+        }
+        const uint8_t* src = front + (y * WIDTH / 2);
+        for (int x = 0; x < WIDTH / 2; ++x) {
+            indexLine_[x * 2] = src[x] & 0x0F;
+            indexLine_[x * 2 + 1] = src[x] >> 4;
+        }
+        return indexLine_.data();
+    };
     uint8_t* dst = pixelBuffer_.data();
 
+    const uint8_t mode = cga->getModeByte();
+    const uint8_t border = cga->getOverscanColor();
+    const bool full = cga != lastCga_ || cga->frameFormat() != lastFormat_ || composite_enabled_ != lastComposite_ ||
+        (composite_enabled_ && (mode != lastMode_ || border != lastBorder_));
+    // Rows to convert, noted in changedRows_ as they are taken.
+    const size_t line_bytes = packed ? WIDTH / 2 : WIDTH;
+    changedRows_.clear();
+    refreshedLines_ = 0;
+    auto take = [&](const int y) {
+        const uint8_t* src = front + y * line_bytes;
+        uint8_t* last = lastFront_.data() + y * line_bytes;
+        if (!full && std::memcmp(src, last, line_bytes) == 0) {
+            return false;
+        }
+        std::memcpy(last, src, line_bytes);
+        if (!changedRows_.empty() && changedRows_.back().second == y) {
+            changedRows_.back().second = y + 1;
+        }
+        else {
+            changedRows_.emplace_back(y, y + 1);
+        }
+        refreshedLines_++;
+        return true;
+    };
+    lastCga_ = cga;
+    lastFormat_ = cga->frameFormat();
+    lastComposite_ = composite_enabled_;
+    lastMode_ = mode;
+    lastBorder_ = border;
+
     if (!composite_enabled_) {
-        for (size_t i = 0; i < count; ++i) {
-            const uint8_t idx = front[i] & 0x0F;
-            const auto& c = CGA_PALETTE[idx];
+        for (int y = 0; y < HEIGHT; ++y) {
+            if (!take(y)) {
+                continue;
+            }
+            const uint8_t* src_line = line(y);
+            uint8_t* lineDst = dst + (y * WIDTH * 4);
+            for (int x = 0; x < WIDTH; ++x) {
+                const uint8_t idx = src_line[x] & 0x0F;
+                const auto& c = CGA_PALETTE[idx];
 
-            // Unpack 0xRRGGBB into RGBA bytes (A=0xFF)
-            dst[i * 4 + 0] = c[0]; // R
-            dst[i * 4 + 1] = c[1]; // G
-            dst[i * 4 + 2] = c[2]; // B
-            dst[i * 4 + 3] = 0xFF; // A
+                // Unpack 0xRRGGBB into RGBA bytes (A=0xFF)
+                lineDst[x * 4 + 0] = c[0]; // R
+                lineDst[x * 4 + 1] = c[1]; // G
+                lineDst[x * 4 + 2] = c[2]; // B
+                lineDst[x * 4 + 3] = 0xFF; // A
+            }
         }
     }
     else {
         // ReSharper disable once CppDFAUnreachableCode
 
         // Update composite color tables based on current mode byte once per frame
-        const uint8_t mode = cga->getModeByte();
-        const uint8_t border = cga->getOverscanColor();
         compositeRenderer_.update_cga16_color(mode);
         const uint32_t blocks = WIDTH / 4; // composite routine expects blocks of 4 pixels
 
         for (int y = 0; y < HEIGHT; ++y) {
-            uint8_t* src_line = front + (y * WIDTH);
+            if (!take(y)) {
+                continue;
+            }
+            uint8_t* src_line = line(y);
             uint32_t* out_line_temp = compositeLine_.data();
             compositeRenderer_.Composite_Process(mode, border, blocks, src_line, out_line_temp);
 
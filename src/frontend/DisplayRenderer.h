@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 #include "../core/Cga.h"
 #include "Composite.h"
@@ -15,9 +16,17 @@ public:
     DisplayRenderer();
 
     // Render the CGA front buffer into our internal RGBA framebuffer.
-    // This will read WIDTH*HEIGHT bytes from cga->getFrontBuffer(), each 0-15 palette index.
+    // This will read WIDTH*HEIGHT 0-15 palette indices from cga->getFrontBuffer(), one per byte, or two per byte when
+    // the CGA's frame format is CgaFrameFormat::Packed4.
+    // Only the scanlines that differ from the last render are converted, unless something every line depends on (the
+    // CGA, its frame format, composite output or, for composite, the mode and border) has changed. The comparison is
+    // made here, once per rendered frame, so the emulation doesn't pay for it when nothing is displayed.
     void render(CGA* cga);
 
+    // The rows the last render() converted, as [first, last) ranges in ascending order, and how many there were.
+    const std::vector<std::pair<int, int>>& changedRows() const { return changedRows_; }
+    int refreshedLines() const { return refreshedLines_; }
+
     void setComposite(bool v) { composite_enabled_ = v; }
 
     // Accessors for the framebuffer data
@@ -31,4 +40,15 @@ private:
     bool composite_enabled_ = false; // keep existing API flag
     CompositeRenderer compositeRenderer_{};
     std::vector<uint32_t> compositeLine_; // temp line buffer WIDTH entries
+    std::vector<uint8_t> indexLine_; // a packed front buffer line unpacked, WIDTH entries
+
+    // What the framebuffer was last rendered from
+    const CGA* lastCga_ = nullptr;
+    std::vector<uint8_t> lastFront_; // the front buffer as last rendered, WIDTH*HEIGHT bytes at most
+    CgaFrameFormat lastFormat_ = CgaFrameFormat::Indexed8;
+    bool lastComposite_ = false;
+    uint8_t lastMode_ = 0;
+    uint8_t lastBorder_ = 0;
+    std::vector<std::pair<int, int>> changedRows_;
+    int refreshedLines_ = 0;
 };
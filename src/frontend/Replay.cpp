@@ -0,0 +1,41 @@
+#include "Replay.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+
+#include "Machine.h"
+
+bool Replay::run(const InputJournal& journal) const {
+    // Large, and the bus must not move once built.
+    const auto machine = std::make_unique<Machine>();
+    machine->getBus()->setSpeakerCallback([](uint64_t, bool, bool) {
+    });
+    machine->getCpu()->setRepFastPathMode(rep_fast_path_mode_);
+    machine->getCpu()->setLoopSkipMode(loop_skip_mode_);
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!machine->startReplay(journal)) {
+        std::cerr << "Replay: the journal's start state is not a valid save state for this machine\n";
+        return false;
+    }
+    int frames = 0;
+    while (machine->isReplaying()) {
+        machine->run_for(kTicksPerFrame);
+        ++frames;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double emulated = static_cast<double>(frames) / 60.0;
+    std::cout << std::format("Replayed {} inputs over {} frames in {:.3f}s ({:.1f}x real time)\n",
+                             journal.events().size(), frames, elapsed.count(), emulated / elapsed.count());
+    if (!machine->replayMatched()) {
+        std::cout << std::format("Replay diverged: it didn't end in the recorded state (hash {:016X})\n",
+                                 journal.endHash());
+        return false;
+    }
+    std::cout << std::format("Replay matches the recording: ended at cycle {} in state {:016X}\n",
+                             journal.endCycle(), journal.endHash());
+    return true;
+}
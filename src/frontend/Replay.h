@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Cpu.h"
+#include "InputJournal.h"
+
+// Replays an input journal (see InputJournal.h) headless, as fast as the machine runs, and reports whether the replay
+// ended in the state the recording did.
+class Replay
+{
+public:
+    // Crystal ticks in one 60 Hz frame.
+    static constexpr uint64_t kTicksPerFrame = 238636;
+
+    void setRepFastPathMode(const RepFastPathMode mode) { rep_fast_path_mode_ = mode; }
+    void setLoopSkipMode(const LoopSkipMode mode) { loop_skip_mode_ = mode; }
+
+    // Return false if the journal's start state doesn't load or the replay diverged from the recording.
+    bool run(const InputJournal& journal) const;
+
+private:
+    RepFastPathMode rep_fast_path_mode_{RepFastPathMode::On};
+    LoopSkipMode loop_skip_mode_{LoopSkipMode::On};
+};
@@ -0,0 +1,421 @@
+#include "StateTests.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Machine.h"
+
+namespace {
+
+// A component with a section of fixed-size values and a section of variable-sized blocks. The layout it reads back
+// can be changed to check how the reader handles save states that don't match.
+struct Sample
+{
+    enum class Layout { Saved, Reversed, ShortSection, ExtraSection, SmallerRam };
+
+    uint32_t word{0};
+    uint16_t table[3]{};
+    bool flag{false};
+    uint8_t ram[64]{};
+    std::vector<uint8_t> image;
+    std::deque<uint8_t> queue;
+    Layout layout{Layout::Saved};
+
+    template <typename Archive>
+    void serialize(Archive& ar) {
+        const auto values = [&] {
+            ar(word);
+            ar(table);
+            if (layout != Layout::ShortSection) {
+                ar(flag);
+            }
+            ar.bytes(ram, layout == Layout::SmallerRam ? sizeof(ram) / 2 : sizeof(ram));
+        };
+        const auto blocks = [&] {
+            ar.vector(image);
+            ar.deque(queue);
+        };
+        if (layout == Layout::Reversed) {
+            ar.section("TWO ", blocks);
+            ar.section("ONE ", values);
+        }
+        else {
+            ar.section("ONE ", values);
+            ar.section("TWO ", blocks);
+        }
+        if (layout == Layout::ExtraSection) {
+            ar.section("SIX ", [&] { ar(word); });
+        }
+    }
+
+    [[nodiscard]] bool sameState(const Sample& other) const {
+        return word == other.word && std::equal(std::begin(table), std::end(table), std::begin(other.table)) &&
+            flag == other.flag && std::equal(std::begin(ram), std::end(ram), std::begin(other.ram)) &&
+            image == other.image && queue == other.queue;
+    }
+};
+
+// xorshift32, so that the tests see the same data every run.
+uint32_t nextRandom(uint32_t& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+Sample makeSample() {
+    uint32_t seed = 12345;
+    Sample s;
+    s.word = nextRandom(seed);
+    for (uint16_t& t : s.table) {
+        t = static_cast<uint16_t>(nextRandom(seed));
+    }
+    s.flag = true;
+    for (uint8_t& b : s.ram) {
+        b = static_cast<uint8_t>(nextRandom(seed));
+    }
+    s.image.resize(1000);
+    for (uint8_t& b : s.image) {
+        b = static_cast<uint8_t>(nextRandom(seed));
+    }
+    for (int i = 0; i < 6; ++i) {
+        s.queue.push_back(static_cast<uint8_t>(nextRandom(seed)));
+    }
+    return s;
+}
+
+// Read data into a sample of this layout. Returns whether the reader accepted it.
+bool readSample(const std::vector<uint8_t>& data, const Sample::Layout layout, Sample& out) {
+    out = Sample{};
+    out.layout = layout;
+    StateReader reader(data);
+    if (reader.ok()) {
+        out.serialize(reader);
+    }
+    return reader.ok();
+}
+
+// States for the snapshot tests: a few bytes of one page change from one state to the next, and once in a while the
+// size changes, as it does when a disk is inserted.
+std::vector<std::vector<uint8_t>> makeStates(const size_t count) {
+    constexpr size_t kSize = 10 * SnapshotRing::kPageSize + 100;
+    uint32_t seed = 777;
+    std::vector<std::vector<uint8_t>> states;
+    std::vector<uint8_t> state(kSize);
+    for (uint8_t& b : state) {
+        b = static_cast<uint8_t>(nextRandom(seed));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 16 == 15) {
+            state.resize(state.size() == kSize ? kSize + SnapshotRing::kPageSize : kSize, 0x5A);
+        }
+        const size_t page = nextRandom(seed) % (state.size() / SnapshotRing::kPageSize);
+        const uint32_t changes = nextRandom(seed) % 8;
+        for (uint32_t c = 0; c < changes; ++c) {
+            const size_t offset = page * SnapshotRing::kPageSize + nextRandom(seed) % SnapshotRing::kPageSize;
+            state[offset] ^= static_cast<uint8_t>(nextRandom(seed) | 1);
+        }
+        states.push_back(state);
+    }
+    return states;
+}
+
+// Whether every snapshot in the ring restores to the state recorded for its cycle (state index * 100).
+bool restoresAll(const SnapshotRing& ring, const std::vector<std::vector<uint8_t>>& states) {
+    std::vector<uint8_t> restored;
+    for (size_t i = 0; i < ring.size(); ++i) {
+        ring.restore(i, restored);
+        if (restored != states[ring.cycle(i) / 100]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<Machine> makeMachine() {
+    // Large, and the bus must not move once built.
+    auto machine = std::make_unique<Machine>();
+    machine->getBus()->setSpeakerCallback([](uint64_t, bool, bool) {
+    });
+    return machine;
+}
+
+void runFrames(Machine& machine, const int frames) {
+    for (int frame = 0; frame < frames; ++frame) {
+        machine.run_for(StateTests::kTicksPerFrame);
+    }
+}
+
+}
+
+bool StateTests::run() {
+    passed_ = failed_ = 0;
+    check(testArchive(), "save state round trip");
+    check(testArchiveErrors(), "save state errors");
+    check(testMachineState(), "machine save state round trip");
+    check(testSnapshotRing(), "snapshot ring round trip");
+    check(testSnapshotRingLimits(), "snapshot ring limits");
+    check(testMachineHistory(), "machine history");
+    check(testInputJournal(), "input journal round trip");
+    check(testMachineReplay(), "machine record and replay");
+    std::cout << std::format("{} passed, {} failed\n", passed_, failed_);
+    return failed_ == 0;
+}
+
+bool StateTests::check(const bool passed, const char* name) {
+    std::cout << std::format("{:<32} {}\n", name, passed ? "ok" : "FAILED");
+    ++(passed ? passed_ : failed_);
+    return passed;
+}
+
+bool StateTests::testArchive() {
+    Sample original = makeSample();
+    std::vector<uint8_t> saved;
+    StateWriter writer(saved);
+    original.serialize(writer);
+
+    // Read back, with the sections in the order saved and the other way round.
+    Sample loaded;
+    if (!readSample(saved, Sample::Layout::Saved, loaded) || !loaded.sameState(original)) {
+        return false;
+    }
+    if (!readSample(saved, Sample::Layout::Reversed, loaded) || !loaded.sameState(original)) {
+        return false;
+    }
+
+    // Saving what was loaded gives the same bytes.
+    std::vector<uint8_t> resaved;
+    StateWriter rewriter(resaved);
+    loaded.layout = Sample::Layout::Saved;
+    loaded.serialize(rewriter);
+    return resaved == saved;
+}
+
+bool StateTests::testArchiveErrors() {
+    const Sample original = makeSample();
+    std::vector<uint8_t> saved;
+    StateWriter writer(saved);
+    Sample copy = original;
+    copy.serialize(writer);
+
+    Sample loaded;
+    auto bad_magic = saved;
+    bad_magic[0] ^= 0xFF;
+    auto other_version = saved;
+    const uint32_t version = kSaveStateVersion + 1;
+    std::memcpy(&other_version[sizeof(kSaveStateMagic)], &version, sizeof(version));
+    const std::vector<uint8_t> truncated(saved.begin(), saved.end() - 1);
+    const std::vector<uint8_t> header_only(saved.begin(), saved.begin() + sizeof(kSaveStateMagic));
+
+    return !readSample(bad_magic, Sample::Layout::Saved, loaded) &&
+        !readSample(other_version, Sample::Layout::Saved, loaded) &&
+        !readSample(truncated, Sample::Layout::Saved, loaded) &&
+        !readSample(header_only, Sample::Layout::Saved, loaded) &&
+        // A section that isn't consumed exactly, a section that isn't there and a block of the wrong size.
+        !readSample(saved, Sample::Layout::ShortSection, loaded) &&
+        !readSample(saved, Sample::Layout::ExtraSection, loaded) &&
+        !readSample(saved, Sample::Layout::SmallerRam, loaded) &&
+        readSample(saved, Sample::Layout::Saved, loaded) && loaded.sameState(original);
+}
+
+bool StateTests::testMachineState() {
+    const auto machine = makeMachine();
+    runFrames(*machine, kWarmupFrames);
+    std::vector<uint8_t> saved;
+    machine->saveState(saved);
+    runFrames(*machine, kCheckFrames);
+    std::vector<uint8_t> expected;
+    machine->saveState(expected);
+
+    // A fresh machine resumes from the save and runs on exactly as the original did.
+    const auto restored = makeMachine();
+    if (!restored->loadState(saved)) {
+        return false;
+    }
+    std::vector<uint8_t> actual;
+    restored->saveState(actual);
+    if (actual != saved) {
+        return false;
+    }
+    runFrames(*restored, kCheckFrames);
+    restored->saveState(actual);
+    if (actual != expected || restored->cycleCount() != machine->cycleCount()) {
+        return false;
+    }
+
+    // A damaged save is refused and leaves the machine reset.
+    saved.resize(saved.size() / 2);
+    return !restored->loadState(saved) && restored->cycleCount() == 0;
+}
+
+bool StateTests::testSnapshotRing() {
+    const auto states = makeStates(48);
+    SnapshotRing ring;
+    for (size_t i = 0; i < states.size(); ++i) {
+        ring.record(i * 100, states[i]);
+    }
+    if (ring.size() != states.size() || !restoresAll(ring, states)) {
+        return false;
+    }
+    // Far smaller than the states themselves, since each snapshot only keeps the pages that changed.
+    if (ring.bytes() >= states.size() * states[0].size() / 4) {
+        return false;
+    }
+
+    // Going back drops the newer snapshots; the rest still restore.
+    ring.discardAfter(20);
+    if (ring.size() != 21 || ring.cycle(20) != 2000 || !restoresAll(ring, states)) {
+        return false;
+    }
+
+    // Recording at an earlier cycle replaces the future after it.
+    auto replaced = states;
+    replaced[11] = states[40];
+    ring.record(1100, replaced[11]);
+    if (ring.size() != 12 || ring.countAtOrBefore(1099) != 11 || !restoresAll(ring, replaced)) {
+        return false;
+    }
+    ring.record(0, states[0]);
+    return ring.size() == 1 && restoresAll(ring, states);
+}
+
+bool StateTests::testSnapshotRingLimits() {
+    const auto states = makeStates(40);
+    SnapshotRing ring;
+    ring.setLimits(8, SnapshotRing::kDefaultByteBudget);
+    for (size_t i = 0; i < states.size(); ++i) {
+        ring.record(i * 100, states[i]);
+    }
+    if (ring.size() != 8 || ring.cycle(0) != 3200 || !restoresAll(ring, states)) {
+        return false;
+    }
+
+    // A budget of about three states keeps the newest snapshots that fit.
+    const size_t budget = 3 * states.back().size();
+    ring.setLimits(SnapshotRing::kDefaultCapacity, budget);
+    ring.clear();
+    for (size_t i = 0; i < states.size(); ++i) {
+        ring.record(i * 100, states[i]);
+        if (ring.bytes() > budget && ring.size() > 1) {
+            return false;
+        }
+    }
+    return ring.cycle(ring.size() - 1) == (states.size() - 1) * 100 && restoresAll(ring, states);
+}
+
+bool StateTests::testMachineHistory() {
+    constexpr int kSteps = 20;
+    const auto machine = makeMachine();
+    runFrames(*machine, kWarmupFrames);
+    machine->setHistoryInterval(Machine::kFrameCycles);
+    runFrames(*machine, kCheckFrames);
+
+    // Step forward, then back again, and arrive at each state exactly. Start at an instruction boundary, since going
+    // back stops at one.
+    machine->stepInstruction();
+    std::vector<std::vector<uint8_t>> states(kSteps + 1);
+    machine->saveState(states[0]);
+    for (int i = 1; i <= kSteps; ++i) {
+        machine->stepInstruction();
+        machine->saveState(states[i]);
+    }
+    std::vector<uint8_t> state;
+    for (int i = kSteps; i-- > 0;) {
+        if (!machine->stepBackInstruction()) {
+            return false;
+        }
+        machine->saveState(state);
+        if (state != states[i]) {
+            return false;
+        }
+    }
+
+    const uint64_t now = machine->cycleCount();
+    return machine->stepBackCycle() && machine->cycleCount() == now - 1;
+}
+
+bool StateTests::testInputJournal() {
+    const std::vector<uint8_t> start_state = {1, 2, 3, 4, 5};
+    const std::vector<uint8_t> disk_a(4096, 0xF6);
+    const std::vector<uint8_t> disk_b(2048, 0xE5);
+    InputJournal journal;
+    journal.begin(start_state);
+    journal.addScanCode(100, 0x1E);
+    journal.addInsertDisk(200, 0, disk_a, true);
+    journal.addInsertDisk(300, 1, disk_b, false);
+    journal.addInsertDisk(400, 0, disk_a, false);
+    journal.addEjectDisk(500, 1);
+    journal.addReset(600);
+    journal.addScanCode(50, 0x9E);
+    journal.addScanCode(70, 0x1C);
+    journal.end(90, 0x0123456789ABCDEFull);
+
+    std::vector<uint8_t> saved;
+    journal.write(saved);
+    InputJournal loaded;
+    if (!loaded.read(saved)) {
+        return false;
+    }
+    std::vector<uint8_t> resaved;
+    loaded.write(resaved);
+    const auto& events = loaded.events();
+    // The same image inserted twice is stored once.
+    if (resaved != saved || loaded.startState() != start_state || loaded.endCycle() != 90 ||
+        loaded.endHash() != 0x0123456789ABCDEFull || events.size() != 8 || events[3].disk != 0 ||
+        events[2].disk != 1 || loaded.disk(1) != disk_b || !events[1].write_protected) {
+        return false;
+    }
+
+    // Going back only drops inputs since the last reset.
+    loaded.discardAfter(60);
+    if (loaded.events().size() != 7 || loaded.events().back().cycle != 50) {
+        return false;
+    }
+
+    // Damaged journals are refused and leave the journal empty.
+    const std::vector<uint8_t> truncated(saved.begin(), saved.end() - 1);
+    auto bad_kind = saved;
+    bad_kind[saved.size() - 7] = 0xFF; // Kind of the last event
+    InputJournal out_of_order;
+    out_of_order.begin(start_state);
+    out_of_order.addScanCode(100, 0x1E);
+    out_of_order.addScanCode(50, 0x9E);
+    std::vector<uint8_t> unordered;
+    out_of_order.write(unordered);
+    return !loaded.read(truncated) && loaded.events().empty() && loaded.startState().empty() &&
+        !loaded.read(bad_kind) && !loaded.read(unordered);
+}
+
+bool StateTests::testMachineReplay() {
+    constexpr uint8_t kKeys[] = {0x1E, 0x9E, 0x1C, 0x9C};
+    const auto machine = makeMachine();
+    runFrames(*machine, kWarmupFrames);
+    InputJournal journal;
+    machine->startRecording(journal);
+    for (const uint8_t key : kKeys) {
+        runFrames(*machine, kCheckFrames / 4);
+        machine->sendScanCode(key);
+    }
+    runFrames(*machine, kCheckFrames / 4);
+    machine->stopRecording();
+
+    // Replay the journal, as written to a file and read back, on a fresh machine.
+    std::vector<uint8_t> saved;
+    journal.write(saved);
+    InputJournal loaded;
+    const auto replayed = makeMachine();
+    if (!loaded.read(saved) || loaded.events().size() != std::size(kKeys) || !replayed->startReplay(loaded)) {
+        return false;
+    }
+    while (replayed->isReplaying()) {
+        replayed->run_for(kTicksPerFrame);
+    }
+    // The replay checks the state it ends in against the one recorded.
+    return replayed->replayMatched();
+}
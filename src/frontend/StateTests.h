@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+// Round-trip tests for the save state format (see SaveState.h), the snapshot history (SnapshotRing.h) and input
+// journals (InputJournal.h). Each test writes something, reads it back and checks that nothing was lost or changed,
+// and that damaged data is rejected. The machine tests run a real machine headless, so they take a few seconds.
+class StateTests
+{
+public:
+    // Crystal ticks in one 60 Hz frame.
+    static constexpr uint64_t kTicksPerFrame = 238636;
+
+    // Run every test, reporting each one. Return false if any failed.
+    bool run();
+
+private:
+    // Frames run before the machine tests start saving, so that the BIOS is well into POST.
+    static constexpr int kWarmupFrames = 120;
+    // Frames run from each save state and compared.
+    static constexpr int kCheckFrames = 60;
+
+    bool check(bool passed, const char* name);
+
+    bool testArchive();
+    bool testArchiveErrors();
+    bool testMachineState();
+    bool testSnapshotRing();
+    bool testSnapshotRingLimits();
+    bool testMachineHistory();
+    bool testInputJournal();
+    bool testMachineReplay();
+
+    int passed_{0};
+    int failed_{0};
+};
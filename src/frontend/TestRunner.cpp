@@ -109,8 +109,11 @@ bool TestRunner::runTestFile(const std::filesystem::path& filepath, size_t max_t
 
     auto ctx = TestContext{
         .cpu = Cpu<StubBus>(),
+        .reference = Cpu<StubBus>(),
         .max_tests = max_tests
     };
+    ctx.cpu.setMicrocodeEngine(engine_);
+    ctx.reference.setMicrocodeEngine(MicrocodeEngine::Interpreter);
 
     bool file_ok = true;
     // Run up to max_tests for this file (if max_tests == 0, run all)
@@ -129,24 +132,12 @@ bool TestRunner::runTestFile(const std::filesystem::path& filepath, size_t max_t
     return file_ok;
 }
 
-bool TestRunner::runTest(TestContext& ctx, const Moo::Reader::Test& test, const std::filesystem::path& filepath) {
-    //std::cout << std::format("Running test [{}/{}]: {:<50}", test.index, ctx.max_tests, test.name) << "\n";
-
-    auto& cpu = ctx.cpu;
+// Load a test's initial state into the CPU and run its instruction. Returns the cycles taken.
+static int executeTest(Cpu<StubBus>& cpu, const Moo::Reader::Test& test) {
     // Reset CPU
     cpu.reset();
     cpu.getBus()->reset();
 
-    ++total_tests_run_;
-    bool test_failed = false;
-    bool reg_failed_in_test = false;
-    bool mem_failed_in_test = false;
-    bool flag_failed_in_test = false;
-
-    const std::string fname = filepath.filename().string();
-    auto& fsum = file_summaries_[fname];
-    ++fsum.total;
-
     // Set up initial CPU state
     for (const auto r : Moo::REG16Range()) {
         cpu.setRegister(MooRegToRegister(r), test.GetInitialRegister(r));
@@ -162,9 +153,69 @@ bool TestRunner::runTest(TestContext& ctx, const Moo::Reader::Test& test, const
     cpu.setTestNumber(test.index);
 
     // Run the instruction (ignore cycle count)
-    auto cycles_taken = cpu.stepToNextInstruction();
+    const auto cycles_taken = cpu.stepToNextInstruction();
     // Cycle one more time to let any terminating write complete
     cpu.run_for(1);
+    return cycles_taken;
+}
+
+// Compare the CPU under test against the reference CPU after both ran the same test.
+// Returns a description of the first difference, or an empty string if they agree.
+static std::string crossCheck(Cpu<StubBus>& cpu, Cpu<StubBus>& reference, const Moo::Reader::Test& test) {
+    for (size_t i = 0; i < 32; ++i) {
+        const uint16_t expected = reference.getRegisters()[i];
+        const uint16_t actual = cpu.getRegisters()[i];
+        if (actual != expected) {
+            return std::format("Cross-check: register {} is {:04X}, interpreter has {:04X}",
+                               GetRegisterString(static_cast<Register>(i)), static_cast<unsigned>(actual),
+                               static_cast<unsigned>(expected));
+        }
+    }
+
+    for (const auto* ram : {&test.init_state.ram, &test.final_state.ram}) {
+        for (const auto& m : *ram) {
+            const auto address = m.address & 0xFFFFF;
+            const auto expected = reference.getBus()->ram()[address];
+            const auto actual = cpu.getBus()->ram()[address];
+            if (actual != expected) {
+                return std::format("Cross-check: memory[{:#05X}] is {:02X}, interpreter has {:02X}",
+                                   static_cast<unsigned>(address), static_cast<unsigned>(actual),
+                                   static_cast<unsigned>(expected));
+            }
+        }
+    }
+
+    const auto& log = cpu.getCycleLogBuffer();
+    const auto& reference_log = reference.getCycleLogBuffer();
+    for (size_t i = 0; i < std::min(log.size(), reference_log.size()); ++i) {
+        if (log[i] != reference_log[i]) {
+            return std::format("Cross-check: cycle log differs at line {}: interpreter has '{}'", i,
+                               reference_log[i]);
+        }
+    }
+    if (log.size() != reference_log.size()) {
+        return std::format("Cross-check: cycle log has {} lines, interpreter has {}", log.size(),
+                           reference_log.size());
+    }
+    return {};
+}
+
+bool TestRunner::runTest(TestContext& ctx, const Moo::Reader::Test& test, const std::filesystem::path& filepath) {
+    //std::cout << std::format("Running test [{}/{}]: {:<50}", test.index, ctx.max_tests, test.name) << "\n";
+
+    auto& cpu = ctx.cpu;
+
+    ++total_tests_run_;
+    bool test_failed = false;
+    bool reg_failed_in_test = false;
+    bool mem_failed_in_test = false;
+    bool flag_failed_in_test = false;
+
+    const std::string fname = filepath.filename().string();
+    auto& fsum = file_summaries_[fname];
+    ++fsum.total;
+
+    auto cycles_taken = executeTest(cpu, test);
 
     //std::cout << std::format("Completed in {} cycles.\n", cycles);
 
@@ -245,6 +296,26 @@ bool TestRunner::runTest(TestContext& ctx, const Moo::Reader::Test& test, const
         }
     }
 
+    if (cross_check_) {
+        executeTest(ctx.reference, test);
+        auto message = crossCheck(cpu, ctx.reference, test);
+        if (!message.empty()) {
+            TestRunner::FailureDetail fd{};
+            fd.file = fname;
+            fd.test_name = test.name;
+            fd.test_index = test.index;
+            fd.cycles_taken = cycles_taken;
+            fd.message = std::move(message);
+            for (const auto rr : Moo::REG16Range()) {
+                fd.regs.push_back(cpu.getRegister(MooRegToRegister(rr)));
+            }
+            fd.cycle_logs = cpu.getCycleLogBuffer();
+            failure_details_.push_back(std::move(fd));
+            test_failed = true;
+            ++total_cross_check_failed_;
+        }
+    }
+
     if (test_failed) {
         ++total_failed_;
         ++fsum.failed;
@@ -330,6 +401,9 @@ void TestRunner::printSummary() const {
     std::cout << std::format(
         "\n====== Test Summary ======\nFiles: {}\nTests run: {}\nPassed: {}\nFailed: {}\nFlag failures: {}\n",
         files_.size(), total_tests_run_, total_passed_, total_failed_, total_flag_failed_);
+    if (cross_check_) {
+        std::cout << std::format("Cross-check failures: {}\n", total_cross_check_failed_);
+    }
     if (!failure_details_.empty()) {
         std::cout << "\nFailures:\n";
 
@@ -56,6 +56,11 @@ public:
     }
 
     bool runAllTests(size_t max_tests = 0);
+    // Microcode engine used for every test CPU.
+    void setMicrocodeEngine(const MicrocodeEngine engine) { engine_ = engine; }
+    // Also run every test on a reference CPU using the interpreter and fail the test if the selected engine's
+    // registers, memory or cycle log differ from it at all.
+    void setCrossCheck(const bool state) { cross_check_ = state; }
     // Access collected files
     const std::vector<std::filesystem::path>& files() const { return files_; }
 
@@ -63,12 +68,16 @@ private:
     struct TestContext
     {
         Cpu<StubBus> cpu;
+        Cpu<StubBus> reference; // Interpreter, for cross-check mode
         size_t max_tests;
     };
 
     bool runTestFile(const std::filesystem::path& filepath, size_t max_tests = 0);
     bool runTest(TestContext& ctx, const Moo::Reader::Test& test, const std::filesystem::path& filepath);
 
+    MicrocodeEngine engine_ = MicrocodeEngine::Interpreter;
+    bool cross_check_ = false;
+
     // Summary reporting
     size_t total_files_run_ = 0;
     size_t total_tests_run_ = 0;
@@ -76,6 +85,7 @@ private:
     size_t total_passed_ = 0;
     size_t total_failed_ = 0;
     size_t total_flag_failed_ = 0;
+    size_t total_cross_check_failed_ = 0;
 
     struct FailureDetail
     {
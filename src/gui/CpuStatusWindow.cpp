@@ -63,9 +63,49 @@ void CpuStatusWindow::show(bool* open) {
             const auto machine_state = _machine->getState();
             ImGui::Text("State: %s", _machine->getStateString().c_str());
 
+            // Reverse execution restores a snapshot from the machine's history and runs forward to the target, so it
+            // is only offered while stopped.
+            static const char* back_status = nullptr;
+            ImGui::BeginDisabled(_machine->isRunning() || _machine->history().empty());
+            if (ImGui::Button("Step back cycle")) {
+                back_status = _machine->stepBackCycle() ? nullptr : "Not in history";
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Step back instruction")) {
+                back_status = _machine->stepBackInstruction() ? nullptr : "Not in history";
+            }
+            ImGui::SameLine();
+            ImGui::BeginDisabled(!_machine->hasBreakpoint());
+            if (ImGui::Button("Run back to breakpoint")) {
+                back_status = _machine->runBackToBreakpoint() ? nullptr : "Breakpoint not hit within history";
+            }
+            ImGui::EndDisabled();
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            bool history = _machine->historyInterval() != 0;
+            if (ImGui::Checkbox("History", &history)) {
+                _machine->setHistoryInterval(history ? Machine::kFrameCycles : 0);
+                back_status = nullptr;
+            }
+            ImGui::SameLine();
+            ImGui::Text("%zu snapshots, %.1f MiB", _machine->history().size(),
+                        static_cast<double>(_machine->history().bytes()) / (1024.0 * 1024.0));
+            if (back_status != nullptr) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1, 0.6f, 0, 1), "%s", back_status);
+            }
+
 
             ImGui::Separator();
             ImGui::Text("Cycles: %llu", static_cast<unsigned long long>(cycles_now));
+            ImGui::SameLine();
+            ImGui::Text("Policy: %s", _machine->usingDebugPolicy() ? "Debug" : "Fast");
+            ImGui::SameLine();
+            // Force the instrumented cycle loop even when no breakpoint or cycle log needs it.
+            bool debug_policy = _machine->isDebugPolicy();
+            if (ImGui::Checkbox("Force debug", &debug_policy)) {
+                _machine->setDebugPolicy(debug_policy);
+            }
 
             // Show last step feedback until we run the next step.
             if ((machine_state == MachineState::Stopped) && last_step_time != 0.0) {
@@ -0,0 +1,50 @@
+#include "EventLogWindow.h"
+#include <imgui/imgui.h>
+#include "../core/Machine.h"
+
+void EventLogWindow::append(std::string line) {
+    if (_lines.size() == kMaxLines) {
+        _lines.pop_front();
+    }
+    _lines.push_back(std::move(line));
+}
+
+void EventLogWindow::show(bool* open) {
+    ImGui::Begin("Event Log", open);
+
+    // ReSharper disable once CppDFAConstantConditions
+    if (_machine) {
+        auto* log = _machine->getBus()->eventLog();
+        const char* levels[] = {"Trace", "Debug", "Info", "Warning", "Error", "Off"};
+        int level = static_cast<int>(log->level());
+        ImGui::SetNextItemWidth(120.0f);
+        if (ImGui::Combo("Level", &level, levels, IM_ARRAYSIZE(levels))) {
+            log->setLevel(static_cast<LogLevel>(level));
+        }
+        ImGui::SameLine();
+        ImGui::Text("Dropped: %llu", static_cast<unsigned long long>(log->dropped()));
+        ImGui::SameLine();
+    }
+    if (ImGui::Button("Clear")) {
+        _lines.clear();
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Follow", &_scrollToBottom);
+
+    ImGui::Separator();
+    ImGui::BeginChild("##event_log_lines", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(_lines.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            ImGui::TextUnformatted(_lines[i].c_str());
+        }
+    }
+    clipper.End();
+    if (_scrollToBottom) {
+        ImGui::SetScrollHereY(1.0f);
+    }
+    ImGui::EndChild();
+
+    ImGui::End();
+}
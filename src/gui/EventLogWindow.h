@@ -0,0 +1,32 @@
+#pragma once
+
+#include <deque>
+#include <string>
+
+#include "DebuggerWindow.h"
+
+class Machine;
+
+// The most recent device event log messages. The application drains the machine's event log once per frame and
+// passes each formatted message to append().
+class EventLogWindow : public DebuggerWindow
+{
+public:
+    static constexpr size_t kMaxLines = 2000;
+
+    explicit EventLogWindow(Machine* m) :
+        _machine(m) {
+    }
+
+    ~EventLogWindow() override = default;
+
+    void append(std::string line);
+
+    void show(bool* open) override;
+    [[nodiscard]] const char* name() const override { return "Event Log"; }
+
+private:
+    Machine* _machine{nullptr};
+    std::deque<std::string> _lines;
+    bool _scrollToBottom{true};
+};
@@ -0,0 +1,66 @@
+#include "IoPortWindow.h"
+#include <imgui/imgui.h>
+#include "../core/Machine.h"
+
+void IoPortWindow::show(bool* open) {
+    // ReSharper disable once CppDFAConstantConditions
+    if (!_machine) {
+        ImGui::Begin("I/O Ports", open);
+        ImGui::Text("No Machine instance");
+        ImGui::End();
+        return;
+    }
+
+    // ReSharper disable once CppDFAUnreachableCode
+    auto* bus = _machine->getBus();
+    if (!bus) {
+        ImGui::Begin("I/O Ports", open);
+        ImGui::Text("No Bus available");
+        ImGui::End();
+        return;
+    }
+
+    auto* io = bus->io();
+    ImGui::Begin("I/O Ports", open);
+
+    bool counting = io->isCounting();
+    if (ImGui::Checkbox("Count accesses", &counting)) {
+        io->setCounting(counting);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        io->resetCounts();
+    }
+
+    // Only ports that have been accessed are listed.
+    if (ImGui::BeginTable("io_ports", 3,
+        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Port");
+        ImGui::TableSetupColumn("Reads");
+        ImGui::TableSetupColumn("Writes");
+        ImGui::TableHeadersRow();
+        for (uint16_t port = 0; port < IoMap::kPortCount; ++port) {
+            const uint64_t reads = io->readCount(port);
+            const uint64_t writes = io->writeCount(port);
+            if (reads == 0 && writes == 0) {
+                continue;
+            }
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            if (io->isMapped(port)) {
+                ImGui::Text("%03X", port);
+            }
+            else {
+                ImGui::TextDisabled("%03X", port);
+            }
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%llu", static_cast<unsigned long long>(reads));
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%llu", static_cast<unsigned long long>(writes));
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
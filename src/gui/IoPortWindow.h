@@ -0,0 +1,22 @@
+#pragma once
+
+#include "DebuggerWindow.h"
+
+class Machine;
+
+// Per-port I/O access counts, collected by the bus while counting is enabled.
+class IoPortWindow : public DebuggerWindow
+{
+public:
+    explicit IoPortWindow(Machine* m) :
+        _machine(m) {
+    }
+
+    ~IoPortWindow() override = default;
+
+    void show(bool* open) override;
+    [[nodiscard]] const char* name() const override { return "I/O Ports"; }
+
+private:
+    Machine* _machine{nullptr};
+};
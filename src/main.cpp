@@ -34,12 +34,17 @@
 #include "gui/VideoCardStatusWindow.h"
 #include "gui/PicStatusWindow.h"
 #include "gui/DmacStatusWindow.h"
+#include "gui/IoPortWindow.h"
+#include "gui/EventLogWindow.h"
 #include "gui/DisplayDebugWindow.h"
 #include "gui/CpuStatusWindow.h"
 
 #include "core/Machine.h"
 
 #include "frontend/DisplayRenderer.h"
+#include "frontend/Benchmark.h"
+#include "frontend/Replay.h"
+#include "frontend/StateTests.h"
 #include "frontend/TestRunner.h"
 #include "frontend/keyboard.h"
 #include "gui/InstructionHistoryWindow.h"
@@ -51,6 +56,11 @@ static void FileDialogCallback(void* userdata, const char* const* filelist, int
 constexpr uint32_t windowStartWidth = 1280;
 constexpr uint32_t windowStartHeight = 1024;
 
+// Machine > Save state and Load state use this file in the working directory.
+constexpr const char* kStateFile = "machine.state";
+// Machine > Record input writes this file in the working directory, and Replay input reads it.
+constexpr const char* kJournalFile = "input.journal";
+
 bool init_audio(SDL_AudioDeviceID* outAudioDevice, MIX_Mixer** outMixer, SDL_AudioStream** outStream);
 
 struct Config
@@ -60,6 +70,30 @@ struct Config
     // Expect two-digit hex strings like "00".."FF"
     std::string opcode_start{"00"};
     std::string opcode_end{"FF"};
+    // Microcode engine for run-tests: "interpreter" or "specialized"
+    std::string engine{"interpreter"};
+    // Check the selected engine against the interpreter on every test
+    bool cross_check{false};
+    // REP MOVS/STOS/LODS batching: "off", "on" or "verify"
+    std::string rep_fast_path{"on"};
+    // Busy-wait loop skipping: "off", "on" or "verify"
+    std::string loop_skip{"on"};
+    // Device event log level: "trace", "debug", "info", "warning", "error" or "off"
+    std::string log_level{"info"};
+    // Write device event log messages to this file instead of the console
+    std::string log_file;
+    // Frames of emulated time for each bench run
+    int bench_frames{600};
+    // Machine configuration to benchmark, or "all"
+    std::string bench_machine{"all"};
+    // Floppy image to boot during bench runs
+    std::string bench_disk;
+    // Check that each bench run resumes exactly from a save state
+    bool bench_check_save_state{false};
+    // Measure the CGA span kernels instead of the machines
+    bool bench_cga_kernels{false};
+    // Input journal to replay headless
+    std::string replay_journal;
 };
 
 // Main application context. Holds SDL objects, Machine instance, and UI state.
@@ -75,6 +109,8 @@ struct AppContext
     SDL_AppResult app_quit = SDL_APP_CONTINUE;
     Machine* machine = nullptr;
     DebuggerManager dbg_manager;
+    EventLogWindow* event_log_window{nullptr}; // Owned by dbg_manager
+    std::ofstream log_file;
     bool running{true};
 
     // Blip buffer for audio
@@ -112,6 +148,8 @@ struct AppContext
     bool show_video_card_viewer{false};
     bool show_pic_viewer{false};
     bool show_dma_viewer{false};
+    bool show_io_ports{false};
+    bool show_event_log{false};
     bool show_display_debug{false};
     bool cpu_running{true};
     bool show_disassembly{false};
@@ -133,10 +171,28 @@ struct AppContext
     std::string pending_disk_path;
     bool pending_disk_load_flag{false};
 
+    // Input journal being recorded or replayed
+    InputJournal journal;
+
     void resetMachine() {
         last_cycle_count = 0;
+        machine->stopReplay();
         machine->resetMachine();
     }
+
+    void stopRecording() {
+        machine->stopRecording();
+        std::vector<uint8_t> data;
+        journal.write(data);
+        std::ofstream out(kJournalFile, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            SDL_Log("Record input: Failed to write %s", kJournalFile);
+        }
+        else {
+            SDL_Log("Record input: Wrote %zu inputs to %s", journal.events().size(), kJournalFile);
+        }
+    }
 };
 
 // SDL failure callback - logs the error and returns failure code.
@@ -163,6 +219,49 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
             ->capture_default_str();
     run_test->add_option("--opcode-end", cfg.opcode_end, "Ending opcode prefix as two-digit hex (00..FF)")->
               capture_default_str();
+    run_test->add_option("--engine", cfg.engine, "Microcode engine to test (interpreter, specialized)")
+            ->check(CLI::IsMember({"interpreter", "specialized"}))
+            ->capture_default_str();
+    run_test->add_flag("--cross-check", cfg.cross_check,
+                       "Also run each test with the interpreter and fail on any difference from --engine");
+
+    // Create a subcommand 'state-tests' that round-trips save states, the snapshot history and input journals
+    auto* state_tests = cli_app.add_subcommand("state-tests",
+                                               "Test save states, snapshot history and input journals round trip");
+
+    // Create a subcommand 'bench' that runs machine configurations headless and reports their speed
+    auto* bench = cli_app.add_subcommand("bench", "Measure startup time and speed of each machine configuration");
+    bench->add_option("--frames", cfg.bench_frames, "Frames of emulated time to run per configuration")
+         ->check(CLI::PositiveNumber)
+         ->capture_default_str();
+    bench->add_option("--machine", cfg.bench_machine, "Machine configuration to run, or 'all'")->capture_default_str();
+    bench->add_option("--disk", cfg.bench_disk, "Floppy image to boot from");
+    bench->add_flag("--check-save-state", cfg.bench_check_save_state,
+                    "After each run, check that a restored save state runs on exactly as the original did");
+    bench->add_flag("--cga-kernels", cfg.bench_cga_kernels,
+                    "Measure the CGA rasterizer's span kernels in pixels/ns instead of running machines");
+
+    // Create a subcommand 'replay' that replays an input journal headless and checks it ends as the recording did
+    auto* replay = cli_app.add_subcommand("replay", "Replay a recorded input journal headless, as fast as possible");
+    replay->add_option("journal", cfg.replay_journal, "Input journal to replay")->required();
+
+    cli_app.add_option("--rep-fast-path", cfg.rep_fast_path,
+                       "Batch steady REP MOVS/STOS/LODS iterations (off, on, or verify: step them and report any "
+                       "batch that would differ)")
+            ->check(CLI::IsMember({"off", "on", "verify"}))
+            ->capture_default_str();
+
+    cli_app.add_option("--loop-skip", cfg.loop_skip,
+                       "Skip whole periods of busy-wait loops (off, on, or verify: step them and report any skip "
+                       "that would differ)")
+            ->check(CLI::IsMember({"off", "on", "verify"}))
+            ->capture_default_str();
+
+    cli_app.add_option("--log-level", cfg.log_level, "Lowest level of device events to log")
+            ->check(CLI::IsMember({"trace", "debug", "info", "warning", "error", "off"}))
+            ->capture_default_str();
+
+    cli_app.add_option("--log-file", cfg.log_file, "Write device events to this file instead of the console");
 
     // Parse the arguments (this is an expansion of the CLI11_PARSE macro)
     try {
@@ -204,7 +303,16 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
             return SDL_APP_FAILURE;
         }
 
+        if (cfg.cross_check && cfg.engine == "interpreter") {
+            std::cerr << "Error: --cross-check needs --engine specialized\n";
+            return SDL_APP_FAILURE;
+        }
+
         auto test_runner = new TestRunner();
+        if (cfg.engine == "specialized") {
+            test_runner->setMicrocodeEngine(MicrocodeEngine::Specialized);
+        }
+        test_runner->setCrossCheck(cfg.cross_check);
         if (!cfg.test_path.empty()) {
             const std::filesystem::path p(cfg.test_path);
             if (std::filesystem::is_directory(p)) {
@@ -248,6 +356,72 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
         return SDL_APP_SUCCESS;
     }
 
+    // If the state-tests subcommand was invoked, run them and exit
+    if (*state_tests) {
+        StateTests tests;
+        return tests.run() ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+    }
+
+    // If the bench subcommand was invoked, run the benchmark and exit
+    if (*bench) {
+        Benchmark benchmark;
+        benchmark.setFrames(cfg.bench_frames);
+        benchmark.setMachine(cfg.bench_machine);
+        benchmark.setCheckSaveState(cfg.bench_check_save_state);
+        benchmark.setCgaKernels(cfg.bench_cga_kernels);
+        if (!cfg.bench_disk.empty()) {
+            std::ifstream in(cfg.bench_disk, std::ios::binary);
+            if (!in) {
+                std::cerr << "Error: failed to open floppy image " << cfg.bench_disk << "\n";
+                return SDL_APP_FAILURE;
+            }
+            benchmark.setDiskImage(std::vector<uint8_t>((std::istreambuf_iterator<char>(in)),
+                                                        std::istreambuf_iterator<char>()));
+        }
+        if (cfg.rep_fast_path == "off") {
+            benchmark.setRepFastPathMode(RepFastPathMode::Off);
+        }
+        else if (cfg.rep_fast_path == "verify") {
+            benchmark.setRepFastPathMode(RepFastPathMode::Verify);
+        }
+        if (cfg.loop_skip == "off") {
+            benchmark.setLoopSkipMode(LoopSkipMode::Off);
+        }
+        else if (cfg.loop_skip == "verify") {
+            benchmark.setLoopSkipMode(LoopSkipMode::Verify);
+        }
+        return benchmark.run() ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+    }
+
+    // If the replay subcommand was invoked, replay the journal and exit
+    if (*replay) {
+        std::ifstream in(cfg.replay_journal, std::ios::binary);
+        if (!in) {
+            std::cerr << "Error: failed to open input journal " << cfg.replay_journal << "\n";
+            return SDL_APP_FAILURE;
+        }
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        InputJournal journal;
+        if (!journal.read(data)) {
+            std::cerr << "Error: " << cfg.replay_journal << " is not a valid input journal\n";
+            return SDL_APP_FAILURE;
+        }
+        Replay runner;
+        if (cfg.rep_fast_path == "off") {
+            runner.setRepFastPathMode(RepFastPathMode::Off);
+        }
+        else if (cfg.rep_fast_path == "verify") {
+            runner.setRepFastPathMode(RepFastPathMode::Verify);
+        }
+        if (cfg.loop_skip == "off") {
+            runner.setLoopSkipMode(LoopSkipMode::Off);
+        }
+        else if (cfg.loop_skip == "verify") {
+            runner.setLoopSkipMode(LoopSkipMode::Verify);
+        }
+        return runner.run(journal) ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+    }
+
 
     // Initialize SDL with the services we need specified in flags. We want to use Video and Audio.
     if (not SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
@@ -334,6 +508,31 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
 
     // Create a Machine - this represents our emulator core.
     auto machine = new Machine();
+    if (cfg.rep_fast_path == "off") {
+        machine->getCpu()->setRepFastPathMode(RepFastPathMode::Off);
+    }
+    else if (cfg.rep_fast_path == "verify") {
+        machine->getCpu()->setRepFastPathMode(RepFastPathMode::Verify);
+    }
+    if (cfg.loop_skip == "off") {
+        machine->getCpu()->setLoopSkipMode(LoopSkipMode::Off);
+    }
+    else if (cfg.loop_skip == "verify") {
+        machine->getCpu()->setLoopSkipMode(LoopSkipMode::Verify);
+    }
+    constexpr std::pair<std::string_view, LogLevel> kLogLevels[] = {
+        {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+        {"warning", LogLevel::Warning}, {"error", LogLevel::Error}, {"off", LogLevel::Off}
+    };
+    for (const auto& [name, level] : kLogLevels) {
+        if (cfg.log_level == name) {
+            machine->getBus()->eventLog()->setLevel(level);
+        }
+    }
+    // The display renderer reads packed frames, which take half the memory traffic to draw and present.
+    if (auto* cga = machine->getBus()->cga()) {
+        cga->setFrameFormat(CgaFrameFormat::Packed4);
+    }
 
     // Set up our emulator application context.
     auto* ctx = new AppContext();
@@ -343,6 +542,12 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
     ctx->mixer = mixer;
     ctx->pc_speaker_stream = stream;
     ctx->machine = machine;
+    if (!cfg.log_file.empty()) {
+        ctx->log_file.open(cfg.log_file);
+        if (!ctx->log_file) {
+            SDL_Log("Failed to open log file %s, logging to the console", cfg.log_file.c_str());
+        }
+    }
     ctx->last_counter = SDL_GetPerformanceCounter();
 
     // Initialize Blip_Buffer
@@ -419,10 +624,17 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
     ctx->dbg_manager.addWindow("PIC Status", std::make_unique<PicStatusWindow>(machine), &ctx->show_pic_viewer);
     ctx->dbg_manager.addWindow("DMA Status", std::make_unique<DmacStatusWindow>(machine),
                                &ctx->show_dma_viewer);
+    ctx->dbg_manager.addWindow("I/O Ports", std::make_unique<IoPortWindow>(machine), &ctx->show_io_ports);
+    auto event_log_window = std::make_unique<EventLogWindow>(machine);
+    ctx->event_log_window = event_log_window.get();
+    ctx->dbg_manager.addWindow("Event Log", std::move(event_log_window), &ctx->show_event_log);
     // Display debug window uses the app's displayTexture pointer
     ctx->dbg_manager.addWindow("Display Debug", std::make_unique<DisplayDebugWindow>(&ctx->display_texture),
                                &ctx->show_display_debug);
 
+    // Keep a snapshot per frame so the debugger can step backwards.
+    ctx->machine->setHistoryInterval(Machine::kFrameCycles);
+
     // Initialize cycle count baseline for MHz measurement
     ctx->last_cycle_count = ctx->machine->cycleCount();
 
@@ -479,7 +691,8 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
 
         case SDL_EVENT_KEY_DOWN:
             // Only send key events to the machine if ImGui is not capturing keyboard input.
-            if (!io.WantCaptureKeyboard) {
+            // A replay supplies its own input.
+            if (!io.WantCaptureKeyboard && !app->machine->isReplaying()) {
                 sc = translate_SDL_key(event->key.key, true);
                 app->machine->sendScanCode(sc);
             }
@@ -487,7 +700,7 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
 
         case SDL_EVENT_KEY_UP:
             // Only send key events to the machine if ImGui is not capturing keyboard input.
-            if (!io.WantCaptureKeyboard) {
+            if (!io.WantCaptureKeyboard && !app->machine->isReplaying()) {
                 sc = translate_SDL_key(event->key.key, false);
                 app->machine->sendScanCode(sc);
             }
@@ -618,6 +831,34 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
         }
     }
 
+    // A replay runs unthrottled: after the real-time slices, run whole frames until this display frame's time is up.
+    // Their audio is dropped.
+    if (app->machine->isReplaying() && app->machine->isRunning()) {
+        const Uint64 deadline = now + SDL_GetPerformanceFrequency() / 60;
+        while (app->machine->isReplaying() && app->machine->isRunning() && SDL_GetPerformanceCounter() < deadline) {
+            app->machine->run_for(static_cast<uint64_t>(app->ticks_per_frame));
+            app->blip_buf.end_frame(static_cast<blip_time_t>(app->machine->getElapsedPitTicks(true)));
+            app->blip_buf.clear();
+        }
+        if (!app->machine->isReplaying()) {
+            SDL_Log("Replay input: Finished, %s", app->machine->replayMatched()
+                                                  ? "in the recorded state"
+                                                  : "but diverged from the recording");
+        }
+    }
+
+
+    // Format the device events logged while running.
+    app->machine->getBus()->eventLog()->drain([app](const LogRecord& record) {
+        std::string line = EventLog::format(record);
+        if (app->log_file.is_open()) {
+            app->log_file << line << '\n';
+        }
+        else {
+            std::cout << line << '\n';
+        }
+        app->event_log_window->append(std::move(line));
+    });
 
     // If nothing to run, we still yield to UI and rendering below
     if (!app->running) {
@@ -651,6 +892,71 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
             if (ImGui::MenuItem("Reboot")) {
                 app->resetMachine();
             }
+            ImGui::Separator();
+            if (ImGui::MenuItem("Save state")) {
+                std::vector<uint8_t> state;
+                app->machine->saveState(state);
+                std::ofstream out(kStateFile, std::ios::binary);
+                out.write(reinterpret_cast<const char*>(state.data()), static_cast<std::streamsize>(state.size()));
+                if (!out) {
+                    SDL_Log("Save state: Failed to write %s", kStateFile);
+                }
+                else {
+                    SDL_Log("Save state: Wrote %zu bytes to %s", state.size(), kStateFile);
+                }
+            }
+            if (ImGui::MenuItem("Load state")) {
+                if (app->machine->isRecording()) {
+                    app->stopRecording();
+                }
+                std::ifstream in(kStateFile, std::ios::binary);
+                if (!in) {
+                    SDL_Log("Load state: Failed to open %s", kStateFile);
+                }
+                else {
+                    const std::vector<uint8_t> state((std::istreambuf_iterator<char>(in)),
+                                                     std::istreambuf_iterator<char>());
+                    if (!app->machine->loadState(state)) {
+                        SDL_Log("Load state: %s is not a valid save state for this machine; the machine was reset",
+                                kStateFile);
+                    }
+                    app->last_cycle_count = app->machine->cycleCount();
+                }
+            }
+            ImGui::Separator();
+            if (app->machine->isRecording()) {
+                if (ImGui::MenuItem("Stop recording input")) {
+                    app->stopRecording();
+                }
+            }
+            else {
+                if (ImGui::MenuItem("Record input")) {
+                    app->machine->startRecording(app->journal);
+                    SDL_Log("Record input: Recording from cycle %llu",
+                            static_cast<unsigned long long>(app->machine->cycleCount()));
+                }
+                if (ImGui::MenuItem("Reboot and record input")) {
+                    app->resetMachine();
+                    app->machine->startRecording(app->journal);
+                    SDL_Log("Record input: Recording from a cold boot");
+                }
+            }
+            if (ImGui::MenuItem("Replay input", nullptr, false, !app->machine->isRecording())) {
+                std::ifstream in(kJournalFile, std::ios::binary);
+                const std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
+                                                std::istreambuf_iterator<char>());
+                if (!in.is_open() || !app->journal.read(data)) {
+                    SDL_Log("Replay input: %s is missing or not a valid input journal", kJournalFile);
+                }
+                else if (!app->machine->startReplay(app->journal)) {
+                    SDL_Log("Replay input: The journal's start state doesn't fit this machine; the machine was reset");
+                }
+                else {
+                    app->machine->run();
+                    SDL_Log("Replay input: Replaying %zu inputs", app->journal.events().size());
+                }
+                app->last_cycle_count = app->machine->cycleCount();
+            }
             ImGui::EndMenu();
         }
 
@@ -721,6 +1027,10 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
             ImGui::EndMenu();
         }
 
+        // Scanlines the display path converted and uploaded for the last frame shown.
+        ImGui::Separator();
+        ImGui::Text("Lines refreshed: %d/%d", app->display_renderer.refreshedLines(), DisplayRenderer::HEIGHT);
+
         ImGui::EndMainMenuBar();
     }
 
@@ -786,21 +1096,23 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
                 void* tex_pixels = nullptr;
                 int tex_pitch = 0;
                 const int full_w = DisplayRenderer::WIDTH;
-                const int full_h = DisplayRenderer::HEIGHT;
                 const int row_bytes = full_w * DisplayRenderer::BYTES_PER_PIXEL;
-                if (SDL_LockTexture(app->display_texture, nullptr, &tex_pixels, &tex_pitch) && tex_pixels) {
-                    const uint8_t* src = app->display_renderer.pixels();
-                    for (int y = 0; y < full_h; ++y) {
-                        auto* dstRow = static_cast<uint8_t*>(tex_pixels) + static_cast<size_t>(y) * tex_pitch;
-                        const uint8_t* srcRow = src + static_cast<size_t>(y) * row_bytes;
-                        memcpy(dstRow, srcRow, row_bytes);
+                // Upload only the rows the renderer changed; the texture keeps the rest from earlier frames.
+                for (const auto& [first, last] : app->display_renderer.changedRows()) {
+                    const SDL_Rect rows{0, first, full_w, last - first};
+                    const uint8_t* src = app->display_renderer.pixels() + static_cast<size_t>(first) * row_bytes;
+                    if (SDL_LockTexture(app->display_texture, &rows, &tex_pixels, &tex_pitch) && tex_pixels) {
+                        for (int y = 0; y < rows.h; ++y) {
+                            auto* dstRow = static_cast<uint8_t*>(tex_pixels) + static_cast<size_t>(y) * tex_pitch;
+                            const uint8_t* srcRow = src + static_cast<size_t>(y) * row_bytes;
+                            memcpy(dstRow, srcRow, row_bytes);
+                        }
+                        SDL_UnlockTexture(app->display_texture);
                     }
-                    SDL_UnlockTexture(app->display_texture);
-                }
-                else {
-                    const int pitch = full_w * DisplayRenderer::BYTES_PER_PIXEL;
-                    if (!SDL_UpdateTexture(app->display_texture, nullptr, app->display_renderer.pixels(), pitch)) {
-                        SDL_Log("SDL_UpdateTexture failed: %s", SDL_GetError());
+                    else {
+                        if (!SDL_UpdateTexture(app->display_texture, &rows, src, row_bytes)) {
+                            SDL_Log("SDL_UpdateTexture failed: %s", SDL_GetError());
+                        }
                     }
                 }
                 SDL_Rect dst;
@@ -830,7 +1142,10 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
             app->pending_disk_load_flag = false;
 
             // Load the selected disk image into the emulator
-            if (auto* bus = app->machine->getBus()) {
+            if (app->machine->isReplaying()) {
+                SDL_Log("Ignoring floppy image '%s': a replay supplies its own disks", app->pending_disk_path.c_str());
+            }
+            else {
                 try {
                     std::ifstream in(app->pending_disk_path, std::ios::binary);
                     if (!in) {
@@ -839,7 +1154,7 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
                     else {
                         std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
                                                   std::istreambuf_iterator<char>());
-                        bus->fdc()->loadDisk(0, data, true);
+                        app->machine->insertDisk(0, data, true);
                         SDL_Log("Loaded floppy image '%s' into FDC drive 0 (%zu bytes)",
                                 app->pending_disk_path.c_str(),
                                 data.size());
@@ -0,0 +1,438 @@
+// Generates MicrocodeTablesData.h, the decoded microcode ROM, decoder PLA, translation PLA and group decode PLA tables
+// of the 8088 and the 8086, from the ASCII ROM dumps in the microcode directory.
+//
+// Usage: MicrocodeTableGen <microcode directory> <output header>
+//
+// The CMake target microcode_tables builds and runs this over the source tree. Run it again whenever the ROM dumps or
+// the decoding below change.
+
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "MicrocodeTables.h"
+
+namespace {
+
+// The ROM dump files, read on first use. Line endings are normalized to LF, which the decoder below expects.
+class RomFiles
+{
+public:
+    explicit RomFiles(std::string directory) :
+        directory_(std::move(directory)) {
+    }
+
+    // The dump called name. "l" and "r" are the two halves of the 8088 microcode ROM and "la" and "ra" those of the
+    // 8086; each is stored as four files, which are joined.
+    std::string_view file(const std::string_view name) {
+        const std::string key(name);
+        auto it = files_.find(key);
+        if (it == files_.end()) {
+            std::string contents;
+            if (name == "l" || name == "r" || name == "la" || name == "ra") {
+                for (int part = 0; part < 4; ++part) {
+                    contents += read(std::format("{}{}{}.txt", name.substr(0, 1), part, name.substr(1)));
+                }
+            }
+            else {
+                contents = read(key);
+            }
+            it = files_.emplace(key, std::move(contents)).first;
+        }
+        return it->second;
+    }
+
+private:
+    [[nodiscard]] std::string read(const std::string& name) const {
+        std::ifstream in(directory_ + "/" + name, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("File not found: " + name);
+        }
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        std::string contents = buffer.str();
+        std::erase(contents, '\r');
+        return contents;
+    }
+
+    std::string directory_;
+    std::map<std::string, std::string> files_;
+};
+
+// Character at position i of a ROM dump, or 0 past the end.
+char romChar(const std::string_view s, const size_t i) {
+    return i < s.size() ? s[i] : '\0';
+}
+
+MicrocodeTables decodeTables(RomFiles& rom, const bool use8086) {
+    constexpr size_t LINE_ENDING_SIZE = 1;
+    MicrocodeTables t{};
+
+    // Load the 512 21-bit microcode instruction words from the main microcode ROM.
+    uint32_t instructions[512]{};
+    const std::string_view romHalves[2] = {
+        rom.file(use8086 ? "ra" : "r"),
+        rom.file(use8086 ? "la" : "l")
+    };
+
+    // Iterate through 84 rows of microcode data.
+    for (int y = 0; y < 84; ++y) {
+        // Iterate through left and right columns.
+        for (int half = 0; half < 2; ++half) {
+            const std::string_view s = romHalves[half];
+            // Iterate through the width of the ROM block (64).
+            for (int x = 0; x < 64; ++x) {
+                uint32_t b = s[y * (64 + LINE_ENDING_SIZE) + (63 - x)] == '0' ? 1 : 0;
+                instructions[x * 8 + half * 4 + y % 4] |= (b << (20 - (y >> 2)));
+            }
+        }
+    }
+
+    for (int i = 0; i < 512; ++i) {
+        const uint32_t w = instructions[i];
+
+        // The microcode word is somewhat scrambled compared to the word layout diagram you may have seen in online
+        // documentation. We unscramble it here and store the decoded fields in the microcode array.
+
+        // See https://www.righto.com/2022/11/how-8086-processors-microcode-engine.html for an in-depth description
+        // of the microcode format.
+
+        // Decode Type. There are 6 different types of micro-instruction, implying a different word format.
+        // All word formats share a source field, destination field, and 'update flags' flag, so we can decode the
+        // common fields here.
+
+        // The type field is either 2 or 3 bits. If 3 bits, the high bit is set.
+        uint32_t typ = (w >> 7) & 7;
+        if ((typ & 4) == 0) {
+            // High bit is not set, so this is a 2-bit type field. Shift right to discard the low bit.
+            typ >>= 1;
+        }
+
+        // Decode Source field
+        const uint32_t s = ((w >> 13) & 1) + ((w >> 10) & 6) + ((w >> 11) & 0x18);
+
+        // Decode Destination field
+        const uint32_t d = ((w >> 20) & 1) + ((w >> 18) & 2) + ((w >> 16) & 4) + ((w >> 14) & 8) + ((w >> 12) & 0x10);
+
+        // Decode 'update flags' flag
+        const uint32_t f = (w >> 10) & 1;
+
+        t.microcode[i * 4] = static_cast<uint8_t>(d);
+        t.microcode[i * 4 + 1] = static_cast<uint8_t>(s);
+        t.microcode[i * 4 + 2] = static_cast<uint8_t>((f << 3) + typ); // Pack F and type together
+        t.microcode[i * 4 + 3] = static_cast<uint8_t>(w & 0xff); // Low 8 bits are operands - they require further unpacking.
+    }
+
+    // Read in the stage1 decoder PLA ROM logic.
+    // The 8088 utilizes a "match decoder" which takes an 11-bit input and activates one column of the microcode
+    // ROM. This decoder is implemented as a programmable logic array (PLA) with 128 columns. The match logic
+    // allows a match on 0, 1, or "don't care" for each of the 11 input bits.
+    uint32_t stage1[128]{};
+    constexpr std::string_view stage1Files[9][2] = {
+        {"0t.txt", "0b.txt"}, {"1t.txt", "1b.txt"}, {"2t.txt", "2b.txt"},
+        {"3t.txt", "3b.txt"}, {"4t.txt", "4b.txt"}, {"5t.txt", "5b.txt"},
+        {"6t.txt", "6b.txt"}, {"7t.txt", "7b.txt"}, {"8t.txt", "8b.txt"},
+    };
+    // This array provides the X bit position offset for each group.
+    constexpr int xx[9] = {0, 8, 24, 40, 56, 72, 88, 104, 120};
+
+    for (int g = 0; g < 9; ++g) {
+        // Width of each ROM file is 16, except for groups 0 and 8 which are 8.
+        const int n = (g == 0 || g == 8) ? 8 : 16;
+        const int xp = xx[g];
+
+        // Iterate through top and bottom halves of each ROM file.
+        for (int h = 0; h < 2; ++h) {
+            const std::string_view s = rom.file(stage1Files[g][h]);
+
+            // Iterate through the height of each ROM file (11 rows).
+            for (int y = 0; y < 11; ++y) {
+                for (int x = 0; x < n; ++x) {
+                    if (s[y * (n + LINE_ENDING_SIZE) + x] == '0') {
+                        // Stage1 is written in reverse-order.
+                        stage1[127 - (x + xp)] |= 1u << (y * 2 + (h ^ (y <= 2 ? 1 : 0)));
+                    }
+                }
+            }
+        }
+    }
+
+    // Expand the PLA data into a full 11-bit (2048-entry) lookup table. Rather than simulating all 2048 inputs against
+    // every column, reduce each column to a (care mask, value) pair and enumerate only the inputs it matches. Columns
+    // are visited in descending order so that the lowest matching column wins, as it does in hardware scan order.
+    constexpr int ba[11] = {7, 2, 1, 0, 5, 6, 8, 9, 10, 3, 4};
+    for (int j = 127; j >= 0; --j) {
+        const uint32_t s1 = stage1[j];
+        // Skip empty decoder slots as they cannot match anything
+        if (s1 == 0) {
+            continue;
+        }
+        uint32_t care = 0;
+        uint32_t value = 0;
+        bool impossible = false;
+        for (int b = 0; b < 11; ++b) {
+            const uint32_t x = (s1 >> (ba[b] * 2)) & 3;
+            const uint32_t bit = 1u << (10 - b);
+            if (x == 1) {
+                care |= bit;
+                value |= bit;
+            }
+            else if (x == 2) {
+                care |= bit;
+            }
+            else if (x == 3) {
+                impossible = true;
+            }
+        }
+        if (impossible) {
+            continue;
+        }
+        const uint32_t dontCare = ~care & 0x7ff;
+        uint32_t sub = dontCare;
+        while (true) {
+            t.microcodeIndex[value | sub] = static_cast<uint8_t>(j);
+            if (sub == 0) {
+                break;
+            }
+            sub = (sub - 1) & dontCare;
+        }
+    }
+
+    // Decode the translation PLA.
+    // The translation PLA takes 8 bits of input and outputs a full 13-bit microcode address and a 1-bit segment
+    // specifier.
+
+    // The inputs vary depending on the type of lookup.
+    // For looking up an EA calculation microcode address, the inputs are 5 bits from the ModRM byte.
+    const std::string_view translationString =
+        rom.file(use8086 ? "translation_8086.txt" : "translation_8088.txt");
+    size_t tsp = 0;
+    char c = romChar(translationString, 0);
+
+    // Iterate through the first 33 rows of the translation file (empty lines will be skipped)
+    for (int i = 0; i < 33; ++i) {
+        uint32_t mask = 0;
+        uint32_t bits = 0;
+        uint32_t output = 0;
+
+        // Iterate through the 8-character match mask that starts each line, constructing a bit mask
+        // for matching.
+        for (int j = 0; j < 8; ++j) {
+            if (c != '?') {
+                mask |= 128u >> j;
+            }
+            if (c == '1') {
+                bits |= 128u >> j;
+            }
+            c = romChar(translationString, ++tsp);
+        }
+
+        // Iterate through the 14-character addresses corresponding to each match mask
+        for (int j = 0; j < 14; ++j) {
+            while (c != '0' && c != '1') {
+                // Skip any whitespace
+                c = romChar(translationString, ++tsp);
+            }
+            if (c == '1') {
+                // Set the corresponding output bit
+                output |= 8192u >> j;
+            }
+            c = romChar(translationString, ++tsp);
+        }
+        // Consume rest of line
+        while (c != 0x0A && c != '\0') {
+            c = romChar(translationString, ++tsp);
+        }
+        // Consume newlines
+        while (c == 0x0A) {
+            c = romChar(translationString, ++tsp);
+        }
+
+        for (uint32_t j = 0; j < 256; ++j) {
+            if ((j & mask) == bits) {
+                t.translation[j] = static_cast<uint16_t>(output);
+            }
+        }
+    }
+
+    // Decode the group decode PLA.
+    // The group decode PLA takes 9 bits of input (from opcode and prefixes) and outputs 15 control bits.
+
+    // For a detailed examination of the group decode PLA, see
+    // https://www.righto.com/2023/05/8086-processor-group-decode-rom.html
+    int groupInput[38 * 18]{};
+    int groupOutput[38 * 15]{};
+    const std::string_view groupString = rom.file("group.txt");
+
+    // Iterate through each column of the group decode ROM.
+    for (int x = 0; x < 38; ++x) {
+        // Iterate through the first 15 rows of the group decode ROM.
+        for (int y = 0; y < 15; ++y) {
+            groupOutput[y * 38 + x] = groupString[y * (38 + LINE_ENDING_SIZE) + x] == '0' ? 0 : 1;
+        }
+        for (int y = 0; y < 18; ++y) {
+            c = groupString[((y / 2) + 15) * (38 + LINE_ENDING_SIZE) + x];
+            if ((y & 1) == 0) {
+                groupInput[y * 38 + x] = (c == '*' || c == '0') ? 1 : 0;
+            }
+            else {
+                groupInput[y * 38 + x] = (c == '*' || c == '1') ? 1 : 0;
+            }
+        }
+    }
+    constexpr int groupYY[18] = {1, 0, 3, 2, 4, 6, 5, 7, 11, 10, 12, 13, 8, 9, 15, 14, 16, 17};
+    for (int x = 0; x < 34; ++x) {
+        if (x == 11) {
+            // Column 11 doesn't activate any outputs.
+            continue;
+        }
+
+        uint32_t g = 0;
+        for (int j = 0; j < 15; ++j) {
+            g |= static_cast<uint32_t>(groupOutput[j * 38 + x]) << j;
+        }
+
+        // Reduce the column's 9 input pairs to a (care mask, value) pair. A column that requires an input to be
+        // both 0 and 1 can never fire.
+        uint32_t care = 0;
+        uint32_t value = 0;
+        bool impossible = false;
+        for (int j = 0; j < 9; ++j) {
+            const int y0 = groupInput[groupYY[j * 2] * 38 + x];
+            const int y1 = groupInput[groupYY[j * 2 + 1] * 38 + x];
+            if (y0 == 1 && y1 == 1) {
+                impossible = true;
+            }
+            else if (y0 == 1) {
+                care |= 1u << j;
+            }
+            else if (y1 == 1) {
+                care |= 1u << j;
+                value |= 1u << j;
+            }
+        }
+        if (impossible) {
+            continue;
+        }
+
+        if (x == 10) {
+            g |= groupLoadRegisterImmediate;
+        }
+        if (x == 12) {
+            g |= groupWidthInOpcodeBit3;
+        }
+        if (x == 13) {
+            g |= groupCMC;
+        }
+        if (x == 14) {
+            g |= groupHLT;
+        }
+        if (x == 31) {
+            g |= groupREP;
+        }
+        if (x == 32) {
+            g |= groupSegmentOverride;
+        }
+        if (x == 33) {
+            g |= groupLOCK;
+        }
+
+        for (uint32_t i = 0; i < 0x101; ++i) {
+            if ((i & care) == value) {
+                uint32_t gi = g;
+                if (i == 0xFA) {
+                    gi |= groupCLI;
+                }
+                if (i == 0x8E || (i & 0xE7) == 0x07) {
+                    gi |= groupLoadSegmentRegister;
+                }
+                t.groups[i] = gi;
+            }
+        }
+    }
+
+    return t;
+}
+
+// Write values as an initializer list, as many to a line as fit.
+template <typename T>
+void writeArray(std::ostream& out, const char* name, const T* values, const size_t count, const int digits) {
+    const size_t per_line = digits > 2 ? 8 : 16;
+    out << std::format("        // {}\n        {{", name);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % per_line == 0) {
+            out << "\n           ";
+        }
+        out << std::format(" 0x{:0{}X},", static_cast<uint32_t>(values[i]), digits);
+    }
+    out << "\n        },\n";
+}
+
+void writeTables(std::ostream& out, const char* name, const MicrocodeTables& t) {
+    out << std::format("    static constexpr MicrocodeTables {} = {{\n", name);
+    writeArray(out, "microcode", t.microcode, std::size(t.microcode), 2);
+    writeArray(out, "microcodeIndex", t.microcodeIndex, std::size(t.microcodeIndex), 2);
+    writeArray(out, "translation", t.translation, std::size(t.translation), 4);
+    writeArray(out, "groups", t.groups, std::size(t.groups), 7);
+    out << "    };\n";
+}
+
+}
+
+int main(const int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: MicrocodeTableGen <microcode directory> <output header>\n";
+        return 1;
+    }
+    try {
+        RomFiles rom(argv[1]);
+        const MicrocodeTables tables8088 = decodeTables(rom, false);
+        const MicrocodeTables tables8086 = decodeTables(rom, true);
+
+        std::ostringstream out;
+        out << "// Generated by src/tools/MicrocodeTableGen.cpp from the ROM dumps in microcode/. Do not edit; "
+               "rebuild\n// the microcode_tables target instead.\n"
+               "\n"
+               "#ifndef MICROCODE_TABLES_DATA_H\n"
+               "#define MICROCODE_TABLES_DATA_H\n"
+               "\n"
+               "#include \"MicrocodeTables.h\"\n"
+               "\n"
+               "// The decoded tables of each CPU. A class template, so that the tables can be defined in a header "
+               "and still\n// exist once in the program.\n"
+               "template <typename Unused = void>\n"
+               "struct MicrocodeTableData\n"
+               "{\n";
+        writeTables(out, "k8088", tables8088);
+        writeTables(out, "k8086", tables8086);
+        out << "};\n"
+               "\n"
+               "template <typename Unused>\n"
+               "constexpr MicrocodeTables MicrocodeTableData<Unused>::k8088;\n"
+               "template <typename Unused>\n"
+               "constexpr MicrocodeTables MicrocodeTableData<Unused>::k8086;\n"
+               "\n"
+               "#endif // MICROCODE_TABLES_DATA_H\n";
+
+        std::ofstream file(argv[2], std::ios::binary);
+        file << out.str();
+        if (!file) {
+            std::cerr << "Failed to write " << argv[2] << "\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}